@@ -37,12 +37,14 @@ if test "$PHP_CASSANDRA" != "no"; then
     src/Core.c \
     src/Aggregate.c \
     src/BatchStatement.c \
+    src/BoundStatement.c \
     src/Bigint.c \
     src/Blob.c \
     src/Cluster.c \
     src/Cluster/Builder.c \
     src/Collection.c \
     src/Column.c \
+    src/CompletionQueue.c \
     src/Custom.c \
     src/Date.c \
     src/Decimal.c \
@@ -59,6 +61,7 @@ if test "$PHP_CASSANDRA" != "no"; then
     src/Duration.c \
     src/Exception.c \
     src/ExecutionOptions.c \
+    src/Fibers.c \
     src/Float.c \
     src/Function.c \
     src/Future.c \
@@ -67,6 +70,7 @@ if test "$PHP_CASSANDRA" != "no"; then
     src/FutureRows.c \
     src/FutureSession.c \
     src/FutureValue.c \
+    src/Futures.c \
     src/Index.c \
     src/Inet.c \
     src/Keyspace.c \
@@ -146,15 +150,23 @@ if test "$PHP_CASSANDRA" != "no"; then
   ";
 
   CASSANDRA_UTIL="\
+    util/batch.c \
+    util/bind.c \
     util/bytes.c \
+    util/callback.c \
     util/collections.c \
     util/consistency.c \
+    util/cql.c \
+    util/detached.c \
+    util/fiber.c \
     util/future.c \
     util/hash.c \
     util/inet.c \
     util/math.c \
+    util/prepared_cache.c \
     util/ref.c \
     util/result.c \
+    util/throttle.c \
     util/types.c \
     util/uuid_gen.c \
   ";
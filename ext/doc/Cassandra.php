@@ -161,6 +161,29 @@ final class Cassandra {
      */
     const BATCH_COUNTER = 2;
 
+    /**
+     * Requests wait for as long as it takes until fewer requests are in flight.
+     *
+     * @see Cluster\Builder::withMaxInFlightRequests()
+     */
+    const THROTTLE_BLOCK = 0;
+
+    /**
+     * Requests fail right away with a `RuntimeException` when too many
+     * requests are in flight.
+     *
+     * @see Cluster\Builder::withMaxInFlightRequests()
+     */
+    const THROTTLE_FAIL_FAST = 1;
+
+    /**
+     * Requests wait until fewer requests are in flight, or fail with a
+     * `TimeoutException` once the timeout expires.
+     *
+     * @see Cluster\Builder::withMaxInFlightRequests()
+     */
+    const THROTTLE_WAIT = 2;
+
     /**
      * Used to disable logging.
      */
@@ -42,9 +42,24 @@ final class BatchStatement implements Statement {
     /**
      * Creates a new batch statement.
      *
+     * Unlogged batches can be split when they are executed:
+     *  * `group_by_partition` - when `true`, the entries are grouped by the
+     *    partition they write to and each group is sent as its own batch, to
+     *    a replica of that partition.
+     *  * `max_bytes` - the estimated size at which a group is split.
+     *
+     * The parts of a split batch are executed at the same time. Split batches
+     * can be executed with Session::execute(), Session::executeDetached() and
+     * Session::defer(). Session::executeAsync() and
+     * Session::executeConcurrent() reject them, because they return a single
+     * result for each statement.
+     *
+     * @throws Exception\InvalidArgumentException
+     *
      * @param int $type must be one of Cassandra::BATCH_* (default: Cassandra::BATCH_LOGGED).
+     * @param array $options how the batch is split (optional)
      */
-    public function __construct($type) { }
+    public function __construct($type, $options) { }
 
     /**
      * Adds a statement to this batch.
@@ -0,0 +1,45 @@
+<?php
+
+/**
+ * Copyright 2017 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+namespace Cassandra;
+
+/**
+ * A bound statement is a prepared statement together with its arguments.
+ * The arguments are encoded once when they are set and the encoded
+ * statement is reused by every execution, so changing a single argument
+ * between executions only re-encodes that argument.
+ *
+ * @see PreparedStatement::bind()
+ */
+final class BoundStatement implements Statement {
+
+    private function __construct() { }
+
+    /**
+     * Sets the value of a single argument.
+     *
+     * @param string|int $name_or_index name or position of the argument
+     * @param mixed $value value of the argument
+     *
+     * @throws Exception\InvalidArgumentException
+     *
+     * @return \Cassandra\BoundStatement self
+     */
+    public function set($name_or_index, $value) { }
+
+}
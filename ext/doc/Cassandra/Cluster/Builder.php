@@ -54,6 +54,8 @@ final class Builder {
     /**
      * Configures default timeout for future resolution in blocking operations
      * Set to null to disable (default).
+     * Statements executed without a timeout option also use it as the
+     * request timeout of the driver.
      *
      * @param float|null $timeout Timeout value in seconds, can be fractional
      *
@@ -194,6 +196,8 @@ final class Builder {
     /**
      * Enable persistent sessions and clusters.
      *
+     * Persistent sessions also keep their prepared statements between requests.
+     *
      * @param bool $enabled whether to enable persistent sessions and clusters
      *
      * @return \Cassandra\Cluster\Builder self
@@ -262,6 +266,31 @@ final class Builder {
      */
     public function withLatencyAwareRouting($enabled) { }
 
+    /**
+     * Enables latency-aware routing and tunes when it excludes slow hosts.
+     * Hosts whose average latency exceeds the best one by more than the
+     * exclusion threshold are tried last until the retry period has passed.
+     *
+     * Settings that are left out keep the driver's defaults:
+     *  * `exclusion_threshold` - how many times slower than the fastest
+     *    host a host can be before it's excluded (default: 2.0).
+     *  * `scale` - the weight of older latencies in the average, in seconds
+     *    (default: 0.1).
+     *  * `retry_period` - how long a host stays excluded, in seconds
+     *    (default: 10).
+     *  * `update_rate` - how often the fastest latency is recomputed, in
+     *    seconds (default: 0.1).
+     *  * `min_measured` - how many requests a host must have served before
+     *    it can be excluded (default: 50).
+     *
+     * @throws Exception\InvalidArgumentException
+     *
+     * @param array $settings the latency-aware routing settings.
+     *
+     * @return \Cassandra\Cluster\Builder self
+     */
+    public function withLatencyAwareRoutingSettings($settings) { }
+
     /**
      * Disables nagle algorithm for lower latency.
      *
@@ -360,4 +389,56 @@ final class Builder {
      */
     public function withConnectionHeartbeatInterval($interval) { }
 
+    /**
+     * Limits the number of requests that each session has in flight at once.
+     * Requests are counted from the moment they are sent until they complete,
+     * whether their results are waited for or not.
+     *
+     * @see \Cassandra::THROTTLE_BLOCK
+     * @see \Cassandra::THROTTLE_FAIL_FAST
+     * @see \Cassandra::THROTTLE_WAIT
+     *
+     * @param int|null $maxRequests the number of requests, or null for no limit.
+     * @param int $policy what a request does once the limit is reached.
+     * @param float|null $timeout how long to wait for a slot in seconds, required by
+     *                            `\Cassandra::THROTTLE_WAIT`.
+     *
+     * @return \Cassandra\Cluster\Builder self
+     */
+    public function withMaxInFlightRequests($maxRequests, $policy, $timeout) { }
+
+    /**
+     * Enables speculative executions of idempotent requests. A request is
+     * sent to the next host of the query plan each time the delay passes
+     * without a response, up to the given number of extra executions, and
+     * the first response wins.
+     *
+     * Only requests executed with the `is_idempotent` option are executed
+     * speculatively.
+     *
+     * @param float $delay delay in seconds before each speculative execution.
+     * @param int $maxExecutions maximum number of speculative executions (0 to disable).
+     *
+     * @return \Cassandra\Cluster\Builder self
+     */
+    public function withConstantSpeculativeExecutionPolicy($delay, $maxExecutions) { }
+
+    /**
+     * Defines a named set of execution options that requests refer to with
+     * the `execution_profile` option. The options are validated once, here,
+     * and options given along with the profile override its settings.
+     * Consistency, serial consistency, timeout and retry policy are also
+     * registered with the driver as an execution profile.
+     * A profile can't set arguments, paging_state_token or
+     * execution_profile.
+     *
+     * @see Session::execute() for valid execution options
+     *
+     * @param string $name the name of the profile.
+     * @param \Cassandra\ExecutionOptions|array $options the options of the profile.
+     *
+     * @return \Cassandra\Cluster\Builder self
+     */
+    public function withExecutionProfile($name, $options) { }
+
 }
@@ -0,0 +1,70 @@
+<?php
+
+/**
+ * Copyright 2015-2017 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+namespace Cassandra;
+/**
+ * Collects futures and hands them back in the order they resolve. The
+ * stream becomes readable whenever resolved futures are waiting, so it can
+ * be passed to `stream_select()` or an event loop along with other
+ * streams.
+ */
+final class CompletionQueue implements \Countable {
+
+    /**
+     * Creates an empty completion queue.
+     */
+    public function __construct() { }
+
+    /**
+     * Adds a future to the queue. Adding the same future again has no effect.
+     *
+     * @param Future $future An instance of FutureRows, FuturePreparedStatement, FutureSession, FutureClose or FutureValue
+     *
+     * @throws Exception\InvalidArgumentException
+     * @throws Exception\LogicException
+     *
+     * @return void
+     */
+    public function add($future) { }
+
+    /**
+     * Returns a read-only stream that is readable while resolved futures
+     * are waiting to be drained. The stream must not be read from or closed.
+     * It is not available on Windows.
+     *
+     * @throws Exception\RuntimeException
+     *
+     * @return resource A stream for use with `stream_select()`
+     */
+    public function stream() { }
+
+    /**
+     * Removes the futures that have resolved from the queue, without waiting.
+     *
+     * @return array Resolved futures in the order they resolved
+     */
+    public function drain() { }
+
+    /**
+     * The number of futures in the queue that have not been drained yet.
+     *
+     * @return int
+     */
+    public function count() { }
+
+}
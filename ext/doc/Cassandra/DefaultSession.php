@@ -34,13 +34,26 @@ final class DefaultSession implements Session {
      * |--------------------|-----------------|----------------------------------------------------------------------------------------------------------|
      * | arguments          | array           | An array or positional or named arguments                                                                |
      * | consistency        | int             | A consistency constant e.g Dse::CONSISTENCY_ONE, Dse::CONSISTENCY_QUORUM, etc.                           |
-     * | timeout            | int             | A number of rows to include in result for paging                                                         |
+     * | timeout            | int\|float      | A number of seconds after which the driver gives up on the request and the wait for it times out         |
      * | paging_state_token | string          | A string token use to resume from the state of a previous result set                                     |
      * | retry_policy       | RetryPolicy     | A retry policy that is used to handle server-side failures for this request                              |
      * | serial_consistency | int             | Either Dse::CONSISTENCY_SERIAL or Dse::CONSISTENCY_LOCAL_SERIAL                                          |
      * | timestamp          | int\|string     | Either an integer or integer string timestamp that represents the number of microseconds since the epoch |
+     * | is_idempotent      | bool            | Whether the request can be applied more than once, which allows speculative executions                   |
+     * | fetch_scalars      | bool            | Whether bigint, smallint, tinyint, float, timestamp, date, time, uuid and inet columns are PHP scalars     |
+     * | execution_profile  | string          | The name of a profile given to Cluster\Builder::withExecutionProfile(), overridden by the other options  |
      * | execute_as         | string          | User to execute statement as                                                                             |
      *
+     * With fetch_scalars, counter, bigint, smallint and tinyint columns are
+     * integers and float columns are floats. Timestamp columns are integers of
+     * milliseconds since the epoch, date columns are integers of seconds since
+     * the epoch and time columns are integers of nanoseconds since midnight.
+     * Uuid and timeuuid columns are canonical strings and inet columns are
+     * address strings. Counter, bigint, timestamp and time values that don't fit
+     * a PHP integer, as on 32-bit builds, are decimal strings. Varint and the
+     * other columns, as well as the elements of collections, tuples and user
+     * types, stay objects.
+     *
      * @param string|\Cassandra\Statement $statement string or statement to be executed.
      * @param array|\Cassandra\ExecutionOptions|null $options Options to control execution of the query.
      *
@@ -63,9 +76,125 @@ final class DefaultSession implements Session {
      */
     public function executeAsync($statement, $options) { }
 
+    /**
+     * Execute a query without keeping its result. This method returns
+     * once the query has been sent, and nothing is kept for the response
+     * except the error of a failed query. At most 1024 detached queries of
+     * the session are in flight; beyond that this method waits for one of
+     * them to complete, for up to the timeout option.
+     *
+     * @param string|\Cassandra\Statement $statement string or statement to be executed.
+     * @param array|\Cassandra\ExecutionOptions|null $options Options to control execution of the query.
+     *
+     * @throws Exception\TimeoutException
+     *
+     * @return void
+     *
+     * @see Session::execute() for valid execution options
+     * @see Session::detachedErrors()
+     */
+    public function executeDetached($statement, $options) { }
+
+    /**
+     * Takes the errors of detached queries that failed since the last call.
+     * Only the exceptions of the 64 most recent failures are kept.
+     *
+     * @return array The number of failures under "count" and their exceptions under "errors"
+     *
+     * @see Session::executeDetached()
+     */
+    public function detachedErrors() { }
+
+    /**
+     * Buffer a write until the end of the request. Buffered writes are sent
+     * once the response is finished (through `fastcgi_finish_request()`
+     * under PHP-FPM), with up to 64 of them in flight, and failures are
+     * reported as warnings. The statement must not be changed afterwards.
+     *
+     * Prepared writes to the same partition that share their consistency,
+     * timestamp, retry policy, timeout and execution profile are sent as
+     * unlogged batches of up to 4 KB. Writes whose partition isn't known from
+     * the schema metadata, such as simple statements, are sent one by one.
+     *
+     * @param string|\Cassandra\Statement $statement string or statement to be executed.
+     * @param array|\Cassandra\ExecutionOptions|null $options Options to control execution of the query.
+     *
+     * @throws Exception\InvalidArgumentException
+     *
+     * @return void
+     *
+     * @see Session::execute() for valid execution options
+     * @see Session::flushDeferred()
+     */
+    public function defer($statement, $options) { }
+
+    /**
+     * Send the writes buffered by `defer()` on every session now and wait
+     * for them, e.g. between the jobs of a long-running worker.
+     *
+     * @return void
+     */
+    public function flushDeferred() { }
+
+    /**
+     * Execute many queries with a bounded number of them in flight. As soon
+     * as one completes the next one is started, until all of them are done.
+     *
+     * Either every element is a statement, or a statement is given and
+     * every element is an array of arguments for it. The timeout option
+     * bounds the wait for each completion; a request that fails yields its
+     * exception in place of its result.
+     *
+     * @param array|\Traversable $statements Statements, or arrays of arguments for the statement.
+     * @param int $concurrency The maximum number of requests in flight.
+     * @param string|\Cassandra\Statement|null $statement The statement the arguments are for, if any.
+     * @param array|\Cassandra\ExecutionOptions|null $options Options to control execution of the queries.
+     *
+     * @throws Exception\InvalidArgumentException
+     * @throws Exception\TimeoutException
+     *
+     * @return array Rows or exceptions, in the order of the statements.
+     *
+     * @see Session::execute() for valid execution options
+     */
+    public function executeConcurrent($statements, $concurrency, $statement, $options) { }
+
+    /**
+     * Execute a prepared statement once for every row of column arrays,
+     * with a bounded number of requests in flight. Values are bound
+     * directly from the arrays and statements are reused once their
+     * request completes.
+     *
+     * The arguments option, when given, holds values shared by every row.
+     *
+     * Requests count towards Cluster\Builder::withMaxInFlightRequests(), rows
+     * that don't get a slot are reported like rows that can't be bound.
+     *
+     * @param \Cassandra\PreparedStatement $statement The statement to execute for every row.
+     * @param array $columns Arrays of values of equal length, keyed by parameter name or position.
+     * @param int $concurrency The maximum number of requests in flight.
+     * @param array|\Cassandra\ExecutionOptions|null $options Options to control execution of the queries.
+     *
+     * @throws Exception\InvalidArgumentException
+     * @throws Exception\TimeoutException
+     *
+     * @return array Exceptions of the rows that failed, keyed by row.
+     *
+     * @see Session::execute() for valid execution options
+     */
+    public function executeColumns($statement, $columns, $concurrency, $options) { }
+
     /**
      * Prepare a query for execution.
      *
+     * Sessions created with persistent sessions enabled keep prepared
+     * statements across requests, keyed by keyspace and query, so preparing
+     * the same query again doesn't wait on a round trip. The keyspace is the
+     * one the session is connected to or last switched to with a `USE`
+     * statement. The cached statements are dropped whenever the schema
+     * changes, which is only noticed when schema metadata is enabled (see
+     * Cluster\Builder::withSchemaMetadata()).
+     *
      * @param string $cql The query to be prepared.
      * @param array|\Cassandra\ExecutionOptions|null $options Options to control preparing the query.
      *
@@ -107,6 +236,18 @@ final class DefaultSession implements Session {
      */
     public function closeAsync() { }
 
+    /**
+     * Runs the callbacks registered with `then()` on futures, in the order
+     * the futures resolve. Callbacks of every session run, and callbacks
+     * still pending at the end of the request run then, after the response
+     * is finished (through `fastcgi_finish_request()` under PHP-FPM).
+     *
+     * @param bool $wait Whether to wait until no callbacks are left, including ones registered by callbacks, or only run those whose futures have resolved
+     *
+     * @return int The number of futures whose callbacks ran
+     */
+    public function runCallbacks($wait) { }
+
     /**
      * Get performance and diagnostic metrics.
      *
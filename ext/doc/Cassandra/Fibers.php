@@ -0,0 +1,40 @@
+<?php
+
+/**
+ * Copyright 2015-2017 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+namespace Cassandra;
+/**
+ * Runs tasks written in a synchronous style concurrently (PHP 8.1 or later).
+ * Each task runs in its own fiber. Waiting on a future inside a task, for
+ * example with `Session::execute()` or `FutureRows::get()`, suspends the
+ * task and lets the others run until the result arrives.
+ */
+final class Fibers {
+
+    /**
+     * Runs the tasks until all of them have returned. Futures waited on by
+     * other fibers, or by fibers not started here, block as usual.
+     *
+     * @param array $tasks Callables taking no arguments
+     *
+     * @throws Exception\LogicException
+     *
+     * @return array The return value of each task, under the key of the task
+     */
+    public static function run($tasks) { }
+
+}
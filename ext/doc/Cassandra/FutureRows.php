@@ -37,4 +37,19 @@ final class FutureRows implements Future {
      */
     public function get($timeout) { }
 
+    /**
+     * Registers callbacks to run once the future has resolved. Callbacks
+     * never run on the driver's I/O threads, they run in
+     * `Session::runCallbacks()` or at the end of the request.
+     *
+     * @param callable $onSuccess Called with the result of `get()`
+     * @param callable|null $onError Called with the exception thrown by `get()`, which is rethrown when missing
+     *
+     * @throws Exception\InvalidArgumentException
+     * @throws Exception\LogicException
+     *
+     * @return \Cassandra\FutureRows This future
+     */
+    public function then($onSuccess, $onError) { }
+
 }
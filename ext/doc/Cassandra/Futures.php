@@ -0,0 +1,53 @@
+<?php
+
+/**
+ * Copyright 2015-2017 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+namespace Cassandra;
+/**
+ * Waits on several futures at once. Waiting returns as soon as the futures
+ * have resolved, in whatever order they do, without blocking on each of
+ * them in turn.
+ */
+final class Futures {
+
+    /**
+     * Waits for all of the futures to resolve.
+     *
+     * @param array $futures Instances of FutureRows, FuturePreparedStatement, FutureSession, FutureClose or FutureValue
+     * @param int|double|null $timeout A timeout in seconds
+     *
+     * @throws Exception\InvalidArgumentException
+     * @throws Exception\TimeoutException
+     *
+     * @return void
+     */
+    public static function waitAll($futures, $timeout) { }
+
+    /**
+     * Waits for any of the futures to resolve.
+     *
+     * @param array $futures Instances of FutureRows, FuturePreparedStatement, FutureSession, FutureClose or FutureValue
+     * @param int|double|null $timeout A timeout in seconds
+     *
+     * @throws Exception\InvalidArgumentException
+     * @throws Exception\TimeoutException
+     *
+     * @return int|string The key of the first resolved future in the array
+     */
+    public static function waitAny($futures, $timeout) { }
+
+}
@@ -26,10 +26,31 @@ namespace Cassandra;
  * faster, because they are sent directly to replica nodes and avoid the extra
  * network hop.
  *
+ * Plain PHP integers, floats and strings bound to a prepared statement are
+ * converted to the declared type of the parameter, e.g. an integer bound to
+ * a `bigint`, `timestamp`, `smallint`, `tinyint`, `float` or `varint` column,
+ * or a string bound to a `uuid`, `timeuuid`, `inet` or `varint` column.
+ *
+ * Plain PHP arrays can be bound to `list`, `set`, `map`, `tuple` and user type
+ * parameters. Maps use the array keys, tuples take the values in array order
+ * and user types take their fields from the string keys.
+ *
  * @see Session::prepare()
  */
 final class PreparedStatement implements Statement {
 
     private function __construct() { }
 
+    /**
+     * Creates a bound statement that keeps its encoded arguments across
+     * executions.
+     *
+     * @param array|null $arguments positional or named arguments (optional)
+     *
+     * @throws Exception\InvalidArgumentException
+     *
+     * @return \Cassandra\BoundStatement a bound statement
+     */
+    public function bind($arguments) { }
+
 }
@@ -20,6 +20,9 @@ namespace Cassandra;
 
 /**
  * Rows represent a result of statement execution.
+ *
+ * Rows are decoded in order up to the first time one is read and kept for
+ * later reads, so reading them in any order decodes each row only once.
  */
 final class Rows implements \Iterator, \ArrayAccess {
 
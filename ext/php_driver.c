@@ -19,9 +19,13 @@
 #include "php_driver_types.h"
 #include "version.h"
 
+#include "util/bind.h"
+#include "util/callback.h"
 #include "util/types.h"
 #include "util/ref.h"
 
+#include "src/DefaultSession.h"
+
 #include <php_ini.h>
 #include <ext/standard/info.h>
 
@@ -128,6 +132,7 @@ php_driver_session_dtor(zend_resource *rsrc)
   if (psession) {
     cass_future_free(psession->future);
     php_driver_del_peref(&psession->session, 1);
+    php_driver_del_peref(&psession->prepared_cache, 1);
     pefree(psession, 1);
     PHP_DRIVER_G(persistent_sessions)--;
     rsrc->ptr = NULL;
@@ -398,6 +403,10 @@ static PHP_GINIT_FUNCTION(php_driver)
   php_driver_globals->uuid_gen_pid        = 0;
   php_driver_globals->persistent_clusters = 0;
   php_driver_globals->persistent_sessions = 0;
+  php_driver_globals->binder_cache        = NULL;
+  php_driver_globals->fiber_loop          = NULL;
+  php_driver_globals->callbacks           = NULL;
+  ZVAL_UNDEF(&(php_driver_globals->deferred));
   ZVAL_UNDEF(&(php_driver_globals->type_varchar));
   ZVAL_UNDEF(&(php_driver_globals->type_text));
   ZVAL_UNDEF(&(php_driver_globals->type_blob));
@@ -499,6 +508,9 @@ PHP_MINIT_FUNCTION(php_driver)
   php_driver_define_FutureSession();
   php_driver_define_FutureValue();
   php_driver_define_FutureClose();
+  php_driver_define_Fibers();
+  php_driver_define_Futures();
+  php_driver_define_CompletionQueue();
   php_driver_define_Session();
   php_driver_define_DefaultSession();
   php_driver_define_SSLOptions();
@@ -507,6 +519,7 @@ PHP_MINIT_FUNCTION(php_driver)
   php_driver_define_SimpleStatement();
   php_driver_define_PreparedStatement();
   php_driver_define_BatchStatement();
+  php_driver_define_BoundStatement();
   php_driver_define_ExecutionOptions();
   php_driver_define_Rows();
 
@@ -569,12 +582,24 @@ PHP_RINIT_FUNCTION(php_driver)
 
 PHP_RSHUTDOWN_FUNCTION(php_driver)
 {
+  /* The response is finished before anything that waits on the cluster,
+   * so the client isn't held by callbacks or deferred writes. Callbacks run
+   * before the flush since they can start queries and defer more writes. */
+  if (!CG(unclean_shutdown) &&
+      (php_driver_callbacks_pending() || php_driver_default_session_has_deferred()))
+    php_driver_default_session_finish_response();
+
+  php_driver_callbacks_shutdown();
+  php_driver_default_session_flush_deferred(1);
+
 #define XX_SCALAR(name, value) \
   CASS_ZVAL_MAYBE_DESTROY(PHP_DRIVER_G(type_##name));
 
   PHP_DRIVER_SCALAR_TYPES_MAP(XX_SCALAR)
 #undef XX_SCALAR
 
+  php_driver_bind_cache_destroy();
+
   return SUCCESS;
 }
 
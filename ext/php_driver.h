@@ -252,6 +252,20 @@ void throw_invalid_argument(zval *object,
 
 #define PHP_DRIVER_DEFAULT_CONSISTENCY CASS_CONSISTENCY_LOCAL_ONE
 
+/* Upper bound on the requests Session::executeConcurrent() keeps in flight */
+#define PHP_DRIVER_MAX_CONCURRENCY 65536
+
+/* Requests Session::executeDetached() keeps in flight per session before
+ * waiting for one to complete */
+#define PHP_DRIVER_MAX_DETACHED_REQUESTS 1024
+
+/* Requests kept in flight while flushing writes from Session::defer() */
+#define PHP_DRIVER_DEFERRED_CONCURRENCY 64
+
+/* Deferred writes to the same partition are sent as unlogged batches of up
+ * to this size, which stays below Cassandra's default batch size warning */
+#define PHP_DRIVER_DEFERRED_BATCH_BYTES 4096
+
 #define PHP_DRIVER_DEFAULT_LOG       PHP_DRIVER_NAME ".log"
 #define PHP_DRIVER_DEFAULT_LOG_LEVEL "ERROR"
 
@@ -6,6 +6,10 @@ ZEND_BEGIN_MODULE_GLOBALS(php_driver)
   pid_t         uuid_gen_pid;
   unsigned int  persistent_clusters;
   unsigned int  persistent_sessions;
+  HashTable    *binder_cache;
+  struct php_driver_fiber_loop_ *fiber_loop;
+  struct php_driver_callbacks_ *callbacks;
+  zval          deferred;
   zval  type_varchar;
   zval  type_text;
   zval  type_blob;
@@ -49,6 +49,7 @@
   #define PHP_DRIVER_GET_FUTURE_VALUE(obj) php_driver_future_value_object_fetch(Z_OBJ_P(obj))
   #define PHP_DRIVER_GET_FUTURE_CLOSE(obj) php_driver_future_close_object_fetch(Z_OBJ_P(obj))
   #define PHP_DRIVER_GET_FUTURE_SESSION(obj) php_driver_future_session_object_fetch(Z_OBJ_P(obj))
+  #define PHP_DRIVER_GET_COMPLETION_QUEUE(obj) php_driver_completion_queue_object_fetch(Z_OBJ_P(obj))
   #define PHP_DRIVER_GET_SESSION(obj) php_driver_session_object_fetch(Z_OBJ_P(obj))
   #define PHP_DRIVER_GET_SSL(obj) php_driver_ssl_object_fetch(Z_OBJ_P(obj))
   #define PHP_DRIVER_GET_SSL_BUILDER(obj) php_driver_ssl_builder_object_fetch(Z_OBJ_P(obj))
@@ -182,15 +183,28 @@ PHP_DRIVER_BEGIN_OBJECT_TYPE(cluster)
   long default_consistency;
   int default_page_size;
   zval default_timeout;
+  unsigned int max_in_flight_requests;
+  int in_flight_policy;
+  cass_duration_t in_flight_timeout;
+  zval execution_profiles;
   cass_bool_t persist;
   char *hash_key;
   int hash_key_len;
 PHP_DRIVER_END_OBJECT_TYPE(cluster)
 
+typedef void (*php_driver_free_function)(void *data);
+
+typedef struct {
+  size_t                  count;
+  php_driver_free_function destruct;
+  void                   *data;
+} php_driver_ref;
+
 typedef enum {
   PHP_DRIVER_SIMPLE_STATEMENT,
   PHP_DRIVER_PREPARED_STATEMENT,
-  PHP_DRIVER_BATCH_STATEMENT
+  PHP_DRIVER_BATCH_STATEMENT,
+  PHP_DRIVER_BOUND_STATEMENT
 } php_driver_statement_type;
 
 PHP_DRIVER_BEGIN_OBJECT_TYPE(statement)
@@ -201,11 +215,31 @@ PHP_DRIVER_BEGIN_OBJECT_TYPE(statement)
     } simple;
     struct {
       const CassPrepared *prepared;
+      /* Set when the handle is shared through a persistent session's cache */
+      php_driver_ref *cached;
+      const CassDataType **param_types;
+      size_t param_count;
+      HashTable *param_names;
+      zend_string *cql;
+      /* The parameters bound to the partition key of the table the
+       * statement writes to, resolved on first use. The count is -1 until
+       * then and 0 when the partition key can't be bound. */
+      int *partition_key;
+      int partition_key_count;
+      /* The columns of the statement's last result */
+      php_driver_ref *columns_cache;
     } prepared;
     struct {
       CassBatchType type;
       HashTable statements;
+      cass_bool_t group_by_partition;
+      size_t max_bytes;
     } batch;
+    struct {
+      zval prepared;
+      php_driver_ref *statement;
+      HashTable values;
+    } bound;
   } data;
 PHP_DRIVER_END_OBJECT_TYPE(statement)
 
@@ -224,6 +258,9 @@ PHP_DRIVER_BEGIN_OBJECT_TYPE(execution_options)
   zval arguments;
   zval retry_policy;
   cass_int64_t timestamp;
+  int is_idempotent;
+  int fetch_scalars;
+  zval execution_profile;
 PHP_DRIVER_END_OBJECT_TYPE(execution_options)
 
 typedef enum {
@@ -232,19 +269,18 @@ typedef enum {
   LOAD_BALANCING_DC_AWARE_ROUND_ROBIN
 } php_driver_load_balancing;
 
-typedef void (*php_driver_free_function)(void *data);
-
-typedef struct {
-  size_t                  count;
-  php_driver_free_function destruct;
-  void                   *data;
-} php_driver_ref;
-
 PHP_DRIVER_BEGIN_OBJECT_TYPE(rows)
   php_driver_ref *statement;
   php_driver_ref *session;
+  /* The rows of the page that were decoded so far, in order */
   zval rows;
-  zval next_rows;
+  php_driver_ref *page;
+  php_driver_ref *columns_cache;
+  php_driver_ref *columns;
+  cass_bool_t fetch_scalars;
+  CassIterator *iterator;
+  size_t count;
+  size_t position;
   php_driver_ref *result;
   php_driver_ref *next_result;
   zval future_next_page;
@@ -253,8 +289,9 @@ PHP_DRIVER_END_OBJECT_TYPE(rows)
 PHP_DRIVER_BEGIN_OBJECT_TYPE(future_rows)
   php_driver_ref *statement;
   php_driver_ref *session;
-  zval rows;
   php_driver_ref *result;
+  php_driver_ref *columns_cache;
+  cass_bool_t fetch_scalars;
   CassFuture *future;
 PHP_DRIVER_END_OBJECT_TYPE(future_rows)
 
@@ -281,6 +318,12 @@ PHP_DRIVER_BEGIN_OBJECT_TYPE(cluster_builder)
   int max_connections_per_host;
   unsigned int reconnect_interval;
   cass_bool_t enable_latency_aware_routing;
+  cass_bool_t latency_aware_routing_settings;
+  cass_double_t latency_exclusion_threshold;
+  cass_uint64_t latency_scale;
+  cass_uint64_t latency_retry_period;
+  cass_uint64_t latency_update_rate;
+  cass_uint64_t latency_min_measured;
   cass_bool_t enable_tcp_nodelay;
   cass_bool_t enable_tcp_keepalive;
   unsigned int tcp_keepalive_delay;
@@ -294,11 +337,19 @@ PHP_DRIVER_BEGIN_OBJECT_TYPE(cluster_builder)
   cass_bool_t enable_hostname_resolution;
   cass_bool_t enable_randomized_contact_points;
   unsigned int connection_heartbeat_interval;
+  unsigned int max_in_flight_requests;
+  int in_flight_policy;
+  cass_duration_t in_flight_timeout;
+  cass_int64_t speculative_execution_delay;
+  int speculative_executions;
+  zval execution_profiles;
 PHP_DRIVER_END_OBJECT_TYPE(cluster_builder)
 
 PHP_DRIVER_BEGIN_OBJECT_TYPE(future_prepared_statement)
   CassFuture *future;
   zval prepared_statement;
+  php_driver_ref *prepared_cache;
+  zend_string *cql;
 PHP_DRIVER_END_OBJECT_TYPE(future_prepared_statement)
 
 PHP_DRIVER_BEGIN_OBJECT_TYPE(future_value)
@@ -312,7 +363,11 @@ PHP_DRIVER_END_OBJECT_TYPE(future_close)
 PHP_DRIVER_BEGIN_OBJECT_TYPE(future_session)
   CassFuture *future;
   php_driver_ref *session;
+  php_driver_ref *prepared_cache;
   zval default_session;
+  zval execution_profiles;
+  zend_string *keyspace;
+  struct php_driver_throttle_ *throttle;
   cass_bool_t persist;
   char *hash_key;
   int hash_key_len;
@@ -320,17 +375,30 @@ PHP_DRIVER_BEGIN_OBJECT_TYPE(future_session)
   CassError exception_code;
 PHP_DRIVER_END_OBJECT_TYPE(future_session)
 
+PHP_DRIVER_BEGIN_OBJECT_TYPE(completion_queue)
+  struct php_driver_future_queue_ *queue;
+  HashTable futures;
+  zval resolved;
+  zval stream;
+PHP_DRIVER_END_OBJECT_TYPE(completion_queue)
+
 typedef struct {
   CassFuture *future;
   php_driver_ref *session;
+  php_driver_ref *prepared_cache;
 } php_driver_psession;
 
 PHP_DRIVER_BEGIN_OBJECT_TYPE(session)
   php_driver_ref *session;
+  php_driver_ref *prepared_cache;
   long default_consistency;
   int default_page_size;
   zval default_timeout;
+  zval execution_profiles;
+  zend_string *keyspace;
   cass_bool_t persist;
+  struct php_driver_detached_ *detached;
+  struct php_driver_throttle_ *throttle;
 PHP_DRIVER_END_OBJECT_TYPE(session)
 
 PHP_DRIVER_BEGIN_OBJECT_TYPE(ssl)
@@ -554,6 +622,9 @@ extern PHP_DRIVER_API zend_class_entry *php_driver_future_rows_ce;
 extern PHP_DRIVER_API zend_class_entry *php_driver_future_session_ce;
 extern PHP_DRIVER_API zend_class_entry *php_driver_future_value_ce;
 extern PHP_DRIVER_API zend_class_entry *php_driver_future_close_ce;
+extern PHP_DRIVER_API zend_class_entry *php_driver_fibers_ce;
+extern PHP_DRIVER_API zend_class_entry *php_driver_futures_ce;
+extern PHP_DRIVER_API zend_class_entry *php_driver_completion_queue_ce;
 extern PHP_DRIVER_API zend_class_entry *php_driver_session_ce;
 extern PHP_DRIVER_API zend_class_entry *php_driver_default_session_ce;
 extern PHP_DRIVER_API zend_class_entry *php_driver_exception_ce;
@@ -587,6 +658,7 @@ extern PHP_DRIVER_API zend_class_entry *php_driver_statement_ce;
 extern PHP_DRIVER_API zend_class_entry *php_driver_simple_statement_ce;
 extern PHP_DRIVER_API zend_class_entry *php_driver_prepared_statement_ce;
 extern PHP_DRIVER_API zend_class_entry *php_driver_batch_statement_ce;
+extern PHP_DRIVER_API zend_class_entry *php_driver_bound_statement_ce;
 extern PHP_DRIVER_API zend_class_entry *php_driver_execution_options_ce;
 extern PHP_DRIVER_API zend_class_entry *php_driver_rows_ce;
 
@@ -600,6 +672,9 @@ void php_driver_define_FutureRows();
 void php_driver_define_FutureSession();
 void php_driver_define_FutureValue();
 void php_driver_define_FutureClose();
+void php_driver_define_Fibers();
+void php_driver_define_Futures();
+void php_driver_define_CompletionQueue();
 void php_driver_define_Session();
 void php_driver_define_DefaultSession();
 void php_driver_define_SSLOptions();
@@ -608,6 +683,7 @@ void php_driver_define_Statement();
 void php_driver_define_SimpleStatement();
 void php_driver_define_PreparedStatement();
 void php_driver_define_BatchStatement();
+void php_driver_define_BoundStatement();
 void php_driver_define_ExecutionOptions();
 void php_driver_define_Rows();
 
@@ -32,9 +32,12 @@ void php_driver_batch_statement_entry_dtor(zval *dest)
 PHP_METHOD(BatchStatement, __construct)
 {
   zval *type = NULL;
+  zval *options = NULL;
+  zval *group_by_partition = NULL;
+  zval *max_bytes = NULL;
   php_driver_statement *self = NULL;
 
-  if (zend_parse_parameters(ZEND_NUM_ARGS(), "|z", &type) == FAILURE) {
+  if (zend_parse_parameters(ZEND_NUM_ARGS(), "|za", &type, &options) == FAILURE) {
     return;
   }
 
@@ -55,6 +58,33 @@ PHP_METHOD(BatchStatement, __construct)
       INVALID_ARGUMENT(type, "one of " PHP_DRIVER_NAMESPACE "::BATCH_TYPE_*");
     }
   }
+
+  if (!options)
+    return;
+
+  if (CASS_ZEND_HASH_FIND(Z_ARRVAL_P(options), "group_by_partition", sizeof("group_by_partition"),
+                          group_by_partition)) {
+    if (Z_TYPE_P(group_by_partition) != IS_TRUE && Z_TYPE_P(group_by_partition) != IS_FALSE) {
+      INVALID_ARGUMENT(group_by_partition, "a boolean");
+    }
+    self->data.batch.group_by_partition = Z_TYPE_P(group_by_partition) == IS_TRUE;
+  }
+
+  if (CASS_ZEND_HASH_FIND(Z_ARRVAL_P(options), "max_bytes", sizeof("max_bytes"), max_bytes)) {
+    if (Z_TYPE_P(max_bytes) != IS_LONG || Z_LVAL_P(max_bytes) <= 0) {
+      INVALID_ARGUMENT(max_bytes, "a positive integer");
+    }
+    self->data.batch.max_bytes = (size_t) Z_LVAL_P(max_bytes);
+  }
+
+  /* Splitting a logged or counter batch would break its guarantees */
+  if ((self->data.batch.group_by_partition || self->data.batch.max_bytes > 0) &&
+      self->data.batch.type != CASS_BATCH_TYPE_UNLOGGED) {
+    zend_throw_exception_ex(php_driver_invalid_argument_exception_ce, 0,
+                            "Only unlogged batches can be split, use "
+                            PHP_DRIVER_NAMESPACE "::BATCH_UNLOGGED");
+    return;
+  }
 }
 
 PHP_METHOD(BatchStatement, add)
@@ -73,20 +103,36 @@ PHP_METHOD(BatchStatement, add)
   if (Z_TYPE_P(statement) != IS_STRING &&
       (Z_TYPE_P(statement) != IS_OBJECT ||
        (!instanceof_function(Z_OBJCE_P(statement), php_driver_simple_statement_ce) &&
-        !instanceof_function(Z_OBJCE_P(statement), php_driver_prepared_statement_ce)))) {
+        !instanceof_function(Z_OBJCE_P(statement), php_driver_prepared_statement_ce) &&
+        !instanceof_function(Z_OBJCE_P(statement), php_driver_bound_statement_ce)))) {
     INVALID_ARGUMENT(statement, "a string, an instance of "
-                     PHP_DRIVER_NAMESPACE "\\SimpleStatement or an instance of "
-                     PHP_DRIVER_NAMESPACE "\\PreparedStatement");
+                     PHP_DRIVER_NAMESPACE "\\SimpleStatement, an instance of "
+                     PHP_DRIVER_NAMESPACE "\\PreparedStatement or an instance of "
+                     PHP_DRIVER_NAMESPACE "\\BoundStatement");
   }
 
   self = PHP_DRIVER_GET_STATEMENT(getThis());
 
   batch_statement_entry = (php_driver_batch_statement_entry *) ecalloc(1, sizeof(php_driver_batch_statement_entry));
 
-  ZVAL_COPY(&(batch_statement_entry->statement), statement);
+  if (Z_TYPE_P(statement) == IS_OBJECT &&
+      instanceof_function(Z_OBJCE_P(statement), php_driver_bound_statement_ce)) {
+    /* Bound statements are added with the arguments they have right now */
+    php_driver_statement *bound = PHP_DRIVER_GET_STATEMENT(statement);
+
+    ZVAL_COPY(&(batch_statement_entry->statement), &(bound->data.bound.prepared));
+    ZVAL_ARR(&(batch_statement_entry->arguments), zend_array_dup(&(bound->data.bound.values)));
 
-  if (arguments) {
-    ZVAL_COPY(&(batch_statement_entry->arguments), arguments);
+    if (arguments && Z_TYPE_P(arguments) == IS_ARRAY) {
+      zend_hash_merge(Z_ARRVAL(batch_statement_entry->arguments), Z_ARRVAL_P(arguments),
+                      zval_add_ref, 1);
+    }
+  } else {
+    ZVAL_COPY(&(batch_statement_entry->statement), statement);
+
+    if (arguments) {
+      ZVAL_COPY(&(batch_statement_entry->arguments), arguments);
+    }
   }
 
   ZVAL_PTR(&entry, batch_statement_entry);
@@ -95,6 +141,7 @@ PHP_METHOD(BatchStatement, add)
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo__construct, 0, ZEND_RETURN_VALUE, 0)
   ZEND_ARG_INFO(0, type)
+  ZEND_ARG_ARRAY_INFO(0, options, 0)
 ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_add, 0, ZEND_RETURN_VALUE, 1)
@@ -137,6 +184,8 @@ php_driver_batch_statement_new(zend_class_entry *ce)
 
   self->type       = PHP_DRIVER_BATCH_STATEMENT;
   self->data.batch.type = CASS_BATCH_TYPE_LOGGED;
+  self->data.batch.group_by_partition = cass_false;
+  self->data.batch.max_bytes = 0;
   zend_hash_init(&self->data.batch.statements, 0, NULL, (dtor_func_t) php_driver_batch_statement_entry_dtor, 0);
 
   CASS_ZEND_OBJECT_INIT_EX(statement, batch_statement, self, ce);
@@ -0,0 +1,207 @@
+/**
+ * Copyright 2015-2017 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "php_driver.h"
+#include "php_driver_types.h"
+#include "util/bind.h"
+#include "util/ref.h"
+#include "BoundStatement.h"
+
+zend_class_entry *php_driver_bound_statement_ce = NULL;
+
+static void
+free_statement(void *statement)
+{
+  cass_statement_free((CassStatement *) statement);
+}
+
+CassStatement *
+php_driver_bound_statement_acquire(php_driver_statement *self)
+{
+  php_driver_statement *prepared;
+  CassStatement *statement;
+
+  if (self->data.bound.statement) {
+    if (self->data.bound.statement->count == 1)
+      return (CassStatement *) self->data.bound.statement->data;
+
+    /* Still used by a result for fetching its next page */
+    php_driver_bound_statement_release(self);
+  }
+
+  prepared  = PHP_DRIVER_GET_STATEMENT(&self->data.bound.prepared);
+  statement = cass_prepared_bind(prepared->data.prepared.prepared);
+
+  if (php_driver_bind_arguments(statement, prepared, &self->data.bound.values) == FAILURE) {
+    cass_statement_free(statement);
+    return NULL;
+  }
+
+  self->data.bound.statement = php_driver_new_ref(statement, free_statement);
+
+  return statement;
+}
+
+void
+php_driver_bound_statement_release(php_driver_statement *self)
+{
+  if (self->data.bound.statement) {
+    php_driver_del_ref(&self->data.bound.statement);
+    self->data.bound.statement = NULL;
+  }
+}
+
+static int
+php_driver_bound_statement_set(php_driver_statement *self, zend_string *name,
+                               zend_ulong index, zval *value)
+{
+  php_driver_statement *prepared = PHP_DRIVER_GET_STATEMENT(&self->data.bound.prepared);
+  CassStatement *statement = php_driver_bound_statement_acquire(self);
+
+  if (!statement)
+    return FAILURE;
+
+  if (name && php_driver_bind_parameter_index(prepared, name, &index) == SUCCESS)
+    name = NULL;
+
+  ZVAL_DEREF(value);
+
+  if (php_driver_bind_argument(statement, prepared, name, index, value) == FAILURE) {
+    if (!EG(exception))
+      throw_invalid_argument(value, "value", "a value supported by the parameter");
+    return FAILURE;
+  }
+
+  Z_TRY_ADDREF_P(value);
+  if (name) {
+    zend_hash_update(&self->data.bound.values, name, value);
+  } else {
+    zend_hash_index_update(&self->data.bound.values, index, value);
+  }
+
+  return SUCCESS;
+}
+
+int
+php_driver_bound_statement_bind(php_driver_statement *self, HashTable *arguments)
+{
+  zval *current;
+  zend_ulong num_key;
+  zend_string *key;
+
+  ZEND_HASH_FOREACH_KEY_VAL(arguments, num_key, key, current) {
+    if (php_driver_bound_statement_set(self, key, num_key, current) == FAILURE)
+      return FAILURE;
+  } ZEND_HASH_FOREACH_END();
+
+  return SUCCESS;
+}
+
+PHP_METHOD(BoundStatement, __construct)
+{
+}
+
+PHP_METHOD(BoundStatement, set)
+{
+  zval *name_or_index = NULL;
+  zval *value = NULL;
+  php_driver_statement *self = NULL;
+  int rc = FAILURE;
+
+  if (zend_parse_parameters(ZEND_NUM_ARGS(), "zz", &name_or_index, &value) == FAILURE) {
+    return;
+  }
+
+  self = PHP_DRIVER_GET_STATEMENT(getThis());
+
+  if (Z_TYPE_P(name_or_index) == IS_LONG && Z_LVAL_P(name_or_index) >= 0) {
+    rc = php_driver_bound_statement_set(self, NULL, (zend_ulong) Z_LVAL_P(name_or_index), value);
+  } else if (Z_TYPE_P(name_or_index) == IS_STRING) {
+    rc = php_driver_bound_statement_set(self, Z_STR_P(name_or_index), 0, value);
+  } else {
+    INVALID_ARGUMENT(name_or_index, "a parameter name or a positive integer index");
+  }
+
+  if (rc == FAILURE)
+    return;
+
+  RETURN_ZVAL(getThis(), 1, 0);
+}
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_none, 0, ZEND_RETURN_VALUE, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_set, 0, ZEND_RETURN_VALUE, 2)
+  ZEND_ARG_INFO(0, name_or_index)
+  ZEND_ARG_INFO(0, value)
+ZEND_END_ARG_INFO()
+
+static zend_function_entry php_driver_bound_statement_methods[] = {
+  PHP_ME(BoundStatement, __construct, arginfo_none, ZEND_ACC_PRIVATE | ZEND_ACC_CTOR)
+  PHP_ME(BoundStatement, set, arginfo_set, ZEND_ACC_PUBLIC)
+  PHP_FE_END
+};
+
+static zend_object_handlers php_driver_bound_statement_handlers;
+
+static int
+php_driver_bound_statement_compare(zval *obj1, zval *obj2)
+{
+  ZEND_COMPARE_OBJECTS_FALLBACK(obj1, obj2);
+
+  return Z_OBJ_HANDLE_P(obj1) != Z_OBJ_HANDLE_P(obj1);
+}
+
+static void
+php_driver_bound_statement_free(zend_object *object)
+{
+  php_driver_statement *self = php_driver_statement_object_fetch(object);
+
+  php_driver_bound_statement_release(self);
+  zend_hash_destroy(&self->data.bound.values);
+  CASS_ZVAL_MAYBE_DESTROY(self->data.bound.prepared);
+
+  zend_object_std_dtor(&self->zval);
+}
+
+static zend_object *
+php_driver_bound_statement_new(zend_class_entry *ce)
+{
+  php_driver_statement *self =
+      CASS_ZEND_OBJECT_ECALLOC(statement, ce);
+
+  self->type = PHP_DRIVER_BOUND_STATEMENT;
+  self->data.bound.statement = NULL;
+  ZVAL_UNDEF(&self->data.bound.prepared);
+  zend_hash_init(&self->data.bound.values, 0, NULL, ZVAL_PTR_DTOR, 0);
+
+  CASS_ZEND_OBJECT_INIT_EX(statement, bound_statement, self, ce);
+}
+
+void php_driver_define_BoundStatement()
+{
+  zend_class_entry ce;
+
+  INIT_CLASS_ENTRY(ce, PHP_DRIVER_NAMESPACE "\\BoundStatement", php_driver_bound_statement_methods);
+  php_driver_bound_statement_ce = zend_register_internal_class(&ce);
+  zend_class_implements(php_driver_bound_statement_ce, 1, php_driver_statement_ce);
+  php_driver_bound_statement_ce->ce_flags     |= ZEND_ACC_FINAL;
+  php_driver_bound_statement_ce->create_object = php_driver_bound_statement_new;
+
+  memcpy(&php_driver_bound_statement_handlers, zend_get_std_object_handlers(), sizeof(zend_object_handlers));
+  CASS_COMPAT_SET_COMPARE_HANDLER(php_driver_bound_statement_handlers, php_driver_bound_statement_compare);
+  php_driver_bound_statement_handlers.clone_obj = NULL;
+}
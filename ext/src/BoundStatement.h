@@ -0,0 +1,33 @@
+/**
+ * Copyright 2015-2017 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PHP_DRIVER_BOUND_STATEMENT_H
+#define PHP_DRIVER_BOUND_STATEMENT_H
+
+int
+php_driver_bound_statement_bind(php_driver_statement *self, HashTable *arguments);
+
+/* Returns a statement that is not shared with any pending result, rebuilding
+ * it from the bound values when it is */
+CassStatement *
+php_driver_bound_statement_acquire(php_driver_statement *self);
+
+/* Hands the current statement over to its other owners, e.g. a request that
+ * may still be in flight */
+void
+php_driver_bound_statement_release(php_driver_statement *self);
+
+#endif /* PHP_DRIVER_BOUND_STATEMENT_H */
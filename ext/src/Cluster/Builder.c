@@ -18,11 +18,84 @@
 #include "php_driver_globals.h"
 #include "php_driver_types.h"
 #include "util/consistency.h"
+#include "util/future.h"
+#include "util/throttle.h"
+#include "src/ExecutionOptions.h"
 
 #include <zend_smart_str.h>
 
 zend_class_entry *php_driver_cluster_builder_ce = NULL;
 
+/* Profiles are part of the cluster configuration, so persistent clusters
+ * are only shared by builders with the same ones */
+static void
+execution_profiles_key(php_driver_cluster_builder *self, smart_str *key)
+{
+  zend_string *name;
+  zval *profile;
+
+  if (Z_ISUNDEF(self->execution_profiles))
+    return;
+
+  ZEND_HASH_FOREACH_STR_KEY_VAL(Z_ARRVAL(self->execution_profiles), name, profile) {
+    php_driver_execution_options *opts = PHP_DRIVER_GET_EXECUTION_OPTIONS(profile);
+    cass_duration_t timeout_us = 0;
+
+    if (!Z_ISUNDEF(opts->timeout))
+      php_driver_future_get_timeout(&(opts->timeout), &timeout_us);
+
+    smart_str_appendc(key, ':');
+    smart_str_append(key, name);
+    smart_str_appendc(key, '=');
+    smart_str_append_long(key, opts->consistency);
+    smart_str_appendc(key, ':');
+    smart_str_append_long(key, opts->serial_consistency);
+    smart_str_appendc(key, ':');
+    smart_str_append_long(key, (zend_long) timeout_us);
+    if (!Z_ISUNDEF(opts->retry_policy)) {
+      smart_str_appendc(key, ':');
+      smart_str_append(key, Z_OBJCE(opts->retry_policy)->name);
+    }
+  } ZEND_HASH_FOREACH_END();
+}
+
+static void
+set_execution_profiles(php_driver_cluster_builder *self, CassCluster *cluster)
+{
+#if CURRENT_CPP_DRIVER_VERSION >= CPP_DRIVER_VERSION(2, 8, 0)
+  zend_string *name;
+  zval *profile;
+
+  if (Z_ISUNDEF(self->execution_profiles))
+    return;
+
+  ZEND_HASH_FOREACH_STR_KEY_VAL(Z_ARRVAL(self->execution_profiles), name, profile) {
+    php_driver_execution_options *opts = PHP_DRIVER_GET_EXECUTION_OPTIONS(profile);
+    CassExecProfile *exec_profile = cass_execution_profile_new();
+    cass_duration_t timeout_us = 0;
+
+    if (opts->consistency >= 0)
+      cass_execution_profile_set_consistency(exec_profile, (CassConsistency) opts->consistency);
+
+    if (opts->serial_consistency >= 0)
+      cass_execution_profile_set_serial_consistency(exec_profile,
+                                                    (CassConsistency) opts->serial_consistency);
+
+    if (!Z_ISUNDEF(opts->timeout) &&
+        php_driver_future_get_timeout(&(opts->timeout), &timeout_us) == SUCCESS &&
+        timeout_us > 0)
+      cass_execution_profile_set_request_timeout(exec_profile, (timeout_us + 999) / 1000);
+
+    if (!Z_ISUNDEF(opts->retry_policy))
+      cass_execution_profile_set_retry_policy(exec_profile,
+                                              PHP_DRIVER_GET_RETRY_POLICY(&(opts->retry_policy))->policy);
+
+    cass_cluster_set_execution_profile(cluster, ZSTR_VAL(name), exec_profile);
+    cass_execution_profile_free(exec_profile);
+  } ZEND_HASH_FOREACH_END();
+#endif
+}
+
 PHP_METHOD(ClusterBuilder, build)
 {
   CassError rc;
@@ -36,12 +109,24 @@ PHP_METHOD(ClusterBuilder, build)
   cluster->default_consistency = self->default_consistency;
   cluster->default_page_size   = self->default_page_size;
 
+  cluster->max_in_flight_requests = self->max_in_flight_requests;
+  cluster->in_flight_policy       = self->in_flight_policy;
+  cluster->in_flight_timeout      = self->in_flight_timeout;
+
   ZVAL_COPY(&(cluster->default_timeout),
                     &(self->default_timeout));
 
+  if (!Z_ISUNDEF(self->execution_profiles))
+    ZVAL_COPY(&(cluster->execution_profiles), &(self->execution_profiles));
+
   if (self->persist) {
+    smart_str profiles = {0};
+
+    execution_profiles_key(self, &profiles);
+    smart_str_0(&profiles);
+
     cluster->hash_key_len = spprintf(&cluster->hash_key, 0,
-                                     PHP_DRIVER_NAME ":%s:%d:%d:%s:%d:%d:%d:%s:%s:%d:%d:%d:%d:%d:%d:%d:%d:%d:%d:%d:%d:%d:%d:%d:%s:%s:%s:%s",
+                                     PHP_DRIVER_NAME ":%s:%d:%d:%s:%d:%d:%d:%s:%s:%d:%d:%d:%d:%d:%d:%d:%d:%d:%.17g:%lu:%lu:%lu:%lu:%d:%d:%d:%d:%d:%d:%d:%s:%s:%s:%s:%ld:%d%s",
                                      self->contact_points, self->port, self->load_balancing_policy,
                                      SAFE_STR(self->local_dc), self->used_hosts_per_remote_dc,
                                      self->allow_remote_dcs_for_local_cl, self->use_token_aware_routing,
@@ -50,12 +135,22 @@ PHP_METHOD(ClusterBuilder, build)
                                      self->protocol_version, self->io_threads,
                                      self->core_connections_per_host, self->max_connections_per_host,
                                      self->reconnect_interval, self->enable_latency_aware_routing,
+                                     self->latency_aware_routing_settings,
+                                     (double) self->latency_exclusion_threshold,
+                                     (unsigned long) self->latency_scale,
+                                     (unsigned long) self->latency_retry_period,
+                                     (unsigned long) self->latency_update_rate,
+                                     (unsigned long) self->latency_min_measured,
                                      self->enable_tcp_nodelay, self->enable_tcp_keepalive,
                                      self->tcp_keepalive_delay, self->enable_schema,
                                      self->enable_hostname_resolution, self->enable_randomized_contact_points,
                                      self->connection_heartbeat_interval,
                                      SAFE_STR(self->whitelist_hosts), SAFE_STR(self->whitelist_dcs),
-                                     SAFE_STR(self->blacklist_hosts), SAFE_STR(self->blacklist_dcs));
+                                     SAFE_STR(self->blacklist_hosts), SAFE_STR(self->blacklist_dcs),
+                                     (long) self->speculative_execution_delay, self->speculative_executions,
+                                     SAFE_STR(CASS_SMART_STR_VAL(profiles)));
+
+    smart_str_free(&profiles);
 
     if (self->persist) {
       zval *le;
@@ -119,6 +214,14 @@ PHP_METHOD(ClusterBuilder, build)
   ASSERT_SUCCESS(cass_cluster_set_max_connections_per_host(cluster->cluster, self->max_connections_per_host));
   cass_cluster_set_reconnect_wait_time(cluster->cluster, self->reconnect_interval);
   cass_cluster_set_latency_aware_routing(cluster->cluster, self->enable_latency_aware_routing);
+  if (self->latency_aware_routing_settings) {
+    cass_cluster_set_latency_aware_routing_settings(cluster->cluster,
+                                                    self->latency_exclusion_threshold,
+                                                    self->latency_scale,
+                                                    self->latency_retry_period,
+                                                    self->latency_update_rate,
+                                                    self->latency_min_measured);
+  }
   cass_cluster_set_tcp_nodelay(cluster->cluster, self->enable_tcp_nodelay);
   cass_cluster_set_tcp_keepalive(cluster->cluster, self->enable_tcp_keepalive, self->tcp_keepalive_delay);
   cass_cluster_set_use_schema(cluster->cluster, self->enable_schema);
@@ -135,6 +238,12 @@ PHP_METHOD(ClusterBuilder, build)
   ASSERT_SUCCESS(cass_cluster_set_use_randomized_contact_points(cluster->cluster, self->enable_randomized_contact_points));
   cass_cluster_set_connection_heartbeat_interval(cluster->cluster, self->connection_heartbeat_interval);
 
+  if (self->speculative_executions > 0) {
+    ASSERT_SUCCESS(cass_cluster_set_constant_speculative_execution_policy(cluster->cluster,
+                                                                          self->speculative_execution_delay,
+                                                                          self->speculative_executions));
+  }
+
   if (!Z_ISUNDEF(self->timestamp_gen)) {
     php_driver_timestamp_gen *timestamp_gen =
         PHP_DRIVER_GET_TIMESTAMP_GEN(&(self->timestamp_gen));
@@ -147,6 +256,8 @@ PHP_METHOD(ClusterBuilder, build)
     cass_cluster_set_retry_policy(cluster->cluster, retry_policy->policy);
   }
 
+  set_execution_profiles(self, cluster->cluster);
+
   if (self->persist) {
     zval resource;
 
@@ -744,6 +855,99 @@ PHP_METHOD(ClusterBuilder, withLatencyAwareRouting)
   RETURN_ZVAL(getThis(), 1, 0);
 }
 
+/* Reads a number of seconds from the settings as milliseconds */
+static int
+get_latency_setting_ms(HashTable *settings, const char *name, size_t name_len,
+                       cass_uint64_t *ms)
+{
+  zval *value = zend_hash_str_find(settings, name, name_len);
+
+  if (!value)
+    return SUCCESS;
+
+  if (Z_TYPE_P(value) == IS_LONG && Z_LVAL_P(value) >= 0) {
+    *ms = (cass_uint64_t) Z_LVAL_P(value) * 1000;
+  } else if (Z_TYPE_P(value) == IS_DOUBLE && Z_DVAL_P(value) >= 0) {
+    *ms = (cass_uint64_t) ceil(Z_DVAL_P(value) * 1000);
+  } else {
+    zend_throw_exception_ex(php_driver_invalid_argument_exception_ce, 0,
+                            "%s must be a number of seconds greater than or equal to zero",
+                            name);
+    return FAILURE;
+  }
+
+  return SUCCESS;
+}
+
+PHP_METHOD(ClusterBuilder, withLatencyAwareRoutingSettings)
+{
+  zval *settings = NULL;
+  zval *value;
+  zend_string *name;
+  php_driver_cluster_builder *self;
+  cass_double_t exclusion_threshold = 2.0;
+  cass_uint64_t scale = 100;
+  cass_uint64_t retry_period = 10000;
+  cass_uint64_t update_rate = 100;
+  cass_uint64_t min_measured = 50;
+
+  if (zend_parse_parameters(ZEND_NUM_ARGS(), "a", &settings) == FAILURE) {
+    return;
+  }
+
+  self = PHP_DRIVER_GET_CLUSTER_BUILDER(getThis());
+
+  ZEND_HASH_FOREACH_STR_KEY(Z_ARRVAL_P(settings), name) {
+    if (!name ||
+        (!zend_string_equals_literal(name, "exclusion_threshold") &&
+         !zend_string_equals_literal(name, "scale") &&
+         !zend_string_equals_literal(name, "retry_period") &&
+         !zend_string_equals_literal(name, "update_rate") &&
+         !zend_string_equals_literal(name, "min_measured"))) {
+      zend_throw_exception_ex(php_driver_invalid_argument_exception_ce, 0,
+                              "Unknown latency-aware routing setting: %s",
+                              name ? ZSTR_VAL(name) : "(index)");
+      return;
+    }
+  } ZEND_HASH_FOREACH_END();
+
+  value = zend_hash_str_find(Z_ARRVAL_P(settings), ZEND_STRL("exclusion_threshold"));
+  if (value) {
+    if (Z_TYPE_P(value) == IS_LONG && Z_LVAL_P(value) >= 1) {
+      exclusion_threshold = (cass_double_t) Z_LVAL_P(value);
+    } else if (Z_TYPE_P(value) == IS_DOUBLE && Z_DVAL_P(value) >= 1.0) {
+      exclusion_threshold = Z_DVAL_P(value);
+    } else {
+      throw_invalid_argument(value, "exclusion_threshold", "a number greater than or equal to 1");
+      return;
+    }
+  }
+
+  if (get_latency_setting_ms(Z_ARRVAL_P(settings), ZEND_STRL("scale"), &scale) == FAILURE ||
+      get_latency_setting_ms(Z_ARRVAL_P(settings), ZEND_STRL("retry_period"), &retry_period) == FAILURE ||
+      get_latency_setting_ms(Z_ARRVAL_P(settings), ZEND_STRL("update_rate"), &update_rate) == FAILURE)
+    return;
+
+  value = zend_hash_str_find(Z_ARRVAL_P(settings), ZEND_STRL("min_measured"));
+  if (value) {
+    if (Z_TYPE_P(value) != IS_LONG || Z_LVAL_P(value) < 0) {
+      throw_invalid_argument(value, "min_measured", "an integer greater than or equal to zero");
+      return;
+    }
+    min_measured = (cass_uint64_t) Z_LVAL_P(value);
+  }
+
+  self->enable_latency_aware_routing   = 1;
+  self->latency_aware_routing_settings = 1;
+  self->latency_exclusion_threshold    = exclusion_threshold;
+  self->latency_scale                  = scale;
+  self->latency_retry_period           = retry_period;
+  self->latency_update_rate            = update_rate;
+  self->latency_min_measured           = min_measured;
+
+  RETURN_ZVAL(getThis(), 1, 0);
+}
+
 PHP_METHOD(ClusterBuilder, withTCPNodelay)
 {
   zend_bool enabled = 1;
@@ -901,6 +1105,148 @@ PHP_METHOD(ClusterBuilder, withConnectionHeartbeatInterval)
   RETURN_ZVAL(getThis(), 1, 0);
 }
 
+PHP_METHOD(ClusterBuilder, withConstantSpeculativeExecutionPolicy)
+{
+  zval *delay = NULL;
+  zval *executions = NULL;
+  php_driver_cluster_builder *self;
+
+  if (zend_parse_parameters(ZEND_NUM_ARGS(), "zz", &delay, &executions) == FAILURE) {
+    return;
+  }
+
+  self = PHP_DRIVER_GET_CLUSTER_BUILDER(getThis());
+
+  if (!(Z_TYPE_P(delay) == IS_LONG && Z_LVAL_P(delay) >= 0) &&
+      !(Z_TYPE_P(delay) == IS_DOUBLE && Z_DVAL_P(delay) >= 0)) {
+    INVALID_ARGUMENT(delay, "a number of seconds greater than or equal to zero");
+  }
+
+  if (Z_TYPE_P(executions) != IS_LONG ||
+      Z_LVAL_P(executions) < 0 || Z_LVAL_P(executions) > INT_MAX) {
+    INVALID_ARGUMENT(executions, "a number of executions (or 0 to disable)");
+  }
+
+  if (Z_TYPE_P(delay) == IS_LONG) {
+    self->speculative_execution_delay = Z_LVAL_P(delay) * 1000;
+  } else {
+    self->speculative_execution_delay = ceil(Z_DVAL_P(delay) * 1000);
+  }
+  self->speculative_executions = Z_LVAL_P(executions);
+
+  RETURN_ZVAL(getThis(), 1, 0);
+}
+
+PHP_METHOD(ClusterBuilder, withExecutionProfile)
+{
+  zend_string *name = NULL;
+  zval *options = NULL;
+  zval profile;
+  php_driver_execution_options *opts;
+  php_driver_cluster_builder *self;
+
+  if (zend_parse_parameters(ZEND_NUM_ARGS(), "Sz", &name, &options) == FAILURE) {
+    return;
+  }
+
+  self = PHP_DRIVER_GET_CLUSTER_BUILDER(getThis());
+
+  if (ZSTR_LEN(name) == 0) {
+    zend_throw_exception_ex(php_driver_invalid_argument_exception_ce, 0,
+                            "The name of an execution profile can't be empty");
+    return;
+  }
+
+  if (Z_TYPE_P(options) == IS_OBJECT &&
+      instanceof_function(Z_OBJCE_P(options), php_driver_execution_options_ce)) {
+    ZVAL_COPY(&profile, options);
+  } else if (Z_TYPE_P(options) == IS_ARRAY) {
+    object_init_ex(&profile, php_driver_execution_options_ce);
+    if (php_driver_execution_options_build_from_array(PHP_DRIVER_GET_EXECUTION_OPTIONS(&profile),
+                                                      options) == FAILURE) {
+      zval_ptr_dtor(&profile);
+      return;
+    }
+  } else {
+    INVALID_ARGUMENT(options, "an instance of " PHP_DRIVER_NAMESPACE "\\ExecutionOptions or an array");
+  }
+
+  opts = PHP_DRIVER_GET_EXECUTION_OPTIONS(&profile);
+  if (!Z_ISUNDEF(opts->execution_profile)) {
+    zval_ptr_dtor(&profile);
+    zend_throw_exception_ex(php_driver_invalid_argument_exception_ce, 0,
+                            "An execution profile can't refer to another one");
+    return;
+  }
+
+  /* Bind values and paging state belong to a single request */
+  if (!Z_ISUNDEF(opts->arguments) || opts->paging_state_token) {
+    zval_ptr_dtor(&profile);
+    zend_throw_exception_ex(php_driver_invalid_argument_exception_ce, 0,
+                            "An execution profile can't set %s",
+                            Z_ISUNDEF(opts->arguments) ? "paging_state_token" : "arguments");
+    return;
+  }
+
+  if (Z_ISUNDEF(self->execution_profiles))
+    array_init(&(self->execution_profiles));
+
+  zend_hash_update(Z_ARRVAL(self->execution_profiles), name, &profile);
+
+  RETURN_ZVAL(getThis(), 1, 0);
+}
+
+PHP_METHOD(ClusterBuilder, withMaxInFlightRequests)
+{
+  zval *max = NULL;
+  zval *policy = NULL;
+  zval *timeout = NULL;
+  cass_duration_t timeout_us = 0;
+  php_driver_cluster_builder *self;
+
+  if (zend_parse_parameters(ZEND_NUM_ARGS(), "z|zz", &max, &policy, &timeout) == FAILURE) {
+    return;
+  }
+
+  self = PHP_DRIVER_GET_CLUSTER_BUILDER(getThis());
+
+  if (Z_TYPE_P(max) != IS_NULL &&
+      (Z_TYPE_P(max) != IS_LONG || Z_LVAL_P(max) < 1 || Z_LVAL_P(max) > UINT_MAX)) {
+    INVALID_ARGUMENT(max, "a number of requests greater than zero or null");
+  }
+
+  if (policy && Z_TYPE_P(policy) != IS_NULL &&
+      (Z_TYPE_P(policy) != IS_LONG ||
+       (Z_LVAL_P(policy) != PHP_DRIVER_THROTTLE_BLOCK &&
+        Z_LVAL_P(policy) != PHP_DRIVER_THROTTLE_FAIL_FAST &&
+        Z_LVAL_P(policy) != PHP_DRIVER_THROTTLE_WAIT))) {
+    INVALID_ARGUMENT(policy, "one of " PHP_DRIVER_NAMESPACE "::THROTTLE_BLOCK, " \
+                             PHP_DRIVER_NAMESPACE "::THROTTLE_FAIL_FAST or " \
+                             PHP_DRIVER_NAMESPACE "::THROTTLE_WAIT");
+  }
+
+  if (policy && Z_TYPE_P(policy) == IS_LONG &&
+      Z_LVAL_P(policy) == PHP_DRIVER_THROTTLE_WAIT) {
+    if (php_driver_future_get_timeout(timeout, &timeout_us) == FAILURE)
+      return;
+
+    if (timeout_us == 0) {
+      zend_throw_exception_ex(php_driver_invalid_argument_exception_ce, 0,
+                              "A timeout is required to wait for requests in flight");
+      return;
+    }
+  }
+
+  self->max_in_flight_requests = Z_TYPE_P(max) == IS_NULL ? 0 : Z_LVAL_P(max);
+  self->in_flight_policy       = PHP_DRIVER_THROTTLE_BLOCK;
+  self->in_flight_timeout      = timeout_us;
+
+  if (policy && Z_TYPE_P(policy) == IS_LONG)
+    self->in_flight_policy = Z_LVAL_P(policy);
+
+  RETURN_ZVAL(getThis(), 1, 0);
+}
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_none, 0, ZEND_RETURN_VALUE, 0)
 ZEND_END_ARG_INFO()
 
@@ -946,6 +1292,10 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_enabled, 0, ZEND_RETURN_VALUE, 0)
   ZEND_ARG_INFO(0, enabled)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_latency_settings, 0, ZEND_RETURN_VALUE, 1)
+  ZEND_ARG_ARRAY_INFO(0, settings, 0)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_credentials, 0, ZEND_RETURN_VALUE, 2)
   ZEND_ARG_INFO(0, username)
   ZEND_ARG_INFO(0, password)
@@ -988,6 +1338,22 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_timestamp_gen, 0, ZEND_RETURN_VALUE, 1)
   PHP_DRIVER_NAMESPACE_ZEND_ARG_OBJ_INFO(0, generator, TimestampGenerator, 0)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_speculative_execution, 0, ZEND_RETURN_VALUE, 2)
+  ZEND_ARG_INFO(0, delay)
+  ZEND_ARG_INFO(0, maxExecutions)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_execution_profile, 0, ZEND_RETURN_VALUE, 2)
+  ZEND_ARG_INFO(0, name)
+  ZEND_ARG_INFO(0, options)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_max_in_flight, 0, ZEND_RETURN_VALUE, 1)
+  ZEND_ARG_INFO(0, maxRequests)
+  ZEND_ARG_INFO(0, policy)
+  ZEND_ARG_INFO(0, timeout)
+ZEND_END_ARG_INFO()
+
 static zend_function_entry php_driver_cluster_builder_methods[] = {
   PHP_ME(ClusterBuilder, build, arginfo_none, ZEND_ACC_PUBLIC)
   PHP_ME(ClusterBuilder, withDefaultConsistency, arginfo_consistency, ZEND_ACC_PUBLIC)
@@ -1012,6 +1378,7 @@ static zend_function_entry php_driver_cluster_builder_methods[] = {
   PHP_ME(ClusterBuilder, withConnectionsPerHost, arginfo_connections, ZEND_ACC_PUBLIC)
   PHP_ME(ClusterBuilder, withReconnectInterval, arginfo_interval, ZEND_ACC_PUBLIC)
   PHP_ME(ClusterBuilder, withLatencyAwareRouting, arginfo_enabled, ZEND_ACC_PUBLIC)
+  PHP_ME(ClusterBuilder, withLatencyAwareRoutingSettings, arginfo_latency_settings, ZEND_ACC_PUBLIC)
   PHP_ME(ClusterBuilder, withTCPNodelay, arginfo_enabled, ZEND_ACC_PUBLIC)
   PHP_ME(ClusterBuilder, withTCPKeepalive, arginfo_delay, ZEND_ACC_PUBLIC)
   PHP_ME(ClusterBuilder, withRetryPolicy, arginfo_retry_policy, ZEND_ACC_PUBLIC)
@@ -1020,6 +1387,9 @@ static zend_function_entry php_driver_cluster_builder_methods[] = {
   PHP_ME(ClusterBuilder, withHostnameResolution, arginfo_enabled, ZEND_ACC_PUBLIC)
   PHP_ME(ClusterBuilder, withRandomizedContactPoints, arginfo_enabled, ZEND_ACC_PUBLIC)
   PHP_ME(ClusterBuilder, withConnectionHeartbeatInterval, arginfo_interval, ZEND_ACC_PUBLIC)
+  PHP_ME(ClusterBuilder, withMaxInFlightRequests, arginfo_max_in_flight, ZEND_ACC_PUBLIC)
+  PHP_ME(ClusterBuilder, withConstantSpeculativeExecutionPolicy, arginfo_speculative_execution, ZEND_ACC_PUBLIC)
+  PHP_ME(ClusterBuilder, withExecutionProfile, arginfo_execution_profile, ZEND_ACC_PUBLIC)
   PHP_FE_END
 };
 
@@ -1057,6 +1427,7 @@ php_driver_cluster_builder_properties(CASS_COMPAT_OBJECT_HANDLER_TYPE *object)
   zval maxConnectionsPerHost;
   zval reconnectInterval;
   zval latencyAwareRouting;
+  zval latencyAwareRoutingSettings;
   zval tcpNodelay;
   zval tcpKeepalive;
   zval retryPolicy;
@@ -1069,6 +1440,9 @@ php_driver_cluster_builder_properties(CASS_COMPAT_OBJECT_HANDLER_TYPE *object)
   zval hostnameResolution;
   zval randomizedContactPoints;
   zval connectionHeartbeatInterval;
+  zval maxInFlightRequests;
+  zval speculativeExecutionPolicy;
+  zval executionProfiles;
 
   php_driver_cluster_builder *self = CASS_COMPAT_GET_CLUSTER_BUILDER(object);
   HashTable *props = zend_std_get_properties(object);
@@ -1150,6 +1524,23 @@ php_driver_cluster_builder_properties(CASS_COMPAT_OBJECT_HANDLER_TYPE *object)
   ZVAL_BOOL(&(latencyAwareRouting), self->enable_latency_aware_routing);
 
 
+  if (self->latency_aware_routing_settings) {
+    array_init(&(latencyAwareRoutingSettings));
+    add_assoc_double(&(latencyAwareRoutingSettings), "exclusion_threshold",
+                     self->latency_exclusion_threshold);
+    add_assoc_double(&(latencyAwareRoutingSettings), "scale",
+                     (double) self->latency_scale / 1000);
+    add_assoc_double(&(latencyAwareRoutingSettings), "retry_period",
+                     (double) self->latency_retry_period / 1000);
+    add_assoc_double(&(latencyAwareRoutingSettings), "update_rate",
+                     (double) self->latency_update_rate / 1000);
+    add_assoc_long(&(latencyAwareRoutingSettings), "min_measured",
+                   (zend_long) self->latency_min_measured);
+  } else {
+    ZVAL_NULL(&(latencyAwareRoutingSettings));
+  }
+
+
   ZVAL_BOOL(&(tcpNodelay), self->enable_tcp_nodelay);
 
 
@@ -1213,6 +1604,31 @@ php_driver_cluster_builder_properties(CASS_COMPAT_OBJECT_HANDLER_TYPE *object)
 
   ZVAL_LONG(&(connectionHeartbeatInterval), self->connection_heartbeat_interval);
 
+
+  if (self->max_in_flight_requests > 0) {
+    ZVAL_LONG(&(maxInFlightRequests), self->max_in_flight_requests);
+  } else {
+    ZVAL_NULL(&(maxInFlightRequests));
+  }
+
+
+  if (self->speculative_executions > 0) {
+    array_init(&(speculativeExecutionPolicy));
+    add_assoc_double(&(speculativeExecutionPolicy), "delay",
+                     (double) self->speculative_execution_delay / 1000);
+    add_assoc_long(&(speculativeExecutionPolicy), "maxExecutions",
+                   self->speculative_executions);
+  } else {
+    ZVAL_NULL(&(speculativeExecutionPolicy));
+  }
+
+
+  if (!Z_ISUNDEF(self->execution_profiles)) {
+    ZVAL_COPY(&(executionProfiles), &(self->execution_profiles));
+  } else {
+    array_init(&(executionProfiles));
+  }
+
   zend_hash_str_update(props, "contactPoints", strlen("contactPoints"), &(contactPoints));
   zend_hash_str_update(props, "loadBalancingPolicy", strlen("loadBalancingPolicy"), &(loadBalancingPolicy));
   zend_hash_str_update(props, "localDatacenter", strlen("localDatacenter"), &(localDatacenter));
@@ -1234,6 +1650,7 @@ php_driver_cluster_builder_properties(CASS_COMPAT_OBJECT_HANDLER_TYPE *object)
   zend_hash_str_update(props, "maxConnectionsPerHost", strlen("maxConnectionsPerHost"), &(maxConnectionsPerHost));
   zend_hash_str_update(props, "reconnectInterval", strlen("reconnectInterval"), &(reconnectInterval));
   zend_hash_str_update(props, "latencyAwareRouting", strlen("latencyAwareRouting"), &(latencyAwareRouting));
+  zend_hash_str_update(props, "latencyAwareRoutingSettings", strlen("latencyAwareRoutingSettings"), &(latencyAwareRoutingSettings));
   zend_hash_str_update(props, "tcpNodelay", strlen("tcpNodelay"), &(tcpNodelay));
   zend_hash_str_update(props, "tcpKeepalive", strlen("tcpKeepalive"), &(tcpKeepalive));
   zend_hash_str_update(props, "retryPolicy", strlen("retryPolicy"), &(retryPolicy));
@@ -1246,6 +1663,9 @@ php_driver_cluster_builder_properties(CASS_COMPAT_OBJECT_HANDLER_TYPE *object)
   zend_hash_str_update(props, "hostnameResolution", strlen("hostnameResolution"), &(hostnameResolution));
   zend_hash_str_update(props, "randomizedContactPoints", strlen("randomizedContactPoints"), &(randomizedContactPoints));
   zend_hash_str_update(props, "connectionHeartbeatInterval", strlen("connectionHeartbeatInterval"), &(connectionHeartbeatInterval));
+  zend_hash_str_update(props, "maxInFlightRequests", strlen("maxInFlightRequests"), &(maxInFlightRequests));
+  zend_hash_str_update(props, "speculativeExecutionPolicy", strlen("speculativeExecutionPolicy"), &(speculativeExecutionPolicy));
+  zend_hash_str_update(props, "executionProfiles", strlen("executionProfiles"), &(executionProfiles));
 
   return props;
 }
@@ -1306,6 +1726,7 @@ php_driver_cluster_builder_free(zend_object *object)
   CASS_ZVAL_MAYBE_DESTROY(self->default_timeout);
   CASS_ZVAL_MAYBE_DESTROY(self->retry_policy);
   CASS_ZVAL_MAYBE_DESTROY(self->timestamp_gen);
+  CASS_ZVAL_MAYBE_DESTROY(self->execution_profiles);
 
   zend_object_std_dtor(&self->zval);
 }
@@ -1336,6 +1757,12 @@ php_driver_cluster_builder_new(zend_class_entry *ce)
   self->max_connections_per_host = 2;
   self->reconnect_interval = 2000;
   self->enable_latency_aware_routing = 1;
+  self->latency_aware_routing_settings = 0;
+  self->latency_exclusion_threshold = 2.0;
+  self->latency_scale = 100;
+  self->latency_retry_period = 10000;
+  self->latency_update_rate = 100;
+  self->latency_min_measured = 50;
   self->enable_tcp_nodelay = 1;
   self->enable_tcp_keepalive = 0;
   self->tcp_keepalive_delay = 0;
@@ -1347,11 +1774,17 @@ php_driver_cluster_builder_new(zend_class_entry *ce)
   self->enable_hostname_resolution = 0;
   self->enable_randomized_contact_points = 1;
   self->connection_heartbeat_interval = 30;
+  self->max_in_flight_requests = 0;
+  self->in_flight_policy = PHP_DRIVER_THROTTLE_BLOCK;
+  self->in_flight_timeout = 0;
+  self->speculative_execution_delay = 0;
+  self->speculative_executions = 0;
 
   ZVAL_UNDEF(&(self->ssl_options));
   ZVAL_UNDEF(&(self->default_timeout));
   ZVAL_UNDEF(&(self->retry_policy));
   ZVAL_UNDEF(&(self->timestamp_gen));
+  ZVAL_UNDEF(&(self->execution_profiles));
 
   CASS_ZEND_OBJECT_INIT(cluster_builder, self, ce);
 }
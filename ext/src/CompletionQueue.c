@@ -0,0 +1,214 @@
+/**
+ * Copyright 2015-2017 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "php_driver.h"
+#include "php_driver_types.h"
+#include "util/future.h"
+
+zend_class_entry *php_driver_completion_queue_ce = NULL;
+
+PHP_METHOD(CompletionQueue, __construct)
+{
+  if (zend_parse_parameters_none() == FAILURE)
+    return;
+}
+
+PHP_METHOD(CompletionQueue, add)
+{
+  zval *future = NULL;
+  php_driver_completion_queue *self = NULL;
+  CassFuture *handle = NULL;
+  zend_ulong key;
+
+  if (zend_parse_parameters(ZEND_NUM_ARGS(), "O", &future, php_driver_future_ce) == FAILURE)
+    return;
+
+  self = PHP_DRIVER_GET_COMPLETION_QUEUE(getThis());
+
+  if (php_driver_future_get_handle(future, &handle) == FAILURE) {
+    INVALID_ARGUMENT(future, "an instance of " PHP_DRIVER_NAMESPACE "\\FutureRows, " \
+                             PHP_DRIVER_NAMESPACE "\\FuturePreparedStatement, " \
+                             PHP_DRIVER_NAMESPACE "\\FutureSession, " \
+                             PHP_DRIVER_NAMESPACE "\\FutureClose or " \
+                             PHP_DRIVER_NAMESPACE "\\FutureValue");
+  }
+
+  /* Futures that have no pending request are reported by the next drain() */
+  if (!handle) {
+    Z_TRY_ADDREF_P(future);
+    add_next_index_zval(&self->resolved, future);
+    php_driver_future_queue_wake(self->queue);
+    return;
+  }
+
+  key = (zend_ulong) (uintptr_t) handle;
+  if (zend_hash_index_exists(&self->futures, key))
+    return;
+
+  if (php_driver_future_queue_add(self->queue, handle) == FAILURE)
+    return;
+
+  Z_TRY_ADDREF_P(future);
+  zend_hash_index_update(&self->futures, key, future);
+}
+
+PHP_METHOD(CompletionQueue, stream)
+{
+  php_driver_completion_queue *self = NULL;
+  php_stream *stream;
+  int fd;
+
+  if (zend_parse_parameters_none() == FAILURE)
+    return;
+
+  self = PHP_DRIVER_GET_COMPLETION_QUEUE(getThis());
+
+  if (Z_TYPE(self->stream) == IS_RESOURCE &&
+      Z_RES_TYPE(self->stream) == php_file_le_stream()) {
+    RETURN_ZVAL(&self->stream, 1, 0);
+  }
+
+  fd = php_driver_future_queue_fd(self->queue);
+  if (fd < 0) {
+    zend_throw_exception_ex(php_driver_runtime_exception_ce, 0,
+                            "Completion streams are not supported on this platform");
+    return;
+  }
+
+  stream = php_stream_fopen_from_fd(fd, "r", NULL);
+  if (!stream) {
+    close(fd);
+    zend_throw_exception_ex(php_driver_runtime_exception_ce, 0,
+                            "Unable to open the completion stream");
+    return;
+  }
+
+  zval_ptr_dtor(&self->stream);
+  php_stream_to_zval(stream, &self->stream);
+  RETURN_ZVAL(&self->stream, 1, 0);
+}
+
+PHP_METHOD(CompletionQueue, drain)
+{
+  php_driver_completion_queue *self = NULL;
+  CassFuture *handle;
+  zval *future;
+
+  if (zend_parse_parameters_none() == FAILURE)
+    return;
+
+  self = PHP_DRIVER_GET_COMPLETION_QUEUE(getThis());
+
+  RETVAL_ZVAL(&self->resolved, 0, 0);
+  array_init(&self->resolved);
+
+  while ((handle = php_driver_future_queue_poll(self->queue)) != NULL) {
+    zend_ulong key = (zend_ulong) (uintptr_t) handle;
+
+    future = zend_hash_index_find(&self->futures, key);
+    if (future) {
+      Z_TRY_ADDREF_P(future);
+      add_next_index_zval(return_value, future);
+      zend_hash_index_del(&self->futures, key);
+    }
+  }
+}
+
+PHP_METHOD(CompletionQueue, count)
+{
+  php_driver_completion_queue *self = NULL;
+
+  if (zend_parse_parameters_none() == FAILURE)
+    return;
+
+  self = PHP_DRIVER_GET_COMPLETION_QUEUE(getThis());
+
+  RETURN_LONG(zend_hash_num_elements(&self->futures) +
+              zend_hash_num_elements(Z_ARRVAL(self->resolved)));
+}
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_none, 0, ZEND_RETURN_VALUE, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_add, 0, ZEND_RETURN_VALUE, 1)
+  PHP_DRIVER_NAMESPACE_ZEND_ARG_OBJ_INFO(0, future, Future, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_count, ZEND_RETURN_VALUE, 0, IS_LONG, 0)
+ZEND_END_ARG_INFO()
+
+static zend_function_entry php_driver_completion_queue_methods[] = {
+  PHP_ME(CompletionQueue, __construct, arginfo_none,  ZEND_ACC_PUBLIC | ZEND_ACC_CTOR)
+  PHP_ME(CompletionQueue, add,         arginfo_add,   ZEND_ACC_PUBLIC)
+  PHP_ME(CompletionQueue, stream,      arginfo_none,  ZEND_ACC_PUBLIC)
+  PHP_ME(CompletionQueue, drain,       arginfo_none,  ZEND_ACC_PUBLIC)
+  PHP_ME(CompletionQueue, count,       arginfo_count, ZEND_ACC_PUBLIC)
+  PHP_FE_END
+};
+
+static zend_object_handlers php_driver_completion_queue_handlers;
+
+static int
+php_driver_completion_queue_compare(zval *obj1, zval *obj2)
+{
+  ZEND_COMPARE_OBJECTS_FALLBACK(obj1, obj2);
+
+  return Z_OBJ_HANDLE_P(obj1) != Z_OBJ_HANDLE_P(obj1);
+}
+
+static void
+php_driver_completion_queue_free(zend_object *object)
+{
+  php_driver_completion_queue *self =
+      php_driver_completion_queue_object_fetch(object);
+
+  /* Futures still pending keep the queue alive until their callbacks run */
+  php_driver_future_queue_free(self->queue);
+  zend_hash_destroy(&self->futures);
+  zval_ptr_dtor(&self->resolved);
+  zval_ptr_dtor(&self->stream);
+
+  zend_object_std_dtor(&self->zval);
+}
+
+static zend_object *
+php_driver_completion_queue_new(zend_class_entry *ce)
+{
+  php_driver_completion_queue *self =
+      CASS_ZEND_OBJECT_ECALLOC(completion_queue, ce);
+
+  self->queue = php_driver_future_queue_new(16);
+  zend_hash_init(&self->futures, 0, NULL, ZVAL_PTR_DTOR, 0);
+  array_init(&self->resolved);
+  ZVAL_UNDEF(&self->stream);
+
+  CASS_ZEND_OBJECT_INIT(completion_queue, self, ce);
+}
+
+void php_driver_define_CompletionQueue()
+{
+  zend_class_entry ce;
+
+  INIT_CLASS_ENTRY(ce, PHP_DRIVER_NAMESPACE "\\CompletionQueue", php_driver_completion_queue_methods);
+  php_driver_completion_queue_ce = zend_register_internal_class(&ce);
+  zend_class_implements(php_driver_completion_queue_ce, 1, zend_ce_countable);
+  php_driver_completion_queue_ce->ce_flags     |= ZEND_ACC_FINAL;
+  php_driver_completion_queue_ce->create_object = php_driver_completion_queue_new;
+
+  memcpy(&php_driver_completion_queue_handlers, zend_get_std_object_handlers(), sizeof(zend_object_handlers));
+  CASS_COMPAT_SET_COMPARE_HANDLER(php_driver_completion_queue_handlers, php_driver_completion_queue_compare);
+  php_driver_completion_queue_handlers.clone_obj = NULL;
+}
@@ -16,6 +16,7 @@
 
 #include "php_driver.h"
 #include "php_driver_types.h"
+#include "util/throttle.h"
 
 zend_class_entry *php_driver_core_ce = NULL;
 
@@ -67,6 +68,10 @@ void php_driver_define_Core()
   zend_declare_class_constant_long(php_driver_core_ce, ZEND_STRL("BATCH_UNLOGGED"), CASS_BATCH_TYPE_UNLOGGED);
   zend_declare_class_constant_long(php_driver_core_ce, ZEND_STRL("BATCH_COUNTER"),  CASS_BATCH_TYPE_COUNTER);
 
+  zend_declare_class_constant_long(php_driver_core_ce, ZEND_STRL("THROTTLE_BLOCK"),     PHP_DRIVER_THROTTLE_BLOCK);
+  zend_declare_class_constant_long(php_driver_core_ce, ZEND_STRL("THROTTLE_FAIL_FAST"), PHP_DRIVER_THROTTLE_FAIL_FAST);
+  zend_declare_class_constant_long(php_driver_core_ce, ZEND_STRL("THROTTLE_WAIT"),      PHP_DRIVER_THROTTLE_WAIT);
+
   zend_declare_class_constant_long(php_driver_core_ce, ZEND_STRL("LOG_DISABLED"), CASS_LOG_DISABLED);
   zend_declare_class_constant_long(php_driver_core_ce, ZEND_STRL("LOG_CRITICAL"), CASS_LOG_CRITICAL);
   zend_declare_class_constant_long(php_driver_core_ce, ZEND_STRL("LOG_ERROR"),    CASS_LOG_ERROR);
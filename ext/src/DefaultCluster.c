@@ -18,7 +18,9 @@
 #include "php_driver_globals.h"
 #include "php_driver_types.h"
 #include "util/future.h"
+#include "util/prepared_cache.h"
 #include "util/ref.h"
+#include "util/throttle.h"
 
 zend_class_entry *php_driver_default_cluster_ce = NULL;
 
@@ -54,7 +56,18 @@ PHP_METHOD(DefaultCluster, connect)
   session->default_page_size   = self->default_page_size;
   session->persist             = self->persist;
 
-  if (!Z_ISUNDEF(session->default_timeout)) {
+  if (!Z_ISUNDEF(self->execution_profiles))
+    ZVAL_COPY(&(session->execution_profiles), &(self->execution_profiles));
+
+  if (keyspace)
+    session->keyspace = zend_string_init(keyspace, keyspace_len, 0);
+
+  if (self->max_in_flight_requests > 0)
+    session->throttle = php_driver_throttle_new(self->max_in_flight_requests,
+                                                self->in_flight_policy,
+                                                self->in_flight_timeout);
+
+  if (!Z_ISUNDEF(self->default_timeout)) {
     ZVAL_COPY(&(session->default_timeout),
                       &(self->default_timeout));
   }
@@ -69,6 +82,7 @@ PHP_METHOD(DefaultCluster, connect)
         Z_RES_P(le)->type == php_le_php_driver_session()) {
       psession = (php_driver_psession *) Z_RES_P(le)->ptr;
       session->session = php_driver_add_ref(psession->session);
+      session->prepared_cache = php_driver_add_ref(psession->prepared_cache);
       future = psession->future;
     }
   }
@@ -91,6 +105,8 @@ PHP_METHOD(DefaultCluster, connect)
       psession = (php_driver_psession *) pecalloc(1, sizeof(php_driver_psession), 1);
       psession->session = php_driver_add_ref(session->session);
       psession->future  = future;
+      psession->prepared_cache = php_driver_prepared_cache_new(keyspace);
+      session->prepared_cache  = php_driver_add_ref(psession->prepared_cache);
 
       ZVAL_NEW_PERSISTENT_RES(&resource, 0, psession, php_le_php_driver_session());
       zend_hash_str_update(&EG(persistent_list), hash_key, hash_key_len, &resource);
@@ -143,6 +159,17 @@ PHP_METHOD(DefaultCluster, connectAsync)
 
   future->persist = self->persist;
 
+  if (!Z_ISUNDEF(self->execution_profiles))
+    ZVAL_COPY(&(future->execution_profiles), &(self->execution_profiles));
+
+  if (keyspace)
+    future->keyspace = zend_string_init(keyspace, keyspace_len, 0);
+
+  if (self->max_in_flight_requests > 0)
+    future->throttle = php_driver_throttle_new(self->max_in_flight_requests,
+                                               self->in_flight_policy,
+                                               self->in_flight_timeout);
+
   if (self->persist) {
     zval *le;
 
@@ -157,6 +184,7 @@ PHP_METHOD(DefaultCluster, connectAsync)
       php_driver_psession *psession = (php_driver_psession *) Z_RES_P(le)->ptr;
       future->session = php_driver_add_ref(psession->session);
       future->future  = psession->future;
+      future->prepared_cache = php_driver_add_ref(psession->prepared_cache);
       return;
     }
   }
@@ -178,6 +206,8 @@ PHP_METHOD(DefaultCluster, connectAsync)
       (php_driver_psession *) pecalloc(1, sizeof(php_driver_psession), 1);
     psession->session = php_driver_add_ref(future->session);
     psession->future  = future->future;
+    psession->prepared_cache = php_driver_prepared_cache_new(keyspace);
+    future->prepared_cache   = php_driver_add_ref(psession->prepared_cache);
 
     ZVAL_NEW_PERSISTENT_RES(&resource, 0, psession, php_le_php_driver_session());
     zend_hash_str_update(&EG(persistent_list), hash_key, hash_key_len, &resource);
@@ -225,6 +255,7 @@ php_driver_default_cluster_free(zend_object *object)
   }
 
   CASS_ZVAL_MAYBE_DESTROY(self->default_timeout);
+  CASS_ZVAL_MAYBE_DESTROY(self->execution_profiles);
 
   zend_object_std_dtor(&self->zval);
 
@@ -243,6 +274,7 @@ php_driver_default_cluster_new(zend_class_entry *ce)
   self->hash_key            = NULL;
 
   ZVAL_UNDEF(&(self->default_timeout));
+  ZVAL_UNDEF(&(self->execution_profiles));
 
   CASS_ZEND_OBJECT_INIT_EX(cluster, default_cluster, self, ce);
 }
@@ -15,23 +15,27 @@
  */
 
 #include "php_driver.h"
+#include "php_driver_globals.h"
 #include "php_driver_types.h"
+#include "util/batch.h"
+#include "util/bind.h"
 #include "util/bytes.h"
+#include "util/callback.h"
+#include "util/cql.h"
+#include "util/detached.h"
 #include "util/future.h"
+#include "util/prepared_cache.h"
 #include "util/result.h"
 #include "util/ref.h"
-#include "util/math.h"
-#include "util/collections.h"
+#include "util/throttle.h"
+#include "BoundStatement.h"
+#include "DefaultSession.h"
 #include "ExecutionOptions.h"
+#include "PreparedStatement.h"
+#include "Rows.h"
 
 zend_class_entry *php_driver_default_session_ce = NULL;
 
-#define CHECK_RESULT(rc) \
-{ \
-  ASSERT_SUCCESS_VALUE(rc, FAILURE) \
-  return SUCCESS; \
-}
-
 static void
 free_result(void *result)
 {
@@ -50,754 +54,1709 @@ free_schema(void *schema)
   cass_schema_meta_free((CassSchemaMeta *) schema);
 }
 
-static int
-bind_argument_by_index(CassStatement *statement, size_t index, zval *value)
+static CassStatement *
+create_statement(php_driver_statement *statement, HashTable *arguments)
 {
-  if (Z_TYPE_P(value) == IS_NULL)
-    CHECK_RESULT(cass_statement_bind_null(statement, index));
-
-  if (Z_TYPE_P(value) == IS_STRING)
-    CHECK_RESULT(cass_statement_bind_string(statement, index, Z_STRVAL_P(value)));
+  CassStatement *stmt;
+  uint32_t count;
 
-  if (Z_TYPE_P(value) == IS_DOUBLE)
-    CHECK_RESULT(cass_statement_bind_double(statement, index, Z_DVAL_P(value)));
+  switch (statement->type) {
+  case PHP_DRIVER_SIMPLE_STATEMENT:
+    count  = 0;
 
-  if (Z_TYPE_P(value) == IS_LONG)
-    CHECK_RESULT(cass_statement_bind_int32(statement, index, Z_LVAL_P(value)));
+    if (arguments)
+      count = zend_hash_num_elements(arguments);
 
-  if (Z_TYPE_P(value) == IS_TRUE)
-    CHECK_RESULT(cass_statement_bind_bool(statement, index, cass_true));
+    stmt = cass_statement_new(statement->data.simple.cql, count);
+    break;
+  case PHP_DRIVER_PREPARED_STATEMENT:
+    stmt = cass_prepared_bind(statement->data.prepared.prepared);
+    break;
+  default:
+    zend_throw_exception_ex(php_driver_runtime_exception_ce, 0,
+      "Unsupported statement type.");
+    return NULL;
+  }
 
-  if (Z_TYPE_P(value) == IS_FALSE)
-    CHECK_RESULT(cass_statement_bind_bool(statement, index, cass_false));
+  if (arguments && php_driver_bind_arguments(stmt, statement, arguments) == FAILURE) {
+    cass_statement_free(stmt);
+    return NULL;
+  }
 
-  if (Z_TYPE_P(value) == IS_OBJECT) {
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_float_ce)) {
-      php_driver_numeric *float_number = PHP_DRIVER_GET_NUMERIC(value);
-      CHECK_RESULT(cass_statement_bind_float(statement, index, float_number->data.floating.value));
-    }
+  return stmt;
+}
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_bigint_ce)) {
-      php_driver_numeric *bigint = PHP_DRIVER_GET_NUMERIC(value);
-      CHECK_RESULT(cass_statement_bind_int64(statement, index, bigint->data.bigint.value));
-    }
+static CassBatch *
+create_batch(php_driver_statement *batch,
+             HashTable *entries,
+             CassConsistency consistency,
+             CassRetryPolicy *retry_policy,
+             cass_int64_t timestamp,
+             cass_uint64_t request_timeout,
+             cass_bool_t is_idempotent,
+             const char *execution_profile)
+{
+  CassBatch *cass_batch = cass_batch_new(batch->data.batch.type);
+  CassError rc = CASS_OK;
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_smallint_ce)) {
-      php_driver_numeric *smallint = PHP_DRIVER_GET_NUMERIC(value);
-      CHECK_RESULT(cass_statement_bind_int16(statement, index, smallint->data.smallint.value));
-    }
+  zval *current;
+  ZEND_HASH_FOREACH_VAL(entries, current) {
+    php_driver_statement *statement;
+    php_driver_statement simple_statement;
+    HashTable *arguments;
+    CassStatement *stmt;
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_tinyint_ce)) {
-      php_driver_numeric *tinyint = PHP_DRIVER_GET_NUMERIC(value);
-      CHECK_RESULT(cass_statement_bind_int8(statement, index, tinyint->data.tinyint.value));
-    }
+    php_driver_batch_statement_entry *batch_statement_entry = (php_driver_batch_statement_entry *)Z_PTR_P(current);
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_timestamp_ce)) {
-      php_driver_timestamp *timestamp = PHP_DRIVER_GET_TIMESTAMP(value);
-      CHECK_RESULT(cass_statement_bind_int64(statement, index, timestamp->timestamp));
+    if (Z_TYPE(batch_statement_entry->statement) == IS_STRING) {
+      simple_statement.type = PHP_DRIVER_SIMPLE_STATEMENT;
+      simple_statement.data.simple.cql = Z_STRVAL(batch_statement_entry->statement);
+      statement = &simple_statement;
+    } else {
+      statement = PHP_DRIVER_GET_STATEMENT(&(batch_statement_entry->statement));
     }
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_date_ce)) {
-      php_driver_date *date = PHP_DRIVER_GET_DATE(value);
-      CHECK_RESULT(cass_statement_bind_uint32(statement, index, date->date));
-    }
+    arguments = !Z_ISUNDEF(batch_statement_entry->arguments)
+                ? Z_ARRVAL_P(&(batch_statement_entry->arguments))
+                : NULL;
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_time_ce)) {
-      php_driver_time *time = PHP_DRIVER_GET_TIME(value);
-      CHECK_RESULT(cass_statement_bind_int64(statement, index, time->time));
+    stmt = create_statement(statement, arguments);
+    if (!stmt) {
+      cass_batch_free(cass_batch);
+      return NULL;
     }
+    cass_batch_add_statement(cass_batch, stmt);
+    cass_statement_free(stmt);
+  } ZEND_HASH_FOREACH_END();
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_blob_ce)) {
-      php_driver_blob *blob = PHP_DRIVER_GET_BLOB(value);
-      CHECK_RESULT(cass_statement_bind_bytes(statement, index, blob->data, blob->size));
-    }
+  rc = cass_batch_set_consistency(cass_batch, consistency);
+  ASSERT_SUCCESS_BLOCK(rc,
+    cass_batch_free(cass_batch);
+    return NULL;
+  )
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_varint_ce)) {
-      php_driver_numeric *varint = PHP_DRIVER_GET_NUMERIC(value);
-      size_t size;
-      cass_byte_t *data = export_twos_complement(varint->data.varint.value, &size);
-      CassError rc = cass_statement_bind_bytes(statement, index, data, size);
-      free(data);
-      CHECK_RESULT(rc);
-    }
+  rc = cass_batch_set_retry_policy(cass_batch, retry_policy);
+  ASSERT_SUCCESS_BLOCK(rc,
+    cass_batch_free(cass_batch);
+    return NULL;
+  )
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_decimal_ce)) {
-      php_driver_numeric *decimal = PHP_DRIVER_GET_NUMERIC(value);
-      size_t size;
-      cass_byte_t *data = (cass_byte_t *) export_twos_complement(decimal->data.decimal.value, &size);
-      CassError rc = cass_statement_bind_decimal(statement, index, data, size, decimal->data.decimal.scale);
-      free(data);
-      CHECK_RESULT(rc);
-    }
+  rc = cass_batch_set_timestamp(cass_batch, timestamp);
+  ASSERT_SUCCESS_BLOCK(rc,
+    cass_batch_free(cass_batch);
+    return NULL;
+  )
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_uuid_interface_ce)) {
-      php_driver_uuid *uuid = PHP_DRIVER_GET_UUID(value);
-      CHECK_RESULT(cass_statement_bind_uuid(statement, index, uuid->uuid));
-    }
+  rc = cass_batch_set_request_timeout(cass_batch, request_timeout);
+  ASSERT_SUCCESS_BLOCK(rc,
+    cass_batch_free(cass_batch);
+    return NULL;
+  )
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_inet_ce)) {
-      php_driver_inet *inet = PHP_DRIVER_GET_INET(value);
-      CHECK_RESULT(cass_statement_bind_inet(statement, index, inet->inet));
-    }
+  rc = cass_batch_set_is_idempotent(cass_batch, is_idempotent);
+  ASSERT_SUCCESS_BLOCK(rc,
+    cass_batch_free(cass_batch);
+    return NULL;
+  )
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_duration_ce)) {
-      php_driver_duration *duration = PHP_DRIVER_GET_DURATION(value);
-      CHECK_RESULT(cass_statement_bind_duration(statement,
-                                                index,
-                                                duration->months, duration->days, duration->nanos));
-    }
+#if CURRENT_CPP_DRIVER_VERSION >= CPP_DRIVER_VERSION(2, 8, 0)
+  rc = cass_batch_set_execution_profile(cass_batch, execution_profile);
+  ASSERT_SUCCESS_BLOCK(rc,
+    cass_batch_free(cass_batch);
+    return NULL;
+  )
+#endif
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_set_ce)) {
-      CassError rc;
-      CassCollection *collection;
-      php_driver_set *set = PHP_DRIVER_GET_SET(value);
-      if (!php_driver_collection_from_set(set, &collection))
-        return FAILURE;
+  return cass_batch;
+}
 
-      rc = cass_statement_bind_collection(statement, index, collection);
-      cass_collection_free(collection);
-      CHECK_RESULT(rc);
-    }
+/* Execution options resolved against the session defaults */
+typedef struct {
+  HashTable *arguments;
+  CassConsistency consistency;
+  long serial_consistency;
+  int page_size;
+  char *paging_state_token;
+  size_t paging_state_token_size;
+  zval *timeout;
+  /* The timeout in milliseconds, CASS_UINT64_MAX for the cluster's */
+  cass_uint64_t request_timeout;
+  CassRetryPolicy *retry_policy;
+  cass_int64_t timestamp;
+  /* Only idempotent requests are executed speculatively */
+  cass_bool_t is_idempotent;
+  /* Rows are decoded to PHP scalars instead of value objects */
+  cass_bool_t fetch_scalars;
+  const char *execution_profile;
+} execute_options;
+
+/* Options that are not given are reset to the driver defaults rather than
+ * skipped, so that statements can be reused across executions */
+static CassError
+set_statement_options(CassStatement *stmt, execute_options *opts)
+{
+  CassError rc = cass_statement_set_consistency(stmt, opts->consistency);
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_map_ce)) {
-      CassError rc;
-      CassCollection *collection;
-      php_driver_map *map = PHP_DRIVER_GET_MAP(value);
-      if (!php_driver_collection_from_map(map, &collection))
-        return FAILURE;
+  if (rc == CASS_OK)
+    rc = cass_statement_set_serial_consistency(stmt,
+                                               opts->serial_consistency >= 0
+                                               ? (CassConsistency) opts->serial_consistency
+                                               : CASS_CONSISTENCY_ANY);
 
-      rc = cass_statement_bind_collection(statement, index, collection);
-      cass_collection_free(collection);
-      CHECK_RESULT(rc);
-    }
+  if (rc == CASS_OK)
+    rc = cass_statement_set_paging_size(stmt, opts->page_size >= 0 ? opts->page_size : -1);
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_collection_ce)) {
-      CassError rc;
-      CassCollection *collection;
-      php_driver_collection *coll = PHP_DRIVER_GET_COLLECTION(value);
-      if (!php_driver_collection_from_collection(coll, &collection))
-        return FAILURE;
+  if (rc == CASS_OK)
+    rc = cass_statement_set_paging_state_token(stmt,
+                                               opts->paging_state_token ? opts->paging_state_token : "",
+                                               opts->paging_state_token ? opts->paging_state_token_size : 0);
 
-      rc = cass_statement_bind_collection(statement, index, collection);
-      cass_collection_free(collection);
-      CHECK_RESULT(rc);
-    }
+  if (rc == CASS_OK)
+    rc = cass_statement_set_retry_policy(stmt, opts->retry_policy);
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_tuple_ce)) {
-      CassError rc;
-      CassTuple *tup;
-      php_driver_tuple *tuple = PHP_DRIVER_GET_TUPLE(value);
-      if (!php_driver_tuple_from_tuple(tuple, &tup))
-        return FAILURE;
+  if (rc == CASS_OK)
+    rc = cass_statement_set_timestamp(stmt, opts->timestamp);
 
-      rc = cass_statement_bind_tuple(statement, index, tup);
-      cass_tuple_free(tup);
-      CHECK_RESULT(rc);
-    }
+  if (rc == CASS_OK)
+    rc = cass_statement_set_request_timeout(stmt, opts->request_timeout);
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_user_type_value_ce)) {
-      CassError rc;
-      CassUserType *ut;
-      php_driver_user_type_value *user_type_value = PHP_DRIVER_GET_USER_TYPE_VALUE(value);
-      if (!php_driver_user_type_from_user_type_value(user_type_value, &ut))
-        return FAILURE;
+  if (rc == CASS_OK)
+    rc = cass_statement_set_is_idempotent(stmt, opts->is_idempotent);
 
-      rc = cass_statement_bind_user_type(statement, index, ut);
-      cass_user_type_free(ut);
-      CHECK_RESULT(rc);
-    }
-  }
+#if CURRENT_CPP_DRIVER_VERSION >= CPP_DRIVER_VERSION(2, 8, 0)
+  if (rc == CASS_OK)
+    rc = cass_statement_set_execution_profile(stmt, opts->execution_profile);
+#endif
 
-  return FAILURE;
+  return rc;
 }
 
-static int
-bind_argument_by_name(CassStatement *statement, const char *name,
-                      zval *value)
+static CassStatement *
+create_single(php_driver_statement *statement, execute_options *opts)
 {
-  if (Z_TYPE_P(value) == IS_NULL) {
-    CHECK_RESULT(cass_statement_bind_null_by_name(statement, name));
-  }
+  CassError rc = CASS_OK;
+  CassStatement *stmt = create_statement(statement, opts->arguments);
+  if (!stmt)
+    return NULL;
 
-  if (Z_TYPE_P(value) == IS_STRING)
-    CHECK_RESULT(cass_statement_bind_string_by_name(statement, name, Z_STRVAL_P(value)));
+  rc = set_statement_options(stmt, opts);
 
-  if (Z_TYPE_P(value) == IS_DOUBLE)
-    CHECK_RESULT(cass_statement_bind_double_by_name(statement, name, Z_DVAL_P(value)));
+  if (rc != CASS_OK) {
+    cass_statement_free(stmt);
+    zend_throw_exception_ex(exception_class(rc), rc,
+                            "%s", cass_error_desc(rc));
+    return NULL;
+  }
 
-  if (Z_TYPE_P(value) == IS_LONG)
-    CHECK_RESULT(cass_statement_bind_int32_by_name(statement, name, Z_LVAL_P(value)));
+  return stmt;
+}
 
-  if (Z_TYPE_P(value) == IS_TRUE)
-    CHECK_RESULT(cass_statement_bind_bool_by_name(statement, name, cass_true));
+static CassStatement *
+create_bound(php_driver_statement *statement, execute_options *opts)
+{
+  CassError rc = CASS_OK;
+  CassStatement *stmt;
 
-  if (Z_TYPE_P(value) == IS_FALSE)
-    CHECK_RESULT(cass_statement_bind_bool_by_name(statement, name, cass_false));
+  if (opts->arguments && php_driver_bound_statement_bind(statement, opts->arguments) == FAILURE)
+    return NULL;
 
-  if (Z_TYPE_P(value) == IS_OBJECT) {
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_float_ce)) {
-      php_driver_numeric *float_number = PHP_DRIVER_GET_NUMERIC(value);
-      CHECK_RESULT(cass_statement_bind_float_by_name(statement, name, float_number->data.floating.value));
-    }
+  stmt = php_driver_bound_statement_acquire(statement);
+  if (!stmt)
+    return NULL;
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_bigint_ce)) {
-      php_driver_numeric *bigint = PHP_DRIVER_GET_NUMERIC(value);
-      CHECK_RESULT(cass_statement_bind_int64_by_name(statement, name, bigint->data.bigint.value));
-    }
+  rc = set_statement_options(stmt, opts);
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_smallint_ce)) {
-      php_driver_numeric *smallint = PHP_DRIVER_GET_NUMERIC(value);
-      CHECK_RESULT(cass_statement_bind_int16_by_name(statement, name, smallint->data.smallint.value));
-    }
+  if (rc != CASS_OK) {
+    zend_throw_exception_ex(exception_class(rc), rc,
+                            "%s", cass_error_desc(rc));
+    return NULL;
+  }
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_tinyint_ce)) {
-      php_driver_numeric *tinyint = PHP_DRIVER_GET_NUMERIC(value);
-      CHECK_RESULT(cass_statement_bind_int8_by_name(statement, name, tinyint->data.tinyint.value));
-    }
+  return stmt;
+}
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_timestamp_ce)) {
-      php_driver_timestamp *timestamp = PHP_DRIVER_GET_TIMESTAMP(value);
-      CHECK_RESULT(cass_statement_bind_int64_by_name(statement, name, timestamp->timestamp));
-    }
+/* Lets the driver give up on the request once the wait for it times out, so
+ * that it doesn't keep a stream busy for a response nobody decodes */
+static int
+get_request_timeout(execute_options *out)
+{
+  cass_duration_t timeout_us;
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_date_ce)) {
-      php_driver_date *date = PHP_DRIVER_GET_DATE(value);
-      CHECK_RESULT(cass_statement_bind_uint32_by_name(statement, name, date->date));
-    }
+  if (php_driver_future_get_timeout(out->timeout, &timeout_us) == FAILURE)
+    return FAILURE;
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_time_ce)) {
-      php_driver_time *time = PHP_DRIVER_GET_TIME(value);
-      CHECK_RESULT(cass_statement_bind_int64_by_name(statement, name, time->time));
-    }
+  out->request_timeout = timeout_us > 0 ? (timeout_us + 999) / 1000 : CASS_UINT64_MAX;
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_blob_ce)) {
-      php_driver_blob *blob = PHP_DRIVER_GET_BLOB(value);
-      CHECK_RESULT(cass_statement_bind_bytes_by_name(statement, name, blob->data, blob->size));
-    }
+  return SUCCESS;
+}
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_varint_ce)) {
-      php_driver_numeric *varint = PHP_DRIVER_GET_NUMERIC(value);
-      size_t size;
-      cass_byte_t *data = (cass_byte_t *) export_twos_complement(varint->data.varint.value, &size);
-      CassError rc = cass_statement_bind_bytes_by_name(statement, name, data, size);
-      free(data);
-      CHECK_RESULT(rc);
-    }
+/* Overrides the options that are set */
+static void
+apply_execution_options(php_driver_execution_options *opts, execute_options *out)
+{
+  if (!Z_ISUNDEF(opts->arguments))
+    out->arguments = Z_ARRVAL(opts->arguments);
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_decimal_ce)) {
-      php_driver_numeric *decimal = PHP_DRIVER_GET_NUMERIC(value);
-      size_t size;
-      cass_byte_t *data = (cass_byte_t *) export_twos_complement(decimal->data.decimal.value, &size);
-      CassError rc = cass_statement_bind_decimal_by_name(statement, name, data, size, decimal->data.decimal.scale);
-      free(data);
-      CHECK_RESULT(rc);
-    }
+  if (opts->consistency >= 0)
+    out->consistency = (CassConsistency) opts->consistency;
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_uuid_interface_ce)) {
-      php_driver_uuid *uuid = PHP_DRIVER_GET_UUID(value);
-      CHECK_RESULT(cass_statement_bind_uuid_by_name(statement, name, uuid->uuid));
-    }
+  if (opts->page_size >= 0)
+    out->page_size = opts->page_size;
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_inet_ce)) {
-      php_driver_inet *inet = PHP_DRIVER_GET_INET(value);
-      CHECK_RESULT(cass_statement_bind_inet_by_name(statement, name, inet->inet));
-    }
+  if (opts->paging_state_token) {
+    out->paging_state_token = opts->paging_state_token;
+    out->paging_state_token_size = opts->paging_state_token_size;
+  }
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_duration_ce)) {
-      php_driver_duration *duration = PHP_DRIVER_GET_DURATION(value);
-      CHECK_RESULT(cass_statement_bind_duration_by_name(statement,
-                                                        name,
-                                                        duration->months, duration->days, duration->nanos));
-    }
+  if (!Z_ISUNDEF(opts->timeout))
+    out->timeout = &(opts->timeout);
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_set_ce)) {
-      CassError rc;
-      CassCollection *collection;
-      php_driver_set *set = PHP_DRIVER_GET_SET(value);
-      if (!php_driver_collection_from_set(set, &collection))
-        return FAILURE;
+  if (opts->serial_consistency >= 0)
+    out->serial_consistency = opts->serial_consistency;
 
-      rc = cass_statement_bind_collection_by_name(statement, name, collection);
-      cass_collection_free(collection);
-      CHECK_RESULT(rc);
-    }
+  if (!Z_ISUNDEF(opts->retry_policy))
+    out->retry_policy = (PHP_DRIVER_GET_RETRY_POLICY(&(opts->retry_policy)))->policy;
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_map_ce)) {
-      CassError rc;
-      CassCollection *collection;
-      php_driver_map *map = PHP_DRIVER_GET_MAP(value);
-      if (!php_driver_collection_from_map(map, &collection))
-        return FAILURE;
+  if (opts->timestamp != INT64_MIN)
+    out->timestamp = opts->timestamp;
 
-      rc = cass_statement_bind_collection_by_name(statement, name, collection);
-      cass_collection_free(collection);
-      CHECK_RESULT(rc);
-    }
+  if (opts->is_idempotent >= 0)
+    out->is_idempotent = opts->is_idempotent ? cass_true : cass_false;
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_collection_ce)) {
-      CassError rc;
-      CassCollection *collection;
-      php_driver_collection *coll = PHP_DRIVER_GET_COLLECTION(value);
-      if (!php_driver_collection_from_collection(coll, &collection))
-        return FAILURE;
+  if (opts->fetch_scalars >= 0)
+    out->fetch_scalars = opts->fetch_scalars ? cass_true : cass_false;
+}
 
-      rc = cass_statement_bind_collection_by_name(statement, name, collection);
-      cass_collection_free(collection);
-      CHECK_RESULT(rc);
-    }
+static int
+get_execute_options(php_driver_session *self, zval *options,
+                    php_driver_execution_options *local_opts,
+                    execute_options *out)
+{
+  php_driver_execution_options *opts = NULL;
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_tuple_ce)) {
-      CassError rc;
-      CassTuple *tup;
-      php_driver_tuple *tuple = PHP_DRIVER_GET_TUPLE(value);
-      if (!php_driver_tuple_from_tuple(tuple, &tup))
-        return FAILURE;
+  out->arguments               = NULL;
+  out->consistency             = self->default_consistency;
+  out->serial_consistency      = -1;
+  out->page_size               = self->default_page_size;
+  out->paging_state_token      = NULL;
+  out->paging_state_token_size = 0;
+  out->timeout                 = &(self->default_timeout);
+  out->retry_policy            = NULL;
+  out->timestamp               = INT64_MIN;
+  out->is_idempotent           = cass_false;
+  out->fetch_scalars           = cass_false;
+  out->execution_profile       = NULL;
+
+  if (!options)
+    return get_request_timeout(out);
+
+  if (Z_TYPE_P(options) != IS_ARRAY &&
+      (Z_TYPE_P(options) != IS_OBJECT || !instanceof_function(Z_OBJCE_P(options), php_driver_execution_options_ce))) {
+    INVALID_ARGUMENT_VALUE(options, "an instance of " PHP_DRIVER_NAMESPACE "\\ExecutionOptions or an array or null", FAILURE);
+  }
 
-      rc = cass_statement_bind_tuple_by_name(statement, name, tup);
-      cass_tuple_free(tup);
-      CHECK_RESULT(rc);
+  if (Z_TYPE_P(options) == IS_OBJECT) {
+    opts = PHP_DRIVER_GET_EXECUTION_OPTIONS(options);
+  } else {
+    if (php_driver_execution_options_build_local_from_array(local_opts, options) == FAILURE) {
+      return FAILURE;
     }
+    opts = local_opts;
+  }
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_user_type_value_ce)) {
-      CassError rc;
-      CassUserType *ut;
-      php_driver_user_type_value *user_type_value = PHP_DRIVER_GET_USER_TYPE_VALUE(value);
-      if (!php_driver_user_type_from_user_type_value(user_type_value, &ut))
-        return FAILURE;
+  /* The settings of the profile were validated by the cluster builder and
+   * only the ones given alongside it are applied on top */
+  if (!Z_ISUNDEF(opts->execution_profile)) {
+    zval *profile = NULL;
+
+    if (!Z_ISUNDEF(self->execution_profiles))
+      profile = zend_hash_find(Z_ARRVAL(self->execution_profiles),
+                               Z_STR(opts->execution_profile));
 
-      rc = cass_statement_bind_user_type_by_name(statement, name, ut);
-      cass_user_type_free(ut);
-      CHECK_RESULT(rc);
+    if (!profile) {
+      zend_throw_exception_ex(php_driver_invalid_argument_exception_ce, 0,
+                              "Unknown execution profile '%s'",
+                              Z_STRVAL(opts->execution_profile));
+      return FAILURE;
     }
+
+    apply_execution_options(PHP_DRIVER_GET_EXECUTION_OPTIONS(profile), out);
+    out->execution_profile = Z_STRVAL(opts->execution_profile);
   }
 
-  return FAILURE;
+  apply_execution_options(opts, out);
+
+  return get_request_timeout(out);
 }
 
-static int
-bind_arguments(CassStatement *statement, HashTable *arguments)
+static php_driver_statement *
+get_statement(zval *statement, php_driver_statement *simple_statement)
 {
-  int rc = SUCCESS;
-
-  zval *current;
-  unsigned long num_key;
+  if (Z_TYPE_P(statement) == IS_STRING) {
+    simple_statement->type = PHP_DRIVER_SIMPLE_STATEMENT;
+    simple_statement->data.simple.cql = Z_STRVAL_P(statement);
+    return simple_statement;
+  }
 
-  zend_string *key;
-  ZEND_HASH_FOREACH_KEY_VAL(arguments, num_key, key, current) {
-    if (key) {
-      rc = bind_argument_by_name(statement, key->val,
-                                 current);
-    } else {
-      rc = bind_argument_by_index(statement, num_key, current);
-    }
-    if (rc == FAILURE) break;
-  } ZEND_HASH_FOREACH_END();
+  if (Z_TYPE_P(statement) == IS_OBJECT &&
+      instanceof_function(Z_OBJCE_P(statement), php_driver_statement_ce)) {
+    return PHP_DRIVER_GET_STATEMENT(statement);
+  }
 
-  return rc;
+  INVALID_ARGUMENT_VALUE(statement, "a string or an instance of " PHP_DRIVER_NAMESPACE "\\Statement", NULL);
 }
 
-static CassStatement *
-create_statement(php_driver_statement *statement, HashTable *arguments)
+/* The columns of prepared statements are kept across executions */
+static php_driver_ref *
+get_columns_cache(php_driver_statement *stmt)
 {
-  CassStatement *stmt;
-  uint32_t count;
+  switch (stmt->type) {
+    case PHP_DRIVER_PREPARED_STATEMENT:
+      return stmt->data.prepared.columns_cache;
+    case PHP_DRIVER_BOUND_STATEMENT:
+      return PHP_DRIVER_GET_STATEMENT(&(stmt->data.bound.prepared))->data.prepared.columns_cache;
+    default:
+      return NULL;
+  }
+}
 
-  switch (statement->type) {
-  case PHP_DRIVER_SIMPLE_STATEMENT:
-    count  = 0;
+/* Follows "USE <keyspace>" statements, which change the keyspace that the
+ * session resolves unqualified tables in */
+static void
+track_keyspace(php_driver_session *self, php_driver_statement *stmt)
+{
+  const char *cql = NULL;
+  const char *keyspace;
+  size_t keyspace_len;
 
-    if (arguments)
-      count = zend_hash_num_elements(arguments);
+  if (stmt->type == PHP_DRIVER_SIMPLE_STATEMENT)
+    cql = stmt->data.simple.cql;
+  else if (stmt->data.prepared.cql)
+    cql = ZSTR_VAL(stmt->data.prepared.cql);
 
-    stmt = cass_statement_new(statement->data.simple.cql, count);
-    break;
-  case PHP_DRIVER_PREPARED_STATEMENT:
-    stmt = cass_prepared_bind(statement->data.prepared.prepared);
-    break;
-  default:
-    zend_throw_exception_ex(php_driver_runtime_exception_ce, 0,
-      "Unsupported statement type.");
-    return NULL;
-  }
+  if (!cql || php_driver_cql_parse_use(cql, &keyspace, &keyspace_len) == FAILURE)
+    return;
 
-  if (arguments && bind_arguments(stmt, arguments) == FAILURE) {
-    cass_statement_free(stmt);
-    return NULL;
-  }
+  if (self->keyspace)
+    zend_string_release(self->keyspace);
+  self->keyspace = zend_string_init(keyspace, keyspace_len, 0);
 
-  return stmt;
+  if (self->prepared_cache)
+    php_driver_prepared_cache_use(self->prepared_cache, keyspace, keyspace_len);
 }
 
-static CassBatch *
-create_batch(php_driver_statement *batch,
-             CassConsistency consistency,
-             CassRetryPolicy *retry_policy,
-             cass_int64_t timestamp)
+static CassFuture *
+submit_statement(php_driver_session *self, zval *statement,
+                 php_driver_statement *stmt, execute_options *opts,
+                 php_driver_ref **statement_ref)
 {
-  CassBatch *cass_batch = cass_batch_new(batch->data.batch.type);
-  CassError rc = CASS_OK;
+  CassSession *session = (CassSession *) self->session->data;
+  CassFuture *future = NULL;
+  CassStatement *single = NULL;
+  CassBatch *batch = NULL;
 
-  zval *current;
-  ZEND_HASH_FOREACH_VAL(&batch->data.batch.statements, current) {
-    php_driver_statement *statement;
-    php_driver_statement simple_statement;
-    HashTable *arguments;
-    CassStatement *stmt;
+  *statement_ref = NULL;
 
-    php_driver_batch_statement_entry *batch_statement_entry = (php_driver_batch_statement_entry *)Z_PTR_P(current);
+  switch (stmt->type) {
+    case PHP_DRIVER_SIMPLE_STATEMENT:
+    case PHP_DRIVER_PREPARED_STATEMENT:
+      single = create_single(stmt, opts);
 
-    if (Z_TYPE(batch_statement_entry->statement) == IS_STRING) {
-      simple_statement.type = PHP_DRIVER_SIMPLE_STATEMENT;
-      simple_statement.data.simple.cql = Z_STRVAL(batch_statement_entry->statement);
-      statement = &simple_statement;
-    } else {
-      statement = PHP_DRIVER_GET_STATEMENT(&(batch_statement_entry->statement));
-    }
+      if (!single)
+        return NULL;
 
-    arguments = !Z_ISUNDEF(batch_statement_entry->arguments)
-                ? Z_ARRVAL_P(&(batch_statement_entry->arguments))
-                : NULL;
+      future = cass_session_execute(session, single);
+      *statement_ref = php_driver_new_ref(single, free_statement);
+      track_keyspace(self, stmt);
+      break;
+    case PHP_DRIVER_BOUND_STATEMENT:
+      single = create_bound(stmt, opts);
 
-    stmt = create_statement(statement, arguments);
-    if (!stmt) {
-      cass_batch_free(cass_batch);
-      return NULL;
+      if (!single)
+        return NULL;
+
+      future = cass_session_execute(session, single);
+      *statement_ref = php_driver_add_ref(stmt->data.bound.statement);
+      break;
+    case PHP_DRIVER_BATCH_STATEMENT:
+      batch = create_batch(stmt, &stmt->data.batch.statements,
+                           opts->consistency, opts->retry_policy, opts->timestamp,
+                           opts->request_timeout, opts->is_idempotent,
+                           opts->execution_profile);
+
+      if (!batch)
+        return NULL;
+
+      future = cass_session_execute_batch(session, batch);
+      cass_batch_free(batch);
+      break;
+    default:
+      INVALID_ARGUMENT_VALUE(statement,
+        "an instance of " PHP_DRIVER_NAMESPACE "\\SimpleStatement, " \
+        PHP_DRIVER_NAMESPACE "\\PreparedStatement, " PHP_DRIVER_NAMESPACE "\\BoundStatement or " \
+        PHP_DRIVER_NAMESPACE "\\BatchStatement",
+        NULL
+      );
+  }
+
+  return future;
+}
+
+/* Batches that are split are sent as several requests, which only execute(),
+ * executeDetached() and defer() know how to wait for */
+static int
+is_split_batch(php_driver_statement *stmt)
+{
+  return stmt->type == PHP_DRIVER_BATCH_STATEMENT &&
+         (stmt->data.batch.group_by_partition || stmt->data.batch.max_bytes > 0) &&
+         zend_hash_num_elements(&stmt->data.batch.statements) > 0;
+}
+
+/* Starts executing the statement. The reference to the underlying statement,
+ * needed to fetch further pages, is returned to the caller and is NULL for
+ * batches. Bound statements keep theirs until they are released. Waits for
+ * or fails on a slot first if the session limits the requests in flight. */
+static CassFuture *
+execute_statement(php_driver_session *self, zval *statement,
+                  php_driver_statement *stmt, execute_options *opts,
+                  php_driver_ref **statement_ref)
+{
+  CassFuture *future;
+
+  *statement_ref = NULL;
+
+  if (is_split_batch(stmt)) {
+    zend_throw_exception_ex(php_driver_invalid_argument_exception_ce, 0,
+                            "Batches split by partition or size can only be executed "
+                            "with execute(), executeDetached() or defer()");
+    return NULL;
+  }
+
+  if (self->throttle && php_driver_throttle_acquire(self->throttle) == FAILURE)
+    return NULL;
+
+  future = submit_statement(self, statement, stmt, opts, statement_ref);
+
+  if (self->throttle) {
+    if (future) {
+      php_driver_throttle_track(self->throttle, future);
+    } else {
+      php_driver_throttle_release(self->throttle);
+    }
+  }
+
+  return future;
+}
+
+/* Creates the rows of a resolved future */
+static int
+get_rows(php_driver_session *self, CassFuture *future,
+         php_driver_ref *statement_ref, php_driver_ref *columns_cache,
+         cass_bool_t fetch_scalars, zval *return_value)
+{
+  const CassResult *result = NULL;
+  php_driver_ref *page = NULL;
+  php_driver_rows *rows = NULL;
+
+  if (php_driver_future_is_error(future) == FAILURE)
+    return FAILURE;
+
+  result = cass_future_get_result(future);
+
+  if (!result) {
+    zend_throw_exception_ex(php_driver_runtime_exception_ce, 0,
+                            "Future doesn't contain a result.");
+    return FAILURE;
+  }
+
+  page = php_driver_new_ref((void *)result, free_result);
+  php_driver_rows_create_page(return_value, page, columns_cache, fetch_scalars);
+  rows = PHP_DRIVER_GET_ROWS(return_value);
+
+  if (statement_ref && cass_result_has_more_pages(result)) {
+    rows->statement = php_driver_add_ref(statement_ref);
+    rows->result    = php_driver_add_ref(page);
+    rows->session   = php_driver_add_ref(self->session);
+  }
+
+  php_driver_del_ref(&page);
+
+  return SUCCESS;
+}
+
+/* Sends some of the entries of a batch as a batch of their own, in a slot of
+ * the session's requests in flight */
+static CassFuture *
+send_batch(php_driver_session *self, php_driver_statement *stmt,
+           HashTable *entries, execute_options *opts)
+{
+  CassFuture *future;
+  CassBatch *batch;
+
+  if (self->throttle && php_driver_throttle_acquire(self->throttle) == FAILURE)
+    return NULL;
+
+  batch = create_batch(stmt, entries,
+                       opts->consistency, opts->retry_policy, opts->timestamp,
+                       opts->request_timeout, opts->is_idempotent,
+                       opts->execution_profile);
+  if (!batch) {
+    if (self->throttle)
+      php_driver_throttle_release(self->throttle);
+    return NULL;
+  }
+
+  future = cass_session_execute_batch((CassSession *) self->session->data, batch);
+  cass_batch_free(batch);
+
+  if (self->throttle)
+    php_driver_throttle_track(self->throttle, future);
+
+  return future;
+}
+
+/* Executes the parts of a batch that is split by partition or size as
+ * separate batches at the same time, so that each one can be routed to a
+ * replica of its partition. Fails with the first error of any part. */
+static void
+execute_split_batch(php_driver_session *self, php_driver_statement *stmt,
+                    execute_options *opts, zval *return_value)
+{
+  CassSession *session = (CassSession *) self->session->data;
+  CassFuture **futures;
+  size_t i, count = 0;
+  int failed = 0;
+  zval groups;
+  zval *group;
+
+  if (php_driver_batch_split(stmt, session, self->keyspace, &groups, NULL) == FAILURE) {
+    zval_ptr_dtor(&groups);
+    return;
+  }
+
+  futures = (CassFuture **) ecalloc(zend_hash_num_elements(Z_ARRVAL(groups)),
+                                    sizeof(CassFuture *));
+
+  ZEND_HASH_FOREACH_VAL(Z_ARRVAL(groups), group) {
+    futures[count] = send_batch(self, stmt, Z_ARRVAL_P(group), opts);
+    if (!futures[count]) {
+      failed = 1;
+      break;
+    }
+    count++;
+  } ZEND_HASH_FOREACH_END();
+
+  zval_ptr_dtor(&groups);
+
+  /* Parts that were sent before a failure are left to complete */
+  if (!failed &&
+      php_driver_future_wait_many(futures, count, count, opts->timeout) == SUCCESS) {
+    for (i = 0; i < count; i++) {
+      if (php_driver_future_is_error(futures[i]) == FAILURE)
+        break;
+    }
+
+    if (i == count)
+      get_rows(self, futures[0], NULL, NULL, opts->fetch_scalars, return_value);
+  }
+
+  for (i = 0; i < count; i++)
+    cass_future_free(futures[i]);
+  efree(futures);
+}
+
+PHP_METHOD(DefaultSession, execute)
+{
+  zval *statement = NULL;
+  zval *options = NULL;
+  php_driver_session *self = NULL;
+  php_driver_statement *stmt = NULL;
+  php_driver_statement simple_statement;
+  php_driver_execution_options local_opts;
+  execute_options opts;
+  CassFuture *future = NULL;
+  php_driver_ref *statement_ref = NULL;
+
+  if (zend_parse_parameters(ZEND_NUM_ARGS(), "z|z", &statement, &options) == FAILURE) {
+    return;
+  }
+
+  self = PHP_DRIVER_GET_SESSION(getThis());
+
+  stmt = get_statement(statement, &simple_statement);
+  if (!stmt || get_execute_options(self, options, &local_opts, &opts) == FAILURE)
+    return;
+
+  if (is_split_batch(stmt)) {
+    execute_split_batch(self, stmt, &opts, return_value);
+    return;
+  }
+
+  future = execute_statement(self, statement, stmt, &opts, &statement_ref);
+  if (!future)
+    return;
+
+  if (php_driver_future_wait_timed(future, opts.timeout) == FAILURE ||
+      get_rows(self, future, statement_ref, get_columns_cache(stmt),
+               opts.fetch_scalars, return_value) == FAILURE) {
+    /* The request might still be in flight, don't reuse its statement */
+    if (stmt->type == PHP_DRIVER_BOUND_STATEMENT)
+      php_driver_bound_statement_release(stmt);
+  }
+
+  cass_future_free(future);
+  php_driver_del_ref(&statement_ref);
+}
+
+PHP_METHOD(DefaultSession, executeAsync)
+{
+  zval *statement = NULL;
+  zval *options = NULL;
+  php_driver_session *self = NULL;
+  php_driver_statement *stmt = NULL;
+  php_driver_statement simple_statement;
+  php_driver_execution_options local_opts;
+  execute_options opts;
+  php_driver_future_rows *future_rows = NULL;
+  CassFuture *future = NULL;
+  php_driver_ref *statement_ref = NULL;
+
+  if (zend_parse_parameters(ZEND_NUM_ARGS(), "z|z", &statement, &options) == FAILURE) {
+    return;
+  }
+
+  self = PHP_DRIVER_GET_SESSION(getThis());
+
+  stmt = get_statement(statement, &simple_statement);
+  if (!stmt || get_execute_options(self, options, &local_opts, &opts) == FAILURE)
+    return;
+
+  future = execute_statement(self, statement, stmt, &opts, &statement_ref);
+  if (!future)
+    return;
+
+  object_init_ex(return_value, php_driver_future_rows_ce);
+  future_rows = PHP_DRIVER_GET_FUTURE_ROWS(return_value);
+
+  future_rows->future = future;
+  if (statement_ref) {
+    future_rows->statement = statement_ref;
+    future_rows->session   = php_driver_add_ref(self->session);
+  }
+
+  if (get_columns_cache(stmt))
+    future_rows->columns_cache = php_driver_add_ref(get_columns_cache(stmt));
+  future_rows->fetch_scalars = opts.fetch_scalars;
+
+  /* The request may outlive the future, hand the statement over to it
+   * and rebuild it for the next execution */
+  if (stmt->type == PHP_DRIVER_BOUND_STATEMENT)
+    php_driver_bound_statement_release(stmt);
+}
+
+/* Sends each part of a split batch as a detached request of its own */
+static void
+execute_detached_split_batch(php_driver_session *self, php_driver_statement *stmt,
+                             execute_options *opts)
+{
+  zval groups;
+  zval *group;
+
+  if (php_driver_batch_split(stmt, (CassSession *) self->session->data, self->keyspace,
+                             &groups, NULL) == SUCCESS) {
+    ZEND_HASH_FOREACH_VAL(Z_ARRVAL(groups), group) {
+      CassFuture *future;
+
+      if (php_driver_detached_reserve(self->detached, opts->timeout) == FAILURE)
+        break;
+
+      future = send_batch(self, stmt, Z_ARRVAL_P(group), opts);
+      if (!future) {
+        php_driver_detached_release(self->detached);
+        break;
+      }
+
+      php_driver_detached_add(self->detached, future);
+    } ZEND_HASH_FOREACH_END();
+  }
+
+  zval_ptr_dtor(&groups);
+}
+
+PHP_METHOD(DefaultSession, executeDetached)
+{
+  zval *statement = NULL;
+  zval *options = NULL;
+  php_driver_session *self = NULL;
+  php_driver_statement *stmt = NULL;
+  php_driver_statement simple_statement;
+  php_driver_execution_options local_opts;
+  execute_options opts;
+  CassFuture *future = NULL;
+  php_driver_ref *statement_ref = NULL;
+
+  if (zend_parse_parameters(ZEND_NUM_ARGS(), "z|z", &statement, &options) == FAILURE) {
+    return;
+  }
+
+  self = PHP_DRIVER_GET_SESSION(getThis());
+
+  stmt = get_statement(statement, &simple_statement);
+  if (!stmt || get_execute_options(self, options, &local_opts, &opts) == FAILURE)
+    return;
+
+  if (!self->detached)
+    self->detached = php_driver_detached_new(PHP_DRIVER_MAX_DETACHED_REQUESTS);
+
+  if (is_split_batch(stmt)) {
+    execute_detached_split_batch(self, stmt, &opts);
+    return;
+  }
+
+  if (php_driver_detached_reserve(self->detached, opts.timeout) == FAILURE)
+    return;
+
+  future = execute_statement(self, statement, stmt, &opts, &statement_ref);
+  if (!future) {
+    php_driver_detached_release(self->detached);
+    return;
+  }
+
+  php_driver_detached_add(self->detached, future);
+  php_driver_del_ref(&statement_ref);
+
+  if (stmt->type == PHP_DRIVER_BOUND_STATEMENT)
+    php_driver_bound_statement_release(stmt);
+}
+
+PHP_METHOD(DefaultSession, detachedErrors)
+{
+  php_driver_session *self = NULL;
+
+  if (zend_parse_parameters_none() == FAILURE) {
+    return;
+  }
+
+  self = PHP_DRIVER_GET_SESSION(getThis());
+
+  php_driver_detached_errors(self->detached, return_value);
+}
+
+PHP_METHOD(DefaultSession, defer)
+{
+  zval *statement = NULL;
+  zval *options = NULL;
+  php_driver_session *self = NULL;
+  php_driver_statement simple_statement;
+  php_driver_execution_options local_opts;
+  execute_options opts;
+  zval entry;
+
+  if (zend_parse_parameters(ZEND_NUM_ARGS(), "z|z", &statement, &options) == FAILURE) {
+    return;
+  }
+
+  self = PHP_DRIVER_GET_SESSION(getThis());
+
+  /* Invalid arguments are reported now rather than at the end of the request */
+  if (!get_statement(statement, &simple_statement) ||
+      get_execute_options(self, options, &local_opts, &opts) == FAILURE)
+    return;
+
+  if (Z_ISUNDEF(PHP_DRIVER_G(deferred)))
+    array_init(&PHP_DRIVER_G(deferred));
+
+  array_init(&entry);
+  Z_ADDREF_P(getThis());
+  add_next_index_zval(&entry, getThis());
+  Z_TRY_ADDREF_P(statement);
+  add_next_index_zval(&entry, statement);
+  if (options) {
+    Z_TRY_ADDREF_P(options);
+    add_next_index_zval(&entry, options);
+  }
+  add_next_index_zval(&PHP_DRIVER_G(deferred), &entry);
+}
+
+static void
+deferred_complete(php_driver_future_queue *queue)
+{
+  CassFuture *future = NULL;
+
+  if (php_driver_future_queue_next(queue, NULL, &future) == FAILURE || !future)
+    return;
+
+  if (cass_future_error_code(future) != CASS_OK) {
+    const char *message;
+    size_t message_len;
+    cass_future_error_message(future, &message, &message_len);
+    php_error_docref(NULL, E_WARNING, "Deferred write failed: %.*s",
+                     (int) message_len, message);
+  }
+
+  cass_future_free(future);
+}
+
+void
+php_driver_default_session_finish_response()
+{
+  zval function;
+  zval retval;
+
+  if (!zend_hash_str_exists(EG(function_table), ZEND_STRL("fastcgi_finish_request")))
+    return;
+
+  ZVAL_STRING(&function, "fastcgi_finish_request");
+  ZVAL_UNDEF(&retval);
+  call_user_function(NULL, NULL, &function, &retval, 0, NULL);
+  zval_ptr_dtor(&function);
+  zval_ptr_dtor(&retval);
+}
+
+/* A write buffered by Session::defer(), resolved when it's flushed */
+typedef struct {
+  php_driver_session *session;
+  zval *statement;
+  php_driver_statement *stmt;
+  php_driver_statement simple_statement;
+  php_driver_execution_options local_opts;
+  execute_options opts;
+  int batched;
+} deferred_write;
+
+/* Deferred writes of a session that can be sent together. The options of
+ * the batch are those of its first write. */
+typedef struct {
+  zval batch;
+  deferred_write *write;
+} deferred_batch;
+
+/* Only prepared writes can be routed to their partition and a batch has no
+ * serial consistency of its own */
+static int
+deferred_can_batch(deferred_write *write)
+{
+  return (write->stmt->type == PHP_DRIVER_PREPARED_STATEMENT ||
+          write->stmt->type == PHP_DRIVER_BOUND_STATEMENT) &&
+         write->opts.serial_consistency < 0;
+}
+
+/* Writes can share a batch when the options that apply to a batch match */
+static int
+deferred_same_batch(deferred_write *write, deferred_write *other)
+{
+  execute_options *a = &write->opts;
+  execute_options *b = &other->opts;
+
+  return write->session == other->session &&
+         a->consistency == b->consistency &&
+         a->retry_policy == b->retry_policy &&
+         a->timestamp == b->timestamp &&
+         a->request_timeout == b->request_timeout &&
+         a->is_idempotent == b->is_idempotent &&
+         (a->execution_profile == b->execution_profile ||
+          (a->execution_profile && b->execution_profile &&
+           strcmp(a->execution_profile, b->execution_profile) == 0));
+}
+
+/* Adds the write to the batch the way BatchStatement::add() does and
+ * remembers which write the entry came from */
+static void
+deferred_batch_add(deferred_batch *batch, deferred_write *write, HashTable *owners)
+{
+  php_driver_statement *self = PHP_DRIVER_GET_STATEMENT(&batch->batch);
+  php_driver_batch_statement_entry *entry =
+    (php_driver_batch_statement_entry *) ecalloc(1, sizeof(php_driver_batch_statement_entry));
+  zval value;
+
+  if (write->stmt->type == PHP_DRIVER_BOUND_STATEMENT) {
+    ZVAL_COPY(&(entry->statement), &(write->stmt->data.bound.prepared));
+    ZVAL_ARR(&(entry->arguments), zend_array_dup(&(write->stmt->data.bound.values)));
+
+    if (write->opts.arguments)
+      zend_hash_merge(Z_ARRVAL(entry->arguments), write->opts.arguments, zval_add_ref, 1);
+  } else {
+    ZVAL_COPY(&(entry->statement), write->statement);
+
+    if (write->opts.arguments)
+      ZVAL_ARR(&(entry->arguments), zend_array_dup(write->opts.arguments));
+  }
+
+  ZVAL_PTR(&value, entry);
+  zend_hash_next_index_insert(&self->data.batch.statements, &value);
+  zend_hash_index_update_ptr(owners, (zend_ulong) (uintptr_t) entry, write);
+  write->batched = 1;
+}
+
+static void
+deferred_make_room(php_driver_future_queue *queue, size_t *in_flight)
+{
+  if (*in_flight == PHP_DRIVER_DEFERRED_CONCURRENCY) {
+    deferred_complete(queue);
+    (*in_flight)--;
+  }
+}
+
+/* Waits for the request later on. Writes that can't be sent are reported
+ * and skipped, but nothing more is sent once a request can't be waited on. */
+static int
+deferred_queue(php_driver_future_queue *queue, size_t *in_flight, CassFuture *future)
+{
+  if (!future) {
+    zend_clear_exception();
+    php_error_docref(NULL, E_WARNING, "Unable to send a deferred write");
+    return SUCCESS;
+  }
+
+  if (php_driver_future_queue_add(queue, future) == FAILURE) {
+    zend_clear_exception();
+    php_error_docref(NULL, E_WARNING,
+                     "Unable to wait for a deferred write, the remaining ones are dropped");
+    cass_future_free(future);
+    return FAILURE;
+  }
+
+  (*in_flight)++;
+  return SUCCESS;
+}
+
+/* Sends each part of a deferred batch that is split as a request of its own */
+static int
+deferred_send_split_batch(php_driver_future_queue *queue, size_t *in_flight,
+                          deferred_write *write)
+{
+  php_driver_session *self = write->session;
+  int result = SUCCESS;
+  zval groups;
+  zval *group;
+
+  if (php_driver_batch_split(write->stmt, (CassSession *) self->session->data, self->keyspace,
+                             &groups, NULL) == FAILURE) {
+    zval_ptr_dtor(&groups);
+    return deferred_queue(queue, in_flight, NULL);
+  }
+
+  ZEND_HASH_FOREACH_VAL(Z_ARRVAL(groups), group) {
+    deferred_make_room(queue, in_flight);
+    result = deferred_queue(queue, in_flight,
+                            send_batch(self, write->stmt, Z_ARRVAL_P(group), &write->opts));
+    if (result == FAILURE)
+      break;
+  } ZEND_HASH_FOREACH_END();
+
+  zval_ptr_dtor(&groups);
+
+  return result;
+}
+
+static int
+deferred_send(php_driver_future_queue *queue, size_t *in_flight, deferred_write *write)
+{
+  php_driver_ref *statement_ref = NULL;
+  CassFuture *future;
+
+  if (is_split_batch(write->stmt))
+    return deferred_send_split_batch(queue, in_flight, write);
+
+  deferred_make_room(queue, in_flight);
+
+  future = execute_statement(write->session, write->statement, write->stmt,
+                             &write->opts, &statement_ref);
+  php_driver_del_ref(&statement_ref);
+
+  if (future && write->stmt->type == PHP_DRIVER_BOUND_STATEMENT)
+    php_driver_bound_statement_release(write->stmt);
+
+  return deferred_queue(queue, in_flight, future);
+}
+
+static int
+deferred_send_entries(php_driver_future_queue *queue, size_t *in_flight,
+                      HashTable *entries, HashTable *owners)
+{
+  zval *current;
+
+  ZEND_HASH_FOREACH_VAL(entries, current) {
+    deferred_write *write =
+      (deferred_write *) zend_hash_index_find_ptr(owners, (zend_ulong) (uintptr_t) Z_PTR_P(current));
+
+    if (deferred_send(queue, in_flight, write) == FAILURE)
+      return FAILURE;
+  } ZEND_HASH_FOREACH_END();
+
+  return SUCCESS;
+}
+
+/* Sends the writes to the same partition as one batch each. Writes whose
+ * partition isn't known, e.g. without schema metadata, are sent alone
+ * rather than making a coordinator forward them. */
+static int
+deferred_send_batch(php_driver_future_queue *queue, size_t *in_flight,
+                    deferred_batch *batch, HashTable *owners)
+{
+  php_driver_session *self = batch->write->session;
+  php_driver_statement *stmt = PHP_DRIVER_GET_STATEMENT(&batch->batch);
+  int result = SUCCESS;
+  zval groups;
+  zval unknown;
+  zval *group;
+
+  array_init(&unknown);
+
+  if (php_driver_batch_split(stmt, (CassSession *) self->session->data, self->keyspace,
+                             &groups, &unknown) == FAILURE) {
+    zend_clear_exception();
+    result = deferred_send_entries(queue, in_flight, &stmt->data.batch.statements, owners);
+  } else {
+    ZEND_HASH_FOREACH_VAL(Z_ARRVAL(groups), group) {
+      if (zend_hash_num_elements(Z_ARRVAL_P(group)) == 1) {
+        result = deferred_send_entries(queue, in_flight, Z_ARRVAL_P(group), owners);
+      } else {
+        deferred_make_room(queue, in_flight);
+        result = deferred_queue(queue, in_flight,
+                                send_batch(self, stmt, Z_ARRVAL_P(group), &batch->write->opts));
+      }
+
+      if (result == FAILURE)
+        break;
+    } ZEND_HASH_FOREACH_END();
+
+    if (result == SUCCESS)
+      result = deferred_send_entries(queue, in_flight, Z_ARRVAL(unknown), owners);
+  }
+
+  zval_ptr_dtor(&groups);
+  zval_ptr_dtor(&unknown);
+
+  return result;
+}
+
+void
+php_driver_default_session_flush_deferred(int shutdown)
+{
+  php_driver_future_queue *queue;
+  deferred_write *writes;
+  deferred_batch *batches;
+  size_t count, batch_count = 0, in_flight = 0, i, j;
+  int result = SUCCESS;
+  HashTable owners;
+  zval deferred;
+  zval *entry;
+
+  if (Z_ISUNDEF(PHP_DRIVER_G(deferred)))
+    return;
+
+  /* Writes deferred meanwhile are left for the next flush */
+  ZVAL_COPY_VALUE(&deferred, &PHP_DRIVER_G(deferred));
+  ZVAL_UNDEF(&PHP_DRIVER_G(deferred));
+
+  /* User code can't run after a fatal error */
+  if (shutdown && CG(unclean_shutdown)) {
+    zval_ptr_dtor(&deferred);
+    return;
+  }
+
+  count   = zend_hash_num_elements(Z_ARRVAL(deferred));
+  writes  = (deferred_write *) ecalloc(count, sizeof(deferred_write));
+  batches = (deferred_batch *) ecalloc(count, sizeof(deferred_batch));
+  zend_hash_init(&owners, count, NULL, NULL, 0);
+
+  /* Group the writes before sending any of them */
+  i = 0;
+  ZEND_HASH_FOREACH_VAL(Z_ARRVAL(deferred), entry) {
+    deferred_write *write = &writes[i++];
+    zval *session = zend_hash_index_find(Z_ARRVAL_P(entry), 0);
+    zval *options = zend_hash_index_find(Z_ARRVAL_P(entry), 2);
+
+    write->session   = PHP_DRIVER_GET_SESSION(session);
+    write->statement = zend_hash_index_find(Z_ARRVAL_P(entry), 1);
+    write->stmt      = get_statement(write->statement, &write->simple_statement);
+
+    if (!write->stmt ||
+        get_execute_options(write->session, options, &write->local_opts, &write->opts) == FAILURE) {
+      zend_clear_exception();
+      php_error_docref(NULL, E_WARNING, "Unable to send a deferred write");
+      write->stmt = NULL;
+      continue;
+    }
+
+    if (!deferred_can_batch(write))
+      continue;
+
+    for (j = 0; j < batch_count; j++) {
+      if (deferred_same_batch(batches[j].write, write))
+        break;
+    }
+
+    if (j == batch_count) {
+      php_driver_statement *batch;
+
+      object_init_ex(&batches[j].batch, php_driver_batch_statement_ce);
+      batch = PHP_DRIVER_GET_STATEMENT(&batches[j].batch);
+      batch->data.batch.type               = CASS_BATCH_TYPE_UNLOGGED;
+      batch->data.batch.group_by_partition = 1;
+      batch->data.batch.max_bytes          = PHP_DRIVER_DEFERRED_BATCH_BYTES;
+      batches[j].write = write;
+      batch_count++;
     }
-    cass_batch_add_statement(cass_batch, stmt);
-    cass_statement_free(stmt);
+
+    deferred_batch_add(&batches[j], write, &owners);
   } ZEND_HASH_FOREACH_END();
 
-  rc = cass_batch_set_consistency(cass_batch, consistency);
-  ASSERT_SUCCESS_BLOCK(rc,
-    cass_batch_free(cass_batch);
-    return NULL;
-  )
+  queue = php_driver_future_queue_new(PHP_DRIVER_DEFERRED_CONCURRENCY);
 
-  rc = cass_batch_set_retry_policy(cass_batch, retry_policy);
-  ASSERT_SUCCESS_BLOCK(rc,
-    cass_batch_free(cass_batch);
-    return NULL;
-  )
+  for (i = 0; i < count && result == SUCCESS; i++) {
+    if (writes[i].stmt && !writes[i].batched)
+      result = deferred_send(queue, &in_flight, &writes[i]);
+  }
 
-  rc = cass_batch_set_timestamp(cass_batch, timestamp);
-  ASSERT_SUCCESS_BLOCK(rc,
-    cass_batch_free(cass_batch);
-    return NULL;
-  )
+  for (i = 0; i < batch_count; i++) {
+    if (result == SUCCESS)
+      result = deferred_send_batch(queue, &in_flight, &batches[i], &owners);
+    zval_ptr_dtor(&batches[i].batch);
+  }
 
-  return cass_batch;
+  while (in_flight-- > 0)
+    deferred_complete(queue);
+
+  php_driver_future_queue_free(queue);
+  zend_hash_destroy(&owners);
+  efree(batches);
+  efree(writes);
+  zval_ptr_dtor(&deferred);
 }
 
-static CassStatement *
-create_single(php_driver_statement *statement, HashTable *arguments,
-              CassConsistency consistency, long serial_consistency,
-              int page_size, const char* paging_state_token,
-              size_t paging_state_token_size,
-              CassRetryPolicy *retry_policy, cass_int64_t timestamp)
+int
+php_driver_default_session_has_deferred()
 {
-  CassError rc = CASS_OK;
-  CassStatement *stmt = create_statement(statement, arguments);
-  if (!stmt)
-    return NULL;
+  return !Z_ISUNDEF(PHP_DRIVER_G(deferred));
+}
 
-  rc = cass_statement_set_consistency(stmt, consistency);
+PHP_METHOD(DefaultSession, flushDeferred)
+{
+  if (zend_parse_parameters_none() == FAILURE) {
+    return;
+  }
 
-  if (rc == CASS_OK && serial_consistency >= 0)
-    rc = cass_statement_set_serial_consistency(stmt, serial_consistency);
+  php_driver_default_session_flush_deferred(0);
+}
 
-  if (rc == CASS_OK && page_size >= 0)
-    rc = cass_statement_set_paging_size(stmt, page_size);
+typedef struct {
+  CassFuture *future;
+  php_driver_ref *statement;
+  php_driver_ref *columns_cache;
+  zend_ulong index;
+} concurrent_request;
+
+/* Walks an array or a Traversable */
+typedef struct {
+  HashTable *array;
+  HashPosition pos;
+  zend_object_iterator *iterator;
+  zval current;
+} concurrent_cursor;
 
-  if (rc == CASS_OK && paging_state_token) {
-    rc = cass_statement_set_paging_state_token(stmt,
-                                               paging_state_token,
-                                               paging_state_token_size);
+static int
+cursor_init(concurrent_cursor *cursor, zval *items)
+{
+  cursor->array = NULL;
+  cursor->iterator = NULL;
+  ZVAL_UNDEF(&cursor->current);
+
+  if (Z_TYPE_P(items) == IS_ARRAY) {
+    cursor->array = Z_ARRVAL_P(items);
+    zend_hash_internal_pointer_reset_ex(cursor->array, &cursor->pos);
+    return SUCCESS;
   }
 
-  if (rc == CASS_OK && retry_policy)
-    rc = cass_statement_set_retry_policy(stmt, retry_policy);
+  cursor->iterator = Z_OBJCE_P(items)->get_iterator(Z_OBJCE_P(items), items, 0);
+  if (!cursor->iterator || EG(exception))
+    return FAILURE;
 
-  if (rc == CASS_OK)
-    rc = cass_statement_set_timestamp(stmt, timestamp);
+  if (cursor->iterator->funcs->rewind)
+    cursor->iterator->funcs->rewind(cursor->iterator);
 
-  if (rc != CASS_OK) {
-    cass_statement_free(stmt);
-    zend_throw_exception_ex(exception_class(rc), rc,
-                            "%s", cass_error_desc(rc));
-    return NULL;
+  return EG(exception) ? FAILURE : SUCCESS;
+}
+
+/* Returns the current item and advances, or NULL at the end or on error */
+static zval *
+cursor_next(concurrent_cursor *cursor)
+{
+  zval *item;
+
+  if (cursor->array) {
+    item = zend_hash_get_current_data_ex(cursor->array, &cursor->pos);
+    if (item) {
+      zend_hash_move_forward_ex(cursor->array, &cursor->pos);
+      ZVAL_DEREF(item);
+    }
+    return item;
   }
 
-  return stmt;
+  if (cursor->iterator->funcs->valid(cursor->iterator) != SUCCESS || EG(exception))
+    return NULL;
+
+  item = cursor->iterator->funcs->get_current_data(cursor->iterator);
+  if (!item || EG(exception))
+    return NULL;
+
+  /* Keep the item alive until the next one is fetched */
+  ZVAL_DEREF(item);
+  zval_ptr_dtor(&cursor->current);
+  ZVAL_COPY(&cursor->current, item);
+  cursor->iterator->funcs->move_forward(cursor->iterator);
+
+  return &cursor->current;
 }
 
-PHP_METHOD(DefaultSession, execute)
+static void
+cursor_destroy(concurrent_cursor *cursor)
 {
+  zval_ptr_dtor(&cursor->current);
+  if (cursor->iterator)
+    zend_iterator_dtor(cursor->iterator);
+}
+
+static void
+take_exception(zval *exception)
+{
+  ZVAL_OBJ(exception, EG(exception));
+  Z_ADDREF_P(exception);
+  zend_clear_exception();
+}
+
+PHP_METHOD(DefaultSession, executeConcurrent)
+{
+  zval *items = NULL;
+  zend_long concurrency = 0;
   zval *statement = NULL;
   zval *options = NULL;
   php_driver_session *self = NULL;
-  php_driver_statement *stmt = NULL;
+  php_driver_statement *shared = NULL;
   php_driver_statement simple_statement;
-  HashTable *arguments = NULL;
-  CassConsistency consistency = PHP_DRIVER_DEFAULT_CONSISTENCY;
-  int page_size = -1;
-  char *paging_state_token = NULL;
-  size_t paging_state_token_size = 0;
-  zval *timeout = NULL;
-  long serial_consistency = -1;
-  CassRetryPolicy *retry_policy = NULL;
-  cass_int64_t timestamp = INT64_MIN;
-  php_driver_execution_options *opts = NULL;
   php_driver_execution_options local_opts;
-  CassFuture *future = NULL;
-  CassStatement *single = NULL;
-  CassBatch *batch  = NULL;
-
-  if (zend_parse_parameters(ZEND_NUM_ARGS(), "z|z", &statement, &options) == FAILURE) {
+  execute_options opts;
+  concurrent_cursor cursor;
+  concurrent_request *requests = NULL;
+  php_driver_future_queue *queue = NULL;
+  size_t in_flight = 0;
+  zend_ulong index = 0;
+  zval *item;
+  int done = 0;
+
+  if (zend_parse_parameters(ZEND_NUM_ARGS(), "zl|z!z", &items, &concurrency,
+                            &statement, &options) == FAILURE) {
     return;
   }
 
   self = PHP_DRIVER_GET_SESSION(getThis());
 
-  if (Z_TYPE_P(statement) == IS_STRING) {
-    simple_statement.type = PHP_DRIVER_SIMPLE_STATEMENT;
-    simple_statement.data.simple.cql = Z_STRVAL_P(statement);
-    stmt = &simple_statement;
-  } else if (Z_TYPE_P(statement) == IS_OBJECT &&
-             instanceof_function(Z_OBJCE_P(statement), php_driver_statement_ce)) {
-    stmt = PHP_DRIVER_GET_STATEMENT(statement);
-  } else {
-    INVALID_ARGUMENT(statement, "a string or an instance of " PHP_DRIVER_NAMESPACE "\\Statement");
+  if (Z_TYPE_P(items) != IS_ARRAY &&
+      (Z_TYPE_P(items) != IS_OBJECT || !instanceof_function(Z_OBJCE_P(items), zend_ce_traversable))) {
+    INVALID_ARGUMENT(items, "an array or a Traversable");
   }
 
-  consistency = self->default_consistency;
-  page_size = self->default_page_size;
-  timeout = &(self->default_timeout);
+  if (concurrency < 1 || concurrency > PHP_DRIVER_MAX_CONCURRENCY) {
+    zval value;
+    ZVAL_LONG(&value, concurrency);
+    throw_invalid_argument(&value, "concurrency",
+                           "a number of requests between 1 and "
+                           ZEND_TOSTR(PHP_DRIVER_MAX_CONCURRENCY));
+    return;
+  }
 
-  if (options) {
-    if (Z_TYPE_P(options) != IS_ARRAY &&
-        (Z_TYPE_P(options) != IS_OBJECT || !instanceof_function(Z_OBJCE_P(options), php_driver_execution_options_ce))) {
-      INVALID_ARGUMENT(options, "an instance of " PHP_DRIVER_NAMESPACE "\\ExecutionOptions or an array or null");
-    }
+  if (statement) {
+    shared = get_statement(statement, &simple_statement);
+    if (!shared)
+      return;
+  }
 
-    if (Z_TYPE_P(options) == IS_OBJECT) {
-      opts = PHP_DRIVER_GET_EXECUTION_OPTIONS(options);
-    } else {
-      if (php_driver_execution_options_build_local_from_array(&local_opts, options) == FAILURE) {
-        return;
-      }
-      opts = &local_opts;
-    }
+  if (get_execute_options(self, options, &local_opts, &opts) == FAILURE)
+    return;
 
-    if (!Z_ISUNDEF(opts->arguments))
-      arguments = Z_ARRVAL(opts->arguments);
+  if (cursor_init(&cursor, items) == FAILURE) {
+    cursor_destroy(&cursor);
+    return;
+  }
 
-    if (opts->consistency >= 0)
-      consistency = (CassConsistency) opts->consistency;
+  requests = ecalloc(concurrency, sizeof(concurrent_request));
+  queue = php_driver_future_queue_new(concurrency);
 
-    if (opts->page_size >= 0)
-      page_size = opts->page_size;
+  array_init(return_value);
 
-    if (opts->paging_state_token) {
-      paging_state_token = opts->paging_state_token;
-      paging_state_token_size = opts->paging_state_token_size;
-    }
+  while (!done || in_flight > 0) {
+    /* Fill the window */
+    while (!done && in_flight < (size_t) concurrency) {
+      php_driver_statement *stmt = shared;
+      execute_options item_opts = opts;
+      concurrent_request *request;
+      zval exception;
+
+      item = cursor_next(&cursor);
+      if (!item) {
+        done = 1;
+        break;
+      }
 
-    if (!Z_ISUNDEF(opts->timeout))
-      timeout = &(opts->timeout);
+      add_index_null(return_value, index);
 
-    if (opts->serial_consistency >= 0)
-      serial_consistency = opts->serial_consistency;
+      if (shared) {
+        if (Z_TYPE_P(item) != IS_ARRAY) {
+          throw_invalid_argument(item, "arguments", "an array");
+        } else {
+          item_opts.arguments = Z_ARRVAL_P(item);
+        }
+      } else {
+        stmt = get_statement(item, &simple_statement);
+      }
 
-    if (!Z_ISUNDEF(opts->retry_policy))
-      retry_policy = (PHP_DRIVER_GET_RETRY_POLICY(&(opts->retry_policy)))->policy;
+      request = &requests[in_flight];
+      request->future    = NULL;
+      request->statement = NULL;
+      request->columns_cache = NULL;
+      request->index     = index++;
+
+      if (!EG(exception)) {
+        request->future = execute_statement(self, shared ? statement : item, stmt,
+                                            &item_opts, &request->statement);
+
+        if (request->future) {
+          if (get_columns_cache(stmt))
+            request->columns_cache = php_driver_add_ref(get_columns_cache(stmt));
+          if (stmt->type == PHP_DRIVER_BOUND_STATEMENT)
+            php_driver_bound_statement_release(stmt);
+          php_driver_future_queue_add(queue, request->future);
+        } else if (!EG(exception)) {
+          zend_throw_exception_ex(php_driver_invalid_argument_exception_ce, 0,
+                                  "Unable to bind the arguments of request %lu",
+                                  (unsigned long) request->index);
+        }
+      }
 
-    timestamp = opts->timestamp;
-  }
+      if (EG(exception)) {
+        if (request->future)
+          cass_future_free(request->future);
+        php_driver_del_ref(&request->statement);
+        php_driver_del_ref(&request->columns_cache);
 
-  switch (stmt->type) {
-    case PHP_DRIVER_SIMPLE_STATEMENT:
-    case PHP_DRIVER_PREPARED_STATEMENT:
-      single = create_single(stmt, arguments, consistency,
-                             serial_consistency, page_size,
-                             paging_state_token, paging_state_token_size,
-                             retry_policy, timestamp);
+        take_exception(&exception);
+        zend_hash_index_update(Z_ARRVAL_P(return_value), request->index, &exception);
+        continue;
+      }
 
-      if (!single)
-        return;
+      in_flight++;
+    }
 
-      future = cass_session_execute((CassSession *) self->session->data, single);
+    if (EG(exception))
       break;
-    case PHP_DRIVER_BATCH_STATEMENT:
-      batch = create_batch(stmt, consistency, retry_policy, timestamp);
 
-      if (!batch)
-        return;
+    /* Collect the next result and free its slot */
+    if (in_flight > 0) {
+      CassFuture *future;
+      concurrent_request *request = NULL;
+      zval result;
+      size_t i;
+
+      if (php_driver_future_queue_next(queue, opts.timeout, &future) == FAILURE)
+        break;
+
+      for (i = 0; i < in_flight; i++) {
+        if (requests[i].future == future) {
+          request = &requests[i];
+          break;
+        }
+      }
 
-      future = cass_session_execute_batch((CassSession *) self->session->data, batch);
-      break;
-    default:
-      INVALID_ARGUMENT(statement,
-        "an instance of " PHP_DRIVER_NAMESPACE "\\SimpleStatement, " \
-        PHP_DRIVER_NAMESPACE "\\PreparedStatement or " PHP_DRIVER_NAMESPACE "\\BatchStatement"
-      );
-      return;
+      ZVAL_UNDEF(&result);
+      if (get_rows(self, future, request->statement, request->columns_cache,
+                   opts.fetch_scalars, &result) == FAILURE) {
+        zval_ptr_dtor(&result);
+        take_exception(&result);
+      }
+      zend_hash_index_update(Z_ARRVAL_P(return_value), request->index, &result);
+
+      cass_future_free(request->future);
+      php_driver_del_ref(&request->statement);
+      php_driver_del_ref(&request->columns_cache);
+      requests[i] = requests[--in_flight];
+    }
   }
 
-  do {
-    const CassResult *result = NULL;
-    php_driver_rows *rows = NULL;
+  /* Only reached with requests in flight when failing, abandon them */
+  while (in_flight > 0) {
+    in_flight--;
+    cass_future_free(requests[in_flight].future);
+    php_driver_del_ref(&requests[in_flight].statement);
+    php_driver_del_ref(&requests[in_flight].columns_cache);
+  }
 
-    if (php_driver_future_wait_timed(future, timeout) == FAILURE ||
-        php_driver_future_is_error(future) == FAILURE)
-      break;
+  php_driver_future_queue_free(queue);
+  efree(requests);
+  cursor_destroy(&cursor);
+}
 
-    result = cass_future_get_result(future);
-    cass_future_free(future);
+typedef struct {
+  HashTable *values;
+  HashPosition pos;
+  /* Set for names that occur more than once, which are bound by name */
+  zend_string *name;
+  zend_ulong index;
+  const CassDataType *data_type;
+} bulk_column;
+
+typedef struct {
+  CassFuture *future;
+  CassStatement *statement;
+  zend_ulong row;
+} bulk_slot;
 
-    if (!result) {
-      zend_throw_exception_ex(php_driver_runtime_exception_ce, 0,
-                              "Future doesn't contain a result.");
-      break;
+static int
+get_bulk_columns(php_driver_statement *prepared, HashTable *columns,
+                 bulk_column *out, zend_ulong *rows)
+{
+  zend_string *name;
+  zend_ulong index;
+  zval *values;
+  size_t i = 0;
+
+  ZEND_HASH_FOREACH_KEY_VAL(columns, index, name, values) {
+    bulk_column *column = &out[i++];
+
+    ZVAL_DEREF(values);
+    if (Z_TYPE_P(values) != IS_ARRAY) {
+      throw_invalid_argument(values, "column", "an array of values");
+      return FAILURE;
     }
 
-    object_init_ex(return_value, php_driver_rows_ce);
-    rows = PHP_DRIVER_GET_ROWS(return_value);
-
-    if (php_driver_get_result(result, &rows->rows) == FAILURE) {
-      cass_result_free(result);
-      break;
+    if (i == 1) {
+      *rows = zend_hash_num_elements(Z_ARRVAL_P(values));
+    } else if (zend_hash_num_elements(Z_ARRVAL_P(values)) != *rows) {
+      zend_throw_exception_ex(php_driver_invalid_argument_exception_ce, 0,
+                              "All columns must have the same number of values");
+      return FAILURE;
     }
 
-    if (single && cass_result_has_more_pages(result)) {
-      rows->statement = php_driver_new_ref(single, free_statement);
-      rows->result    = php_driver_new_ref((void *)result, free_result);
-      rows->session   = php_driver_add_ref(self->session);
-      return;
+    column->values = Z_ARRVAL_P(values);
+    zend_hash_internal_pointer_reset_ex(column->values, &column->pos);
+    column->name = NULL;
+    column->index = index;
+    column->data_type = NULL;
+
+    if (name && php_driver_bind_parameter_index(prepared, name, &column->index) == FAILURE) {
+      column->name = name;
+      column->data_type =
+        cass_prepared_parameter_data_type_by_name_n(prepared->data.prepared.prepared,
+                                                    ZSTR_VAL(name), ZSTR_LEN(name));
+      if (!column->data_type) {
+        zend_throw_exception_ex(php_driver_invalid_argument_exception_ce, 0,
+                                "Unknown parameter \"%s\"", ZSTR_VAL(name));
+        return FAILURE;
+      }
+    } else if (column->index < prepared->data.prepared.param_count) {
+      column->data_type = prepared->data.prepared.param_types[column->index];
+    } else {
+      zend_throw_exception_ex(php_driver_invalid_argument_exception_ce, 0,
+                              "Unknown parameter %lu", (unsigned long) column->index);
+      return FAILURE;
     }
+  } ZEND_HASH_FOREACH_END();
+
+  return SUCCESS;
+}
+
+/* Binds the next value of every column; all columns move on even when
+ * binding fails so that the following rows stay aligned */
+static int
+bind_bulk_row(CassStatement *statement, bulk_column *columns, size_t count)
+{
+  int rc = SUCCESS;
+  size_t i;
+
+  for (i = 0; i < count; i++) {
+    bulk_column *column = &columns[i];
+    zval *value = zend_hash_get_current_data_ex(column->values, &column->pos);
+
+    zend_hash_move_forward_ex(column->values, &column->pos);
+
+    if (rc == FAILURE)
+      continue;
 
-    cass_result_free(result);
-  } while (0);
+    ZVAL_DEREF(value);
+    if (column->name) {
+      rc = php_driver_bind_argument_by_name(statement, column->data_type,
+                                            ZSTR_VAL(column->name), value);
+    } else {
+      rc = php_driver_bind_argument_by_index(statement, column->data_type,
+                                             column->index, value);
+    }
+  }
 
-  if (batch)
-    cass_batch_free(batch);
+  if (rc == FAILURE && !EG(exception)) {
+    zend_throw_exception_ex(php_driver_invalid_argument_exception_ce, 0,
+                            "Unable to bind the values of the row");
+  }
 
-  if (single)
-    cass_statement_free(single);
+  return rc;
 }
 
-PHP_METHOD(DefaultSession, executeAsync)
+PHP_METHOD(DefaultSession, executeColumns)
 {
   zval *statement = NULL;
+  zval *columns = NULL;
+  zend_long concurrency = 0;
   zval *options = NULL;
   php_driver_session *self = NULL;
-  php_driver_statement *stmt = NULL;
-  php_driver_statement simple_statement;
-  HashTable *arguments = NULL;
-  CassConsistency consistency = PHP_DRIVER_DEFAULT_CONSISTENCY;
-  int page_size = -1;
-  char *paging_state_token = NULL;
-  size_t paging_state_token_size = 0;
-  long serial_consistency = -1;
-  CassRetryPolicy *retry_policy = NULL;
-  cass_int64_t timestamp = INT64_MIN;
-  php_driver_execution_options *opts = NULL;
+  php_driver_statement *prepared = NULL;
   php_driver_execution_options local_opts;
-  php_driver_future_rows *future_rows = NULL;
-  CassStatement *single = NULL;
-  CassBatch *batch  = NULL;
-
-  if (zend_parse_parameters(ZEND_NUM_ARGS(), "z|z", &statement, &options) == FAILURE) {
+  execute_options opts;
+  bulk_column *bulk_columns = NULL;
+  size_t column_count;
+  bulk_slot *slots = NULL;
+  size_t window, created = 0, in_flight = 0;
+  php_driver_future_queue *queue = NULL;
+  zend_ulong rows = 0, row = 0;
+
+  if (zend_parse_parameters(ZEND_NUM_ARGS(), "Oal|z", &statement, php_driver_prepared_statement_ce,
+                            &columns, &concurrency, &options) == FAILURE) {
     return;
   }
 
   self = PHP_DRIVER_GET_SESSION(getThis());
+  prepared = PHP_DRIVER_GET_STATEMENT(statement);
 
-  if (Z_TYPE_P(statement) == IS_STRING) {
-    simple_statement.type = PHP_DRIVER_SIMPLE_STATEMENT;
-    simple_statement.data.simple.cql = Z_STRVAL_P(statement);
-    stmt = &simple_statement;
-  } else if (Z_TYPE_P(statement) == IS_OBJECT &&
-             instanceof_function(Z_OBJCE_P(statement), php_driver_statement_ce)) {
-    stmt = PHP_DRIVER_GET_STATEMENT(statement);
-  } else {
-    INVALID_ARGUMENT(statement, "a string or an instance of " PHP_DRIVER_NAMESPACE "\\Statement");
+  column_count = zend_hash_num_elements(Z_ARRVAL_P(columns));
+  if (column_count == 0) {
+    INVALID_ARGUMENT(columns, "an array of columns");
   }
 
-  consistency = self->default_consistency;
-  page_size = self->default_page_size;
+  if (concurrency < 1 || concurrency > PHP_DRIVER_MAX_CONCURRENCY) {
+    zval value;
+    ZVAL_LONG(&value, concurrency);
+    throw_invalid_argument(&value, "concurrency",
+                           "a number of requests between 1 and "
+                           ZEND_TOSTR(PHP_DRIVER_MAX_CONCURRENCY));
+    return;
+  }
 
-  if (options) {
-    if (Z_TYPE_P(options) != IS_ARRAY &&
-        (Z_TYPE_P(options) != IS_OBJECT || !instanceof_function(Z_OBJCE_P(options), php_driver_execution_options_ce))) {
-      INVALID_ARGUMENT(options, "an instance of " PHP_DRIVER_NAMESPACE "\\ExecutionOptions or an array or null");
-    }
+  if (get_execute_options(self, options, &local_opts, &opts) == FAILURE)
+    return;
 
-    if (Z_TYPE_P(options) == IS_OBJECT) {
-      opts = PHP_DRIVER_GET_EXECUTION_OPTIONS(options);
-    } else {
-      if (php_driver_execution_options_build_local_from_array(&local_opts, options) == FAILURE) {
-        return;
-      }
-      opts = &local_opts;
-    }
+  bulk_columns = ecalloc(column_count, sizeof(bulk_column));
+  if (get_bulk_columns(prepared, Z_ARRVAL_P(columns), bulk_columns, &rows) == FAILURE) {
+    efree(bulk_columns);
+    return;
+  }
 
-    if (!Z_ISUNDEF(opts->arguments))
-      arguments = Z_ARRVAL(opts->arguments);
+  window = (size_t) concurrency < rows ? (size_t) concurrency : rows;
+  if (window == 0) {
+    efree(bulk_columns);
+    array_init(return_value);
+    return;
+  }
 
-    if (opts->consistency >= 0)
-      consistency = (CassConsistency) opts->consistency;
+  slots = ecalloc(window, sizeof(bulk_slot));
+  queue = php_driver_future_queue_new(window);
 
-    if (opts->page_size >= 0)
-      page_size = opts->page_size;
+  array_init(return_value);
 
-    if (opts->paging_state_token) {
-      paging_state_token = opts->paging_state_token;
-      paging_state_token_size = opts->paging_state_token_size;
-    }
+  while (row < rows || in_flight > 0) {
+    /* Busy slots come first, idle ones keep their statement for reuse */
+    while (row < rows && in_flight < window) {
+      bulk_slot *slot = &slots[in_flight];
+
+      if (!slot->statement) {
+        CassError rc;
+
+        /* The arguments option holds values shared by every row */
+        slot->statement = create_statement(prepared, opts.arguments);
+        if (!slot->statement) {
+          if (!EG(exception)) {
+            zend_throw_exception_ex(php_driver_invalid_argument_exception_ce, 0,
+                                    "Unable to bind the arguments option");
+          }
+          break;
+        }
+        created++;
+
+        rc = set_statement_options(slot->statement, &opts);
+        if (rc != CASS_OK) {
+          zend_throw_exception_ex(exception_class(rc), rc,
+                                  "%s", cass_error_desc(rc));
+          break;
+        }
+      }
 
-    if (opts->serial_consistency >= 0)
-      serial_consistency = opts->serial_consistency;
+      slot->row = row++;
 
-    if (!Z_ISUNDEF(opts->retry_policy))
-      retry_policy = (PHP_DRIVER_GET_RETRY_POLICY(&(opts->retry_policy)))->policy;
+      if (bind_bulk_row(slot->statement, bulk_columns, column_count) == FAILURE) {
+        zval exception;
+        take_exception(&exception);
+        zend_hash_index_update(Z_ARRVAL_P(return_value), slot->row, &exception);
+        continue;
+      }
 
-    timestamp = opts->timestamp;
-  }
+      /* Rows that can't get a slot fail like rows that can't be bound */
+      if (self->throttle && php_driver_throttle_acquire(self->throttle) == FAILURE) {
+        zval exception;
+        take_exception(&exception);
+        zend_hash_index_update(Z_ARRVAL_P(return_value), slot->row, &exception);
+        continue;
+      }
 
-  object_init_ex(return_value, php_driver_future_rows_ce);
-  future_rows = PHP_DRIVER_GET_FUTURE_ROWS(return_value);
+      slot->future = cass_session_execute((CassSession *) self->session->data,
+                                          slot->statement);
+      if (self->throttle)
+        php_driver_throttle_track(self->throttle, slot->future);
 
-  switch (stmt->type) {
-    case PHP_DRIVER_SIMPLE_STATEMENT:
-    case PHP_DRIVER_PREPARED_STATEMENT:
-      single = create_single(stmt, arguments, consistency,
-                             serial_consistency, page_size,
-                             paging_state_token, paging_state_token_size,
-                             retry_policy, timestamp);
+      if (php_driver_future_queue_add(queue, slot->future) == FAILURE)
+        break;
 
-      if (!single)
-        return;
+      in_flight++;
+    }
 
-      future_rows->statement = php_driver_new_ref(single, free_statement);
-      future_rows->future    = cass_session_execute((CassSession *) self->session->data, single);
-      future_rows->session   = php_driver_add_ref(self->session);
+    if (EG(exception))
       break;
-    case PHP_DRIVER_BATCH_STATEMENT:
-      batch = create_batch(stmt, consistency, retry_policy, timestamp);
 
-      if (!batch)
-        return;
+    if (in_flight > 0) {
+      CassFuture *future;
+      bulk_slot done;
+      zval exception;
+      size_t i;
 
-      future_rows->future = cass_session_execute_batch((CassSession *) self->session->data, batch);
-      cass_batch_free(batch);
-      break;
-    default:
-      INVALID_ARGUMENT(statement,
-        "an instance of " PHP_DRIVER_NAMESPACE "\\SimpleStatement, " \
-        PHP_DRIVER_NAMESPACE "\\PreparedStatement or " PHP_DRIVER_NAMESPACE "\\BatchStatement"
-      );
-      return;
+      if (php_driver_future_queue_next(queue, opts.timeout, &future) == FAILURE)
+        break;
+
+      for (i = 0; i < in_flight; i++) {
+        if (slots[i].future == future)
+          break;
+      }
+
+      php_driver_future_error(future, &exception);
+      if (!Z_ISUNDEF(exception))
+        zend_hash_index_update(Z_ARRVAL_P(return_value), slots[i].row, &exception);
+
+      /* The request is complete, its statement can be bound again */
+      cass_future_free(future);
+      done = slots[i];
+      done.future = NULL;
+      slots[i] = slots[--in_flight];
+      slots[in_flight] = done;
+    }
+  }
+
+  /* Statements of abandoned requests are kept alive by the driver */
+  for (; created > 0; created--) {
+    bulk_slot *slot = &slots[created - 1];
+    if (slot->future)
+      cass_future_free(slot->future);
+    if (slot->statement)
+      cass_statement_free(slot->statement);
   }
+
+  php_driver_future_queue_free(queue);
+  efree(slots);
+  efree(bulk_columns);
 }
 
 PHP_METHOD(DefaultSession, prepare)
@@ -834,6 +1793,19 @@ PHP_METHOD(DefaultSession, prepare)
     timeout = &(opts->timeout);
   }
 
+  if (self->prepared_cache) {
+    php_driver_ref *cached =
+      php_driver_prepared_cache_find(self->prepared_cache,
+                                     (CassSession *) self->session->data,
+                                     Z_STRVAL_P(cql), Z_STRLEN_P(cql));
+    if (cached) {
+      object_init_ex(return_value, php_driver_prepared_statement_ce);
+      prepared_statement = PHP_DRIVER_GET_STATEMENT(return_value);
+      php_driver_prepared_statement_init_cached(prepared_statement, cached, Z_STR_P(cql));
+      return;
+    }
+  }
+
   future = cass_session_prepare_n((CassSession *)self->session->data,
                                   Z_STRVAL_P(cql), Z_STRLEN_P(cql));
 
@@ -841,7 +1813,17 @@ PHP_METHOD(DefaultSession, prepare)
       php_driver_future_is_error(future) == SUCCESS) {
     object_init_ex(return_value, php_driver_prepared_statement_ce);
     prepared_statement = PHP_DRIVER_GET_STATEMENT(return_value);
-    prepared_statement->data.prepared.prepared = cass_future_get_prepared(future);
+    if (self->prepared_cache) {
+      php_driver_prepared_statement_init_cached(prepared_statement,
+        php_driver_prepared_cache_add(self->prepared_cache,
+                                      Z_STRVAL_P(cql), Z_STRLEN_P(cql),
+                                      cass_future_get_prepared(future)),
+        Z_STR_P(cql));
+    } else {
+      php_driver_prepared_statement_init(prepared_statement,
+                                         cass_future_get_prepared(future),
+                                         Z_STR_P(cql));
+    }
   }
 
   cass_future_free(future);
@@ -861,12 +1843,30 @@ PHP_METHOD(DefaultSession, prepareAsync)
 
   self = PHP_DRIVER_GET_SESSION(getThis());
 
-  future = cass_session_prepare_n((CassSession *)self->session->data,
-                                  Z_STRVAL_P(cql), Z_STRLEN_P(cql));
-
   object_init_ex(return_value, php_driver_future_prepared_statement_ce);
   future_prepared = PHP_DRIVER_GET_FUTURE_PREPARED_STATEMENT(return_value);
 
+  if (self->prepared_cache) {
+    php_driver_ref *cached =
+      php_driver_prepared_cache_find(self->prepared_cache,
+                                     (CassSession *) self->session->data,
+                                     Z_STRVAL_P(cql), Z_STRLEN_P(cql));
+    if (cached) {
+      /* The future resolves immediately without a round trip */
+      object_init_ex(&future_prepared->prepared_statement, php_driver_prepared_statement_ce);
+      php_driver_prepared_statement_init_cached(
+        PHP_DRIVER_GET_STATEMENT(&future_prepared->prepared_statement), cached, Z_STR_P(cql));
+      return;
+    }
+
+    future_prepared->prepared_cache = php_driver_add_ref(self->prepared_cache);
+  }
+
+  future_prepared->cql = zend_string_copy(Z_STR_P(cql));
+
+  future = cass_session_prepare_n((CassSession *)self->session->data,
+                                  Z_STRVAL_P(cql), Z_STRLEN_P(cql));
+
   future_prepared->future = future;
 }
 
@@ -916,18 +1916,38 @@ PHP_METHOD(DefaultSession, closeAsync)
   future->future = cass_session_close((CassSession *) self->session->data);
 }
 
+PHP_METHOD(DefaultSession, runCallbacks)
+{
+  zend_bool wait = 1;
+  zend_long count;
+
+  if (zend_parse_parameters(ZEND_NUM_ARGS(), "|b", &wait) == FAILURE) {
+    return;
+  }
+
+  if (php_driver_callbacks_run(wait, &count) == FAILURE) {
+    return;
+  }
+
+  RETURN_LONG(count);
+}
+
 PHP_METHOD(DefaultSession, metrics)
 {
   CassMetrics metrics;
+  CassSpeculativeExecutionMetrics speculative;
   zval requests;
   zval stats;
   zval errors;
+  zval speculative_executions;
   php_driver_session *self = PHP_DRIVER_GET_SESSION(getThis());
 
   if (zend_parse_parameters_none() == FAILURE)
     return;
 
   cass_session_get_metrics((CassSession *)self->session->data, &metrics);
+  cass_session_get_speculative_execution_metrics((CassSession *)self->session->data,
+                                                 &speculative);
 
 
   array_init(&(requests));
@@ -1001,10 +2021,50 @@ PHP_METHOD(DefaultSession, metrics)
                  "request_timeouts",
                  metrics.errors.request_timeouts);
 
+
+  array_init(&(speculative_executions));
+  add_assoc_long(&(speculative_executions),
+                 "min",
+                 speculative.min);
+  add_assoc_long(&(speculative_executions),
+                 "max",
+                 speculative.max);
+  add_assoc_long(&(speculative_executions),
+                 "mean",
+                 speculative.mean);
+  add_assoc_long(&(speculative_executions),
+                 "stddev",
+                 speculative.stddev);
+  add_assoc_long(&(speculative_executions),
+                 "median",
+                 speculative.median);
+  add_assoc_long(&(speculative_executions),
+                 "p75",
+                 speculative.percentile_75th);
+  add_assoc_long(&(speculative_executions),
+                 "p95",
+                 speculative.percentile_95th);
+  add_assoc_long(&(speculative_executions),
+                 "p98",
+                 speculative.percentile_98th);
+  add_assoc_long(&(speculative_executions),
+                 "p99",
+                 speculative.percentile_99th);
+  add_assoc_long(&(speculative_executions),
+                 "p999",
+                 speculative.percentile_999th);
+  add_assoc_long(&(speculative_executions),
+                 "count",
+                 speculative.count);
+  add_assoc_double(&(speculative_executions),
+                   "percentage",
+                   speculative.percentage);
+
   array_init(return_value);
   add_assoc_zval(return_value, "stats", &(stats));
   add_assoc_zval(return_value, "requests", &(requests));
   add_assoc_zval(return_value, "errors", &(errors));
+  add_assoc_zval(return_value, "speculative_executions", &(speculative_executions));
 }
 
 PHP_METHOD(DefaultSession, schema)
@@ -1030,6 +2090,20 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_execute, 0, ZEND_RETURN_VALUE, 1)
   ZEND_ARG_INFO(0, options)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_execute_concurrent, 0, ZEND_RETURN_VALUE, 2)
+  ZEND_ARG_INFO(0, statements)
+  ZEND_ARG_INFO(0, concurrency)
+  ZEND_ARG_INFO(0, statement)
+  ZEND_ARG_INFO(0, options)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_execute_columns, 0, ZEND_RETURN_VALUE, 3)
+  PHP_DRIVER_NAMESPACE_ZEND_ARG_OBJ_INFO(0, statement, PreparedStatement, 0)
+  ZEND_ARG_ARRAY_INFO(0, columns, 0)
+  ZEND_ARG_INFO(0, concurrency)
+  ZEND_ARG_INFO(0, options)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_prepare, 0, ZEND_RETURN_VALUE, 1)
   ZEND_ARG_INFO(0, cql)
   ZEND_ARG_INFO(0, options)
@@ -1042,13 +2116,24 @@ ZEND_END_ARG_INFO()
 ZEND_BEGIN_ARG_INFO_EX(arginfo_none, 0, ZEND_RETURN_VALUE, 0)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_run_callbacks, 0, ZEND_RETURN_VALUE, 0)
+  ZEND_ARG_INFO(0, wait)
+ZEND_END_ARG_INFO()
+
 static zend_function_entry php_driver_default_session_methods[] = {
   PHP_ME(DefaultSession, execute, arginfo_execute, ZEND_ACC_PUBLIC)
   PHP_ME(DefaultSession, executeAsync, arginfo_execute, ZEND_ACC_PUBLIC)
+  PHP_ME(DefaultSession, executeDetached, arginfo_execute, ZEND_ACC_PUBLIC)
+  PHP_ME(DefaultSession, detachedErrors, arginfo_none, ZEND_ACC_PUBLIC)
+  PHP_ME(DefaultSession, defer, arginfo_execute, ZEND_ACC_PUBLIC)
+  PHP_ME(DefaultSession, flushDeferred, arginfo_none, ZEND_ACC_PUBLIC)
+  PHP_ME(DefaultSession, executeConcurrent, arginfo_execute_concurrent, ZEND_ACC_PUBLIC)
+  PHP_ME(DefaultSession, executeColumns, arginfo_execute_columns, ZEND_ACC_PUBLIC)
   PHP_ME(DefaultSession, prepare, arginfo_prepare, ZEND_ACC_PUBLIC)
   PHP_ME(DefaultSession, prepareAsync, arginfo_prepare, ZEND_ACC_PUBLIC)
   PHP_ME(DefaultSession, close, arginfo_timeout, ZEND_ACC_PUBLIC)
   PHP_ME(DefaultSession, closeAsync, arginfo_none, ZEND_ACC_PUBLIC)
+  PHP_ME(DefaultSession, runCallbacks, arginfo_run_callbacks, ZEND_ACC_PUBLIC)
   PHP_ME(DefaultSession, metrics, arginfo_none, ZEND_ACC_PUBLIC)
   PHP_ME(DefaultSession, schema, arginfo_none, ZEND_ACC_PUBLIC)
   PHP_FE_END
@@ -1070,7 +2155,14 @@ php_driver_default_session_free(zend_object *object)
   php_driver_session *self = php_driver_session_object_fetch(object);;
 
   php_driver_del_peref(&self->session, 1);
+  php_driver_del_peref(&self->prepared_cache, 1);
+  php_driver_detached_free(self->detached);
+  php_driver_throttle_free(self->throttle);
   CASS_ZVAL_MAYBE_DESTROY(self->default_timeout);
+  CASS_ZVAL_MAYBE_DESTROY(self->execution_profiles);
+
+  if (self->keyspace)
+    zend_string_release(self->keyspace);
 
   zend_object_std_dtor(&self->zval);
 
@@ -1083,10 +2175,15 @@ php_driver_default_session_new(zend_class_entry *ce)
       CASS_ZEND_OBJECT_ECALLOC(session, ce);
 
   self->session             = NULL;
+  self->prepared_cache      = NULL;
   self->persist             = 0;
+  self->detached            = NULL;
+  self->throttle            = NULL;
+  self->keyspace            = NULL;
   self->default_consistency = PHP_DRIVER_DEFAULT_CONSISTENCY;
   self->default_page_size   = 5000;
   ZVAL_UNDEF(&(self->default_timeout));
+  ZVAL_UNDEF(&(self->execution_profiles));
 
   CASS_ZEND_OBJECT_INIT_EX(session, default_session, self, ce);
 }
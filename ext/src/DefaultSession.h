@@ -0,0 +1,33 @@
+/**
+ * Copyright 2015-2017 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PHP_DRIVER_DEFAULT_SESSION_H
+#define PHP_DRIVER_DEFAULT_SESSION_H
+
+/* Sends the writes buffered by Session::defer() and waits for them */
+void
+php_driver_default_session_flush_deferred(int shutdown);
+
+/* Returns whether writes are buffered by Session::defer() */
+int
+php_driver_default_session_has_deferred();
+
+/* Finishes the response where the SAPI allows, so the client doesn't wait
+ * for the work left at the end of the request */
+void
+php_driver_default_session_finish_response();
+
+#endif /* PHP_DRIVER_DEFAULT_SESSION_H */
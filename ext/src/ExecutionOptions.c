@@ -29,9 +29,12 @@ static void init_execution_options(php_driver_execution_options *self)
   self->paging_state_token = NULL;
   self->paging_state_token_size = 0;
   self->timestamp = INT64_MIN;
+  self->is_idempotent = -1;
+  self->fetch_scalars = -1;
   ZVAL_UNDEF(&(self->arguments));
   ZVAL_UNDEF(&(self->timeout));
   ZVAL_UNDEF(&(self->retry_policy));
+  ZVAL_UNDEF(&(self->execution_profile));
 }
 
 static int build_from_array(php_driver_execution_options *self, zval *options, int copy)
@@ -44,6 +47,9 @@ static int build_from_array(php_driver_execution_options *self, zval *options, i
   zval *arguments = NULL;
   zval *retry_policy = NULL;
   zval *timestamp = NULL;
+  zval *is_idempotent = NULL;
+  zval *fetch_scalars = NULL;
+  zval *execution_profile = NULL;
 
   if (CASS_ZEND_HASH_FIND(Z_ARRVAL_P(options), "consistency", sizeof("consistency"), consistency)) {
     if (php_driver_get_consistency(consistency, &self->consistency) == FAILURE) {
@@ -138,6 +144,35 @@ static int build_from_array(php_driver_execution_options *self, zval *options, i
       return FAILURE;
     }
   }
+
+  if (CASS_ZEND_HASH_FIND(Z_ARRVAL_P(options), "is_idempotent", sizeof("is_idempotent"), is_idempotent)) {
+    if (Z_TYPE_P(is_idempotent) != IS_TRUE && Z_TYPE_P(is_idempotent) != IS_FALSE) {
+      throw_invalid_argument(is_idempotent, "is_idempotent", "a boolean");
+      return FAILURE;
+    }
+    self->is_idempotent = Z_TYPE_P(is_idempotent) == IS_TRUE;
+  }
+
+  if (CASS_ZEND_HASH_FIND(Z_ARRVAL_P(options), "fetch_scalars", sizeof("fetch_scalars"), fetch_scalars)) {
+    if (Z_TYPE_P(fetch_scalars) != IS_TRUE && Z_TYPE_P(fetch_scalars) != IS_FALSE) {
+      throw_invalid_argument(fetch_scalars, "fetch_scalars", "a boolean");
+      return FAILURE;
+    }
+    self->fetch_scalars = Z_TYPE_P(fetch_scalars) == IS_TRUE;
+  }
+
+  if (CASS_ZEND_HASH_FIND(Z_ARRVAL_P(options), "execution_profile", sizeof("execution_profile"), execution_profile)) {
+    if (Z_TYPE_P(execution_profile) != IS_STRING) {
+      throw_invalid_argument(execution_profile, "execution_profile", "a string");
+      return FAILURE;
+    }
+
+    if (copy) {
+      ZVAL_COPY(&(self->execution_profile), execution_profile);
+    } else {
+      self->execution_profile = *execution_profile;
+    }
+  }
   return SUCCESS;
 }
 
@@ -147,6 +182,11 @@ int php_driver_execution_options_build_local_from_array(php_driver_execution_opt
   return build_from_array(self, options, 0);
 }
 
+int php_driver_execution_options_build_from_array(php_driver_execution_options *self, zval *options)
+{
+  return build_from_array(self, options, 1);
+}
+
 PHP_METHOD(ExecutionOptions, __construct)
 {
   zval *options = NULL;
@@ -228,6 +268,21 @@ PHP_METHOD(ExecutionOptions, __get)
 #endif
     RETVAL_STRING(string);
     efree(string);
+  } else if (name_len == 12 && strncmp("isIdempotent", name, name_len) == 0) {
+    if (self->is_idempotent == -1) {
+      RETURN_NULL();
+    }
+    RETURN_BOOL(self->is_idempotent);
+  } else if (name_len == 12 && strncmp("fetchScalars", name, name_len) == 0) {
+    if (self->fetch_scalars == -1) {
+      RETURN_NULL();
+    }
+    RETURN_BOOL(self->fetch_scalars);
+  } else if (name_len == 16 && strncmp("executionProfile", name, name_len) == 0) {
+    if (Z_ISUNDEF(self->execution_profile)) {
+      RETURN_NULL();
+    }
+    RETURN_ZVAL(&(self->execution_profile), 1, 0);
   }
 }
 
@@ -267,6 +322,7 @@ php_driver_execution_options_free(zend_object *object)
   CASS_ZVAL_MAYBE_DESTROY(self->arguments);
   CASS_ZVAL_MAYBE_DESTROY(self->timeout);
   CASS_ZVAL_MAYBE_DESTROY(self->retry_policy);
+  CASS_ZVAL_MAYBE_DESTROY(self->execution_profile);
 
   zend_object_std_dtor(&self->zval);
 
@@ -2,5 +2,7 @@
 #define PHP_DRIVER_EXECUTION_OPTIONS_H
 
 int php_driver_execution_options_build_local_from_array(php_driver_execution_options *self, zval *options);
+/* Same as above but the options keep their own copies of the values */
+int php_driver_execution_options_build_from_array(php_driver_execution_options *self, zval *options);
 
 #endif
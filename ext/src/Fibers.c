@@ -0,0 +1,50 @@
+/**
+ * Copyright 2015-2017 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "php_driver.h"
+#include "php_driver_types.h"
+#include "util/fiber.h"
+
+zend_class_entry *php_driver_fibers_ce = NULL;
+
+PHP_METHOD(Fibers, run)
+{
+  zval *tasks = NULL;
+
+  if (zend_parse_parameters(ZEND_NUM_ARGS(), "a", &tasks) == FAILURE) {
+    return;
+  }
+
+  php_driver_fiber_run(Z_ARRVAL_P(tasks), return_value);
+}
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_run, 0, ZEND_RETURN_VALUE, 1)
+  ZEND_ARG_ARRAY_INFO(0, tasks, 0)
+ZEND_END_ARG_INFO()
+
+static zend_function_entry php_driver_fibers_methods[] = {
+  PHP_ME(Fibers, run, arginfo_run, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+  PHP_FE_END
+};
+
+void php_driver_define_Fibers()
+{
+  zend_class_entry ce;
+
+  INIT_CLASS_ENTRY(ce, PHP_DRIVER_NAMESPACE "\\Fibers", php_driver_fibers_methods);
+  php_driver_fibers_ce = zend_register_internal_class(&ce);
+  php_driver_fibers_ce->ce_flags |= ZEND_ACC_FINAL;
+}
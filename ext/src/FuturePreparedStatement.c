@@ -16,7 +16,11 @@
 
 #include "php_driver.h"
 #include "php_driver_types.h"
+#include "util/callback.h"
 #include "util/future.h"
+#include "util/prepared_cache.h"
+#include "util/ref.h"
+#include "PreparedStatement.h"
 
 zend_class_entry *php_driver_future_prepared_statement_ce = NULL;
 
@@ -43,20 +47,41 @@ PHP_METHOD(FuturePreparedStatement, get)
     return;
   }
 
-  object_init_ex(return_value, php_driver_statement_ce);
+  object_init_ex(return_value, php_driver_prepared_statement_ce);
   ZVAL_COPY(&(self->prepared_statement), return_value);
 
   prepared_statement = PHP_DRIVER_GET_STATEMENT(return_value);
 
-  prepared_statement->data.prepared.prepared = cass_future_get_prepared(self->future);
+  if (self->prepared_cache) {
+    php_driver_prepared_statement_init_cached(prepared_statement,
+      php_driver_prepared_cache_add(self->prepared_cache,
+                                    ZSTR_VAL(self->cql), ZSTR_LEN(self->cql),
+                                    cass_future_get_prepared(self->future)),
+      self->cql);
+  } else {
+    php_driver_prepared_statement_init(prepared_statement,
+                                       cass_future_get_prepared(self->future),
+                                       self->cql);
+  }
+}
+
+PHP_METHOD(FuturePreparedStatement, then)
+{
+  php_driver_future_then(INTERNAL_FUNCTION_PARAM_PASSTHRU);
 }
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_timeout, 0, ZEND_RETURN_VALUE, 0)
   ZEND_ARG_INFO(0, timeout)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_then, 0, ZEND_RETURN_VALUE, 1)
+  ZEND_ARG_CALLABLE_INFO(0, onSuccess, 0)
+  ZEND_ARG_CALLABLE_INFO(0, onError, 1)
+ZEND_END_ARG_INFO()
+
 static zend_function_entry php_driver_future_prepared_statement_methods[] = {
   PHP_ME(FuturePreparedStatement, get, arginfo_timeout, ZEND_ACC_PUBLIC)
+  PHP_ME(FuturePreparedStatement, then, arginfo_then, ZEND_ACC_PUBLIC)
   PHP_FE_END
 };
 
@@ -83,6 +108,10 @@ php_driver_future_prepared_statement_free(zend_object *object)
 
   CASS_ZVAL_MAYBE_DESTROY(self->prepared_statement);
 
+  php_driver_del_peref(&self->prepared_cache, 1);
+  if (self->cql)
+    zend_string_release(self->cql);
+
   zend_object_std_dtor(&self->zval);
 
 }
@@ -94,6 +123,8 @@ php_driver_future_prepared_statement_new(zend_class_entry *ce)
       CASS_ZEND_OBJECT_ECALLOC(future_prepared_statement, ce);
 
   self->future = NULL;
+  self->prepared_cache = NULL;
+  self->cql = NULL;
   ZVAL_UNDEF(&(self->prepared_statement));
 
   CASS_ZEND_OBJECT_INIT(future_prepared_statement, self, ce);
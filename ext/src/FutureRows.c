@@ -16,10 +16,13 @@
 
 #include "php_driver.h"
 #include "php_driver_types.h"
+#include "util/callback.h"
 #include "util/future.h"
 #include "util/result.h"
 #include "util/ref.h"
 
+#include "Rows.h"
+
 zend_class_entry *php_driver_future_rows_ce = NULL;
 
 static void
@@ -70,20 +73,10 @@ PHP_METHOD(FutureRows, get)
     return;
   }
 
-  if (Z_ISUNDEF(self->rows)) {
-    if (php_driver_get_result((const CassResult *) self->result->data,
-                                 &self->rows) == FAILURE) {
-      CASS_ZVAL_MAYBE_DESTROY(self->rows);
-      return;
-    }
-  }
-
-  object_init_ex(return_value, php_driver_rows_ce);
+  php_driver_rows_create_page(return_value, self->result, self->columns_cache,
+                              self->fetch_scalars);
   rows = PHP_DRIVER_GET_ROWS(return_value);
 
-  ZVAL_COPY(&(rows->rows),
-                    &(self->rows));
-
   if (cass_result_has_more_pages((const CassResult *)self->result->data)) {
     rows->session   = php_driver_add_ref(self->session);
     rows->statement = php_driver_add_ref(self->statement);
@@ -91,12 +84,23 @@ PHP_METHOD(FutureRows, get)
   }
 }
 
+PHP_METHOD(FutureRows, then)
+{
+  php_driver_future_then(INTERNAL_FUNCTION_PARAM_PASSTHRU);
+}
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_timeout, 0, ZEND_RETURN_VALUE, 0)
   ZEND_ARG_INFO(0, timeout)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_then, 0, ZEND_RETURN_VALUE, 1)
+  ZEND_ARG_CALLABLE_INFO(0, onSuccess, 0)
+  ZEND_ARG_CALLABLE_INFO(0, onError, 1)
+ZEND_END_ARG_INFO()
+
 static zend_function_entry php_driver_future_rows_methods[] = {
   PHP_ME(FutureRows, get, arginfo_timeout, ZEND_ACC_PUBLIC)
+  PHP_ME(FutureRows, then, arginfo_then, ZEND_ACC_PUBLIC)
   PHP_FE_END
 };
 
@@ -115,11 +119,10 @@ php_driver_future_rows_free(zend_object *object)
 {
   php_driver_future_rows *self = php_driver_future_rows_object_fetch(object);;
 
-  CASS_ZVAL_MAYBE_DESTROY(self->rows);
-
   php_driver_del_ref(&self->statement);
   php_driver_del_peref(&self->session, 1);
   php_driver_del_ref(&self->result);
+  php_driver_del_ref(&self->columns_cache);
 
   if (self->future) {
     cass_future_free(self->future);
@@ -139,7 +142,8 @@ php_driver_future_rows_new(zend_class_entry *ce)
   self->statement = NULL;
   self->result    = NULL;
   self->session   = NULL;
-  ZVAL_UNDEF(&(self->rows));
+  self->columns_cache = NULL;
+  self->fetch_scalars = cass_false;
 
   CASS_ZEND_OBJECT_INIT(future_rows, self, ce);
 }
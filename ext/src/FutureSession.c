@@ -17,8 +17,10 @@
 #include "php_driver.h"
 #include "php_driver_globals.h"
 #include "php_driver_types.h"
+#include "util/callback.h"
 #include "util/future.h"
 #include "util/ref.h"
+#include "util/throttle.h"
 
 zend_class_entry *php_driver_future_session_ce = NULL;
 
@@ -50,6 +52,14 @@ PHP_METHOD(FutureSession, get)
 
   session->session = php_driver_add_ref(self->session);
   session->persist = self->persist;
+  if (self->prepared_cache)
+    session->prepared_cache = php_driver_add_ref(self->prepared_cache);
+  if (self->throttle)
+    session->throttle = php_driver_throttle_add_ref(self->throttle);
+  if (!Z_ISUNDEF(self->execution_profiles))
+    ZVAL_COPY(&(session->execution_profiles), &(self->execution_profiles));
+  if (self->keyspace)
+    session->keyspace = zend_string_copy(self->keyspace);
 
   if (php_driver_future_wait_timed(self->future, timeout) == FAILURE) {
     return;
@@ -83,12 +93,23 @@ PHP_METHOD(FutureSession, get)
   ZVAL_COPY(&(self->default_session), return_value);
 }
 
+PHP_METHOD(FutureSession, then)
+{
+  php_driver_future_then(INTERNAL_FUNCTION_PARAM_PASSTHRU);
+}
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_timeout, 0, ZEND_RETURN_VALUE, 0)
   ZEND_ARG_INFO(0, timeout)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_then, 0, ZEND_RETURN_VALUE, 1)
+  ZEND_ARG_CALLABLE_INFO(0, onSuccess, 0)
+  ZEND_ARG_CALLABLE_INFO(0, onError, 1)
+ZEND_END_ARG_INFO()
+
 static zend_function_entry php_driver_future_session_methods[] = {
   PHP_ME(FutureSession, get, arginfo_timeout, ZEND_ACC_PUBLIC)
+  PHP_ME(FutureSession, then, arginfo_then, ZEND_ACC_PUBLIC)
   PHP_FE_END
 };
 
@@ -117,12 +138,18 @@ php_driver_future_session_free(zend_object *object)
   }
 
   php_driver_del_peref(&self->session, 1);
+  php_driver_del_peref(&self->prepared_cache, 1);
+  php_driver_throttle_free(self->throttle);
 
   if (self->exception_message) {
     efree(self->exception_message);
   }
 
+  if (self->keyspace)
+    zend_string_release(self->keyspace);
+
   CASS_ZVAL_MAYBE_DESTROY(self->default_session);
+  CASS_ZVAL_MAYBE_DESTROY(self->execution_profiles);
 
   zend_object_std_dtor(&self->zval);
 
@@ -135,12 +162,16 @@ php_driver_future_session_new(zend_class_entry *ce)
       = CASS_ZEND_OBJECT_ECALLOC(future_session, ce);
 
   self->session           = NULL;
+  self->prepared_cache    = NULL;
+  self->throttle          = NULL;
   self->future            = NULL;
   self->exception_message = NULL;
   self->hash_key          = NULL;
+  self->keyspace          = NULL;
   self->persist           = 0;
 
   ZVAL_UNDEF(&(self->default_session));
+  ZVAL_UNDEF(&(self->execution_profiles));
 
   CASS_ZEND_OBJECT_INIT(future_session, self, ce);
 }
@@ -0,0 +1,131 @@
+/**
+ * Copyright 2015-2017 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "php_driver.h"
+#include "php_driver_types.h"
+#include "util/future.h"
+
+zend_class_entry *php_driver_futures_ce = NULL;
+
+/* Collects the underlying futures of an array of Future instances */
+static CassFuture **
+get_handles(HashTable *futures)
+{
+  CassFuture **handles;
+  size_t i = 0;
+  zval *future;
+
+  handles = ecalloc(zend_hash_num_elements(futures) + 1, sizeof(CassFuture *));
+
+  ZEND_HASH_FOREACH_VAL(futures, future) {
+    ZVAL_DEREF(future);
+    if (Z_TYPE_P(future) != IS_OBJECT ||
+        php_driver_future_get_handle(future, &handles[i]) == FAILURE) {
+      efree(handles);
+      throw_invalid_argument(future, "future",
+                             "an instance of " PHP_DRIVER_NAMESPACE "\\FutureRows, " \
+                             PHP_DRIVER_NAMESPACE "\\FuturePreparedStatement, " \
+                             PHP_DRIVER_NAMESPACE "\\FutureSession, " \
+                             PHP_DRIVER_NAMESPACE "\\FutureClose or " \
+                             PHP_DRIVER_NAMESPACE "\\FutureValue");
+      return NULL;
+    }
+    i++;
+  } ZEND_HASH_FOREACH_END();
+
+  return handles;
+}
+
+PHP_METHOD(Futures, waitAll)
+{
+  zval *futures = NULL;
+  zval *timeout = NULL;
+  CassFuture **handles;
+
+  if (zend_parse_parameters(ZEND_NUM_ARGS(), "a|z", &futures, &timeout) == FAILURE) {
+    return;
+  }
+
+  handles = get_handles(Z_ARRVAL_P(futures));
+  if (!handles)
+    return;
+
+  php_driver_future_wait_many(handles, zend_hash_num_elements(Z_ARRVAL_P(futures)),
+                              zend_hash_num_elements(Z_ARRVAL_P(futures)), timeout);
+  efree(handles);
+}
+
+PHP_METHOD(Futures, waitAny)
+{
+  zval *futures = NULL;
+  zval *timeout = NULL;
+  CassFuture **handles;
+  zend_string *key;
+  zend_ulong index;
+  size_t i = 0;
+
+  if (zend_parse_parameters(ZEND_NUM_ARGS(), "a|z", &futures, &timeout) == FAILURE) {
+    return;
+  }
+
+  if (zend_hash_num_elements(Z_ARRVAL_P(futures)) == 0) {
+    INVALID_ARGUMENT(futures, "a non-empty array of futures");
+  }
+
+  handles = get_handles(Z_ARRVAL_P(futures));
+  if (!handles)
+    return;
+
+  if (php_driver_future_wait_many(handles, zend_hash_num_elements(Z_ARRVAL_P(futures)),
+                                  1, timeout) == FAILURE) {
+    efree(handles);
+    return;
+  }
+
+  ZEND_HASH_FOREACH_KEY(Z_ARRVAL_P(futures), index, key) {
+    if (!handles[i] || cass_future_ready(handles[i])) {
+      if (key) {
+        RETVAL_STR_COPY(key);
+      } else {
+        RETVAL_LONG(index);
+      }
+      break;
+    }
+    i++;
+  } ZEND_HASH_FOREACH_END();
+
+  efree(handles);
+}
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_wait, 0, ZEND_RETURN_VALUE, 1)
+  ZEND_ARG_ARRAY_INFO(0, futures, 0)
+  ZEND_ARG_INFO(0, timeout)
+ZEND_END_ARG_INFO()
+
+static zend_function_entry php_driver_futures_methods[] = {
+  PHP_ME(Futures, waitAll, arginfo_wait, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+  PHP_ME(Futures, waitAny, arginfo_wait, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+  PHP_FE_END
+};
+
+void php_driver_define_Futures()
+{
+  zend_class_entry ce;
+
+  INIT_CLASS_ENTRY(ce, PHP_DRIVER_NAMESPACE "\\Futures", php_driver_futures_methods);
+  php_driver_futures_ce = zend_register_internal_class(&ce);
+  php_driver_futures_ce->ce_flags |= ZEND_ACC_FINAL;
+}
@@ -16,18 +16,99 @@
 
 #include "php_driver.h"
 #include "php_driver_types.h"
+#include "util/ref.h"
+#include "util/result.h"
+#include "BoundStatement.h"
+#include "PreparedStatement.h"
 
 zend_class_entry *php_driver_prepared_statement_ce = NULL;
 
+void
+php_driver_prepared_statement_init(php_driver_statement *self, const CassPrepared *prepared,
+                                   zend_string *cql)
+{
+  size_t i, count = 0;
+
+  self->data.prepared.prepared = prepared;
+  self->data.prepared.cql      = zend_string_copy(cql);
+
+  while (cass_prepared_parameter_data_type(prepared, count))
+    count++;
+
+  if (count > 0) {
+    self->data.prepared.param_types = ecalloc(count, sizeof(const CassDataType *));
+    for (i = 0; i < count; i++)
+      self->data.prepared.param_types[i] = cass_prepared_parameter_data_type(prepared, i);
+
+    /* Names that occur more than once (e.g. "a > ? AND a < ?") have to bind
+     * every occurrence and are marked with -1 so they are bound by name */
+    ALLOC_HASHTABLE(self->data.prepared.param_names);
+    zend_hash_init(self->data.prepared.param_names, count, NULL, NULL, 0);
+    for (i = 0; i < count; i++) {
+      const char *name;
+      size_t name_length;
+      zval index;
+
+      if (cass_prepared_parameter_name(prepared, i, &name, &name_length) != CASS_OK)
+        continue;
+
+      if (zend_hash_str_exists(self->data.prepared.param_names, name, name_length)) {
+        ZVAL_LONG(&index, -1);
+      } else {
+        ZVAL_LONG(&index, i);
+      }
+      zend_hash_str_update(self->data.prepared.param_names, name, name_length, &index);
+    }
+  }
+  self->data.prepared.param_count = count;
+}
+
+void
+php_driver_prepared_statement_init_cached(php_driver_statement *self, php_driver_ref *cached,
+                                          zend_string *cql)
+{
+  self->data.prepared.cached = php_driver_add_ref(cached);
+  php_driver_prepared_statement_init(self, (const CassPrepared *) cached->data, cql);
+}
+
 PHP_METHOD(PreparedStatement, __construct)
 {
 }
 
+PHP_METHOD(PreparedStatement, bind)
+{
+  zval *arguments = NULL;
+  php_driver_statement *bound = NULL;
+
+  if (zend_parse_parameters(ZEND_NUM_ARGS(), "|a!", &arguments) == FAILURE) {
+    return;
+  }
+
+  object_init_ex(return_value, php_driver_bound_statement_ce);
+  bound = PHP_DRIVER_GET_STATEMENT(return_value);
+  ZVAL_COPY(&bound->data.bound.prepared, getThis());
+
+  if (arguments && php_driver_bound_statement_bind(bound, Z_ARRVAL_P(arguments)) == FAILURE) {
+    /* Don't hand out a statement that is only partially bound */
+    zval_ptr_dtor(return_value);
+    ZVAL_NULL(return_value);
+    if (!EG(exception)) {
+      zend_throw_exception_ex(php_driver_invalid_argument_exception_ce, 0,
+                              "Unable to bind the arguments");
+    }
+  }
+}
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_none, 0, ZEND_RETURN_VALUE, 0)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_bind, 0, ZEND_RETURN_VALUE, 0)
+  ZEND_ARG_ARRAY_INFO(0, arguments, 1)
+ZEND_END_ARG_INFO()
+
 static zend_function_entry php_driver_prepared_statement_methods[] = {
   PHP_ME(PreparedStatement, __construct, arginfo_none, ZEND_ACC_PRIVATE | ZEND_ACC_CTOR)
+  PHP_ME(PreparedStatement, bind, arginfo_bind, ZEND_ACC_PUBLIC)
   PHP_FE_END
 };
 
@@ -46,7 +127,25 @@ php_driver_prepared_statement_free(zend_object *object)
 {
   php_driver_statement *self = php_driver_statement_object_fetch(object);;
 
-  if (self->data.prepared.prepared)
+  if (self->data.prepared.param_types)
+    efree(self->data.prepared.param_types);
+
+  if (self->data.prepared.param_names) {
+    zend_hash_destroy(self->data.prepared.param_names);
+    FREE_HASHTABLE(self->data.prepared.param_names);
+  }
+
+  if (self->data.prepared.cql)
+    zend_string_release(self->data.prepared.cql);
+
+  if (self->data.prepared.partition_key)
+    efree(self->data.prepared.partition_key);
+
+  php_driver_del_ref(&self->data.prepared.columns_cache);
+
+  if (self->data.prepared.cached)
+    php_driver_del_peref(&self->data.prepared.cached, 1);
+  else if (self->data.prepared.prepared)
     cass_prepared_free(self->data.prepared.prepared);
 
   zend_object_std_dtor(&self->zval);
@@ -60,7 +159,17 @@ php_driver_prepared_statement_new(zend_class_entry *ce)
       CASS_ZEND_OBJECT_ECALLOC(statement, ce);
 
   self->type = PHP_DRIVER_PREPARED_STATEMENT;
-  self->data.prepared.prepared = NULL;
+  self->data.prepared.prepared    = NULL;
+  self->data.prepared.param_types = NULL;
+  self->data.prepared.param_count = 0;
+  self->data.prepared.param_names = NULL;
+  self->data.prepared.cached      = NULL;
+  self->data.prepared.cql         = NULL;
+
+  self->data.prepared.partition_key       = NULL;
+  self->data.prepared.partition_key_count = -1;
+
+  self->data.prepared.columns_cache = php_driver_columns_cache_new();
 
   CASS_ZEND_OBJECT_INIT_EX(statement, prepared_statement, self, ce);
 }
@@ -0,0 +1,30 @@
+/**
+ * Copyright 2015-2017 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PHP_DRIVER_PREPARED_STATEMENT_H
+#define PHP_DRIVER_PREPARED_STATEMENT_H
+
+/* Takes ownership of the prepared handle and caches its parameter types.
+ * The CQL is kept to find the table the statement writes to. */
+void
+php_driver_prepared_statement_init(php_driver_statement *self, const CassPrepared *prepared,
+                                   zend_string *cql);
+/* Shares a prepared handle owned by a persistent session's cache */
+void
+php_driver_prepared_statement_init_cached(php_driver_statement *self, php_driver_ref *cached,
+                                          zend_string *cql);
+
+#endif /* PHP_DRIVER_PREPARED_STATEMENT_H */
@@ -21,6 +21,7 @@
 #include "util/result.h"
 
 #include "FutureRows.h"
+#include "Rows.h"
 
 zend_class_entry *php_driver_rows_ce = NULL;
 
@@ -30,24 +31,33 @@ free_result(void *result)
   cass_result_free((CassResult *) result);
 }
 
+void
+php_driver_rows_create_page(zval *out, php_driver_ref *result,
+                            php_driver_ref *columns_cache,
+                            cass_bool_t fetch_scalars)
+{
+  php_driver_rows *rows;
+
+  object_init_ex(out, php_driver_rows_ce);
+  rows = PHP_DRIVER_GET_ROWS(out);
+
+  rows->page  = php_driver_add_ref(result);
+  rows->count = cass_result_row_count((const CassResult *) result->data);
+
+  rows->columns_cache = columns_cache
+                        ? php_driver_add_ref(columns_cache)
+                        : php_driver_columns_cache_new();
+  rows->fetch_scalars = fetch_scalars;
+}
+
 static void
 php_driver_rows_create(php_driver_rows *current, zval *result) {
   php_driver_rows *rows;
 
-  if (Z_ISUNDEF(current->next_rows)) {
-    if (php_driver_get_result((const CassResult *) current->next_result->data,
-                                 &current->next_rows) == FAILURE) {
-      CASS_ZVAL_MAYBE_DESTROY(current->next_rows);
-      return;
-    }
-  }
-
-  object_init_ex(result, php_driver_rows_ce);
+  php_driver_rows_create_page(result, current->next_result, current->columns_cache,
+                              current->fetch_scalars);
   rows = PHP_DRIVER_GET_ROWS(result);
 
-  ZVAL_COPY(&(rows->rows),
-                    &(current->next_rows));
-
   if (cass_result_has_more_pages((const CassResult *) current->next_result->data)) {
     rows->statement = php_driver_add_ref(current->statement);
     rows->session   = php_driver_add_ref(current->session);
@@ -55,6 +65,51 @@ php_driver_rows_create(php_driver_rows *current, zval *result) {
   }
 }
 
+/* Decodes the rows up to the position the first time it's read. The
+ * iterator over the page only moves forward and every row it passes is kept,
+ * so each row is decoded once and earlier rows are looked up directly. */
+static zval *
+php_driver_rows_get(php_driver_rows *self, size_t position)
+{
+  HashTable *rows;
+  zval *row = NULL;
+  zval decoded;
+
+  if (position >= self->count)
+    return NULL;
+
+  if (Z_ISUNDEF(self->rows)) {
+    array_init_size(&(self->rows), (uint32_t) self->count);
+    zend_hash_real_init(Z_ARRVAL(self->rows), 1);
+    self->columns  = php_driver_columns_get(self->columns_cache,
+                                            (const CassResult *) self->page->data,
+                                            self->fetch_scalars);
+    self->iterator = cass_iterator_from_result((const CassResult *) self->page->data);
+  }
+
+  rows = Z_ARRVAL(self->rows);
+
+  if (position < zend_hash_num_elements(rows))
+    return zend_hash_index_find(rows, position);
+
+  while (zend_hash_num_elements(rows) <= position) {
+    if (!cass_iterator_next(self->iterator))
+      return NULL;
+
+    if (php_driver_get_row((const php_driver_columns *) self->columns->data,
+                           cass_iterator_get_row(self->iterator), &decoded) == FAILURE) {
+      /* Keep the positions of the rows that follow */
+      ZVAL_NULL(&decoded);
+      zend_hash_next_index_insert(rows, &decoded);
+      return NULL;
+    }
+
+    row = zend_hash_next_index_insert(rows, &decoded);
+  }
+
+  return row;
+}
+
 PHP_METHOD(Rows, __construct)
 {
   zend_throw_exception_ex(php_driver_logic_exception_ce, 0,
@@ -73,7 +128,7 @@ PHP_METHOD(Rows, count)
 
   self = PHP_DRIVER_GET_ROWS(getThis());
 
-  RETURN_LONG(zend_hash_num_elements(Z_ARRVAL_P(&(self->rows))));
+  RETURN_LONG(self->count);
 }
 
 PHP_METHOD(Rows, rewind)
@@ -85,12 +140,12 @@ PHP_METHOD(Rows, rewind)
 
   self = PHP_DRIVER_GET_ROWS(getThis());
 
-  zend_hash_internal_pointer_reset(Z_ARRVAL_P(&(self->rows)));
+  self->position = 0;
 }
 
 PHP_METHOD(Rows, current)
 {
-  zval *entry;
+  zval *row;
   php_driver_rows *self = NULL;
 
   if (zend_parse_parameters_none() == FAILURE) {
@@ -99,15 +154,14 @@ PHP_METHOD(Rows, current)
 
   self = PHP_DRIVER_GET_ROWS(getThis());
 
-  if (CASS_ZEND_HASH_GET_CURRENT_DATA(Z_ARRVAL(self->rows), entry)) {
-    RETURN_ZVAL(entry, 1, 0);
+  row = php_driver_rows_get(self, self->position);
+  if (row) {
+    RETURN_ZVAL(row, 1, 0);
   }
 }
 
 PHP_METHOD(Rows, key)
 {
-  zend_ulong num_index;
-  zend_string *str_index;
   php_driver_rows *self = NULL;
 
   if (zend_parse_parameters_none() == FAILURE)
@@ -115,9 +169,8 @@ PHP_METHOD(Rows, key)
 
   self = PHP_DRIVER_GET_ROWS(getThis());
 
-  if (zend_hash_get_current_key(Z_ARRVAL(self->rows),
-                                        &str_index, &num_index) == HASH_KEY_IS_LONG)
-    RETURN_LONG(num_index);
+  if (self->position < self->count)
+    RETURN_LONG(self->position);
 }
 
 PHP_METHOD(Rows, next)
@@ -130,7 +183,8 @@ PHP_METHOD(Rows, next)
 
   self = PHP_DRIVER_GET_ROWS(getThis());
 
-  zend_hash_move_forward(Z_ARRVAL(self->rows));
+  if (self->position < self->count)
+    self->position++;
 }
 
 PHP_METHOD(Rows, valid)
@@ -142,7 +196,7 @@ PHP_METHOD(Rows, valid)
 
   self = PHP_DRIVER_GET_ROWS(getThis());
 
-  RETURN_BOOL(zend_hash_has_more_elements(Z_ARRVAL(self->rows)) == SUCCESS);
+  RETURN_BOOL(self->position < self->count);
 }
 
 PHP_METHOD(Rows, offsetExists)
@@ -159,14 +213,13 @@ PHP_METHOD(Rows, offsetExists)
 
   self = PHP_DRIVER_GET_ROWS(getThis());
 
-  RETURN_BOOL(zend_hash_index_exists(Z_ARRVAL(self->rows),
-                                     (zend_ulong) Z_LVAL_P(offset)));
+  RETURN_BOOL((size_t) Z_LVAL_P(offset) < self->count);
 }
 
 PHP_METHOD(Rows, offsetGet)
 {
   zval *offset;
-  zval *value;
+  zval *row;
   php_driver_rows *self = NULL;
 
   if (zend_parse_parameters(ZEND_NUM_ARGS(), "z", &offset) == FAILURE)
@@ -177,8 +230,9 @@ PHP_METHOD(Rows, offsetGet)
   }
 
   self = PHP_DRIVER_GET_ROWS(getThis());
-  if (CASS_ZEND_HASH_INDEX_FIND(Z_ARRVAL(self->rows), Z_LVAL_P(offset), value)) {
-    RETURN_ZVAL(value, 1, 0);
+  row = php_driver_rows_get(self, (size_t) Z_LVAL_P(offset));
+  if (row) {
+    RETURN_ZVAL(row, 1, 0);
   }
 }
 
@@ -214,7 +268,7 @@ PHP_METHOD(Rows, isLastPage)
   self = PHP_DRIVER_GET_ROWS(getThis());
 
   if (self->result == NULL &&
-      Z_ISUNDEF(self->next_rows) &&
+      self->next_result == NULL &&
       Z_ISUNDEF(self->future_next_page)) {
     RETURN_TRUE;
   }
@@ -329,6 +383,8 @@ PHP_METHOD(Rows, nextPageAsync)
 
   future_rows->statement = php_driver_add_ref(self->statement);
   future_rows->session = php_driver_add_ref(self->session);
+  future_rows->columns_cache = php_driver_add_ref(self->columns_cache);
+  future_rows->fetch_scalars = self->fetch_scalars;
   future_rows->future    = cass_session_execute((CassSession *) self->session->data,
                                                 (CassStatement *) self->statement->data);
 
@@ -357,8 +413,7 @@ PHP_METHOD(Rows, pagingStateToken)
 
 PHP_METHOD(Rows, first)
 {
-  HashPosition pos;
-  zval *entry;
+  zval *row;
   php_driver_rows* self = NULL;
 
   if (zend_parse_parameters_none() == FAILURE) {
@@ -367,9 +422,9 @@ PHP_METHOD(Rows, first)
 
   self = PHP_DRIVER_GET_ROWS(getThis());
 
-  zend_hash_internal_pointer_reset_ex(Z_ARRVAL(self->rows), &pos);
-  if (CASS_ZEND_HASH_GET_CURRENT_DATA(Z_ARRVAL(self->rows), entry)) {
-    RETVAL_ZVAL(entry, 1, 0);
+  row = php_driver_rows_get(self, 0);
+  if (row) {
+    RETVAL_ZVAL(row, 1, 0);
   }
 }
 
@@ -450,13 +505,18 @@ php_driver_rows_free(zend_object *object)
 {
   php_driver_rows *self = php_driver_rows_object_fetch(object);;
 
+  if (self->iterator)
+    cass_iterator_free(self->iterator);
+
+  php_driver_del_ref(&self->page);
+  php_driver_del_ref(&self->columns);
+  php_driver_del_ref(&self->columns_cache);
   php_driver_del_ref(&self->result);
   php_driver_del_ref(&self->statement);
   php_driver_del_peref(&self->session, 1);
   php_driver_del_ref(&self->next_result);
 
   CASS_ZVAL_MAYBE_DESTROY(self->rows);
-  CASS_ZVAL_MAYBE_DESTROY(self->next_rows);
   CASS_ZVAL_MAYBE_DESTROY(self->future_next_page);
 
   zend_object_std_dtor(&self->zval);
@@ -473,8 +533,14 @@ php_driver_rows_new(zend_class_entry *ce)
   self->session     = NULL;
   self->result      = NULL;
   self->next_result = NULL;
+  self->page        = NULL;
+  self->columns_cache = NULL;
+  self->columns     = NULL;
+  self->fetch_scalars = cass_false;
+  self->iterator    = NULL;
+  self->count       = 0;
+  self->position    = 0;
   ZVAL_UNDEF(&(self->rows));
-  ZVAL_UNDEF(&(self->next_rows));
   ZVAL_UNDEF(&(self->future_next_page));
 
   CASS_ZEND_OBJECT_INIT(rows, self, ce);
@@ -0,0 +1,431 @@
+/**
+ * Copyright 2015-2017 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "php_driver.h"
+#include "php_driver_types.h"
+#include "util/batch.h"
+#include "util/cql.h"
+
+/* Sizes used to estimate the encoded size of an entry */
+#define VALUE_HEADER_SIZE 4
+#define PREPARED_ID_SIZE  16
+#define OTHER_VALUE_SIZE  16
+
+/* Finds the table an INSERT, UPDATE or DELETE statement writes to */
+static int
+parse_table(const char *cql, smart_str *keyspace, smart_str *table)
+{
+  if (php_driver_cql_match_keyword(&cql, "insert")) {
+    if (!php_driver_cql_match_keyword(&cql, "into"))
+      return FAILURE;
+  } else if (php_driver_cql_match_keyword(&cql, "delete")) {
+    /* Skips the deleted columns, literals included */
+    while (!php_driver_cql_match_keyword(&cql, "from")) {
+      cql = php_driver_cql_skip_space(cql);
+
+      if (*cql == '\0') {
+        return FAILURE;
+      } else if (*cql == '\'' || *cql == '"') {
+        char quote = *cql++;
+        while (*cql && *cql != quote)
+          cql++;
+        if (*cql)
+          cql++;
+      } else if (php_driver_cql_is_identifier_char(*cql)) {
+        while (php_driver_cql_is_identifier_char(*cql))
+          cql++;
+      } else {
+        cql++;
+      }
+    }
+  } else if (!php_driver_cql_match_keyword(&cql, "update")) {
+    return FAILURE;
+  }
+
+  if (php_driver_cql_parse_identifier(&cql, table) == FAILURE)
+    return FAILURE;
+
+  cql = php_driver_cql_skip_space(cql);
+  if (*cql == '.') {
+    cql++;
+    *keyspace = *table;
+    memset(table, 0, sizeof(smart_str));
+    if (php_driver_cql_parse_identifier(&cql, table) == FAILURE)
+      return FAILURE;
+  }
+
+  return SUCCESS;
+}
+
+/* Finds the parameters bound to the partition key of the table, which
+ * is NULL unless every column of the partition key is bound by name */
+static int *
+find_partition_key(php_driver_statement *prepared, const CassTableMeta *table,
+                   size_t *count)
+{
+  size_t i;
+  int *indices;
+
+  *count = cass_table_meta_partition_key_count(table);
+  if (*count == 0)
+    return NULL;
+
+  indices = (int *) ecalloc(*count, sizeof(int));
+
+  for (i = 0; i < *count; i++) {
+    const CassColumnMeta *column = cass_table_meta_partition_key(table, i);
+    const char *name;
+    size_t name_length;
+    zval *index;
+
+    cass_column_meta_name(column, &name, &name_length);
+    index = zend_hash_str_find(prepared->data.prepared.param_names, name, name_length);
+
+    if (!index || Z_LVAL_P(index) < 0) {
+      efree(indices);
+      return NULL;
+    }
+    indices[i] = (int) Z_LVAL_P(index);
+  }
+
+  return indices;
+}
+
+static int
+has_counter(const CassTableMeta *table)
+{
+  size_t i, count = cass_table_meta_column_count(table);
+
+  for (i = 0; i < count; i++) {
+    const CassDataType *data_type =
+      cass_column_meta_data_type(cass_table_meta_column(table, i));
+
+    if (cass_data_type_type(data_type) == CASS_VALUE_TYPE_COUNTER)
+      return 1;
+  }
+
+  return 0;
+}
+
+static void
+resolve_partition_key(php_driver_statement *prepared, CassSession *session,
+                      zend_string *session_keyspace, const CassSchemaMeta **schema)
+{
+  smart_str keyspace = { 0 };
+  smart_str table = { 0 };
+  const CassKeyspaceMeta *keyspace_meta = NULL;
+  const CassTableMeta *table_meta = NULL;
+  size_t count = 0;
+
+  prepared->data.prepared.partition_key_count = 0;
+
+  if (!prepared->data.prepared.cql || !prepared->data.prepared.param_names ||
+      parse_table(ZSTR_VAL(prepared->data.prepared.cql), &keyspace, &table) == FAILURE) {
+    smart_str_free(&keyspace);
+    smart_str_free(&table);
+    return;
+  }
+
+  if (!keyspace.s && session_keyspace) {
+    const char *name = ZSTR_VAL(session_keyspace);
+    php_driver_cql_parse_identifier(&name, &keyspace);
+  }
+
+  if (keyspace.s) {
+    if (!*schema)
+      *schema = cass_session_get_schema_meta(session);
+
+    keyspace_meta = cass_schema_meta_keyspace_by_name_n(*schema,
+                                                        ZSTR_VAL(keyspace.s),
+                                                        ZSTR_LEN(keyspace.s));
+    if (keyspace_meta)
+      table_meta = cass_keyspace_meta_table_by_name_n(keyspace_meta,
+                                                      ZSTR_VAL(table.s),
+                                                      ZSTR_LEN(table.s));
+  }
+
+  /* Counter updates can't be part of unlogged batches */
+  if (table_meta && !has_counter(table_meta)) {
+    prepared->data.prepared.partition_key = find_partition_key(prepared, table_meta, &count);
+    if (prepared->data.prepared.partition_key)
+      prepared->data.prepared.partition_key_count = (int) count;
+  }
+
+  smart_str_free(&keyspace);
+  smart_str_free(&table);
+}
+
+/* Fails for values that can't be compared without binding them */
+static int
+append_value(smart_str *key, zval *value)
+{
+  zend_string *string;
+
+  ZVAL_DEREF(value);
+
+  switch (Z_TYPE_P(value)) {
+  case IS_LONG:
+    smart_str_appendc(key, 'l');
+    smart_str_append_long(key, Z_LVAL_P(value));
+    break;
+  case IS_DOUBLE:
+    smart_str_appendc(key, 'd');
+    smart_str_appendl(key, (const char *) &Z_DVAL_P(value), sizeof(double));
+    break;
+  case IS_TRUE:
+  case IS_FALSE:
+    smart_str_appendc(key, Z_TYPE_P(value) == IS_TRUE ? 't' : 'f');
+    break;
+  case IS_STRING:
+    smart_str_appendc(key, 's');
+    smart_str_append_long(key, (zend_long) Z_STRLEN_P(value));
+    smart_str_appendc(key, ':');
+    smart_str_append(key, Z_STR_P(value));
+    break;
+  case IS_OBJECT:
+    /* The driver's value types are compared by their string form */
+    if (!Z_OBJCE_P(value)->__tostring)
+      return FAILURE;
+
+    string = zval_get_string(value);
+    if (EG(exception)) {
+      zend_string_release(string);
+      return FAILURE;
+    }
+
+    smart_str_appendc(key, 'o');
+    smart_str_append(key, Z_OBJCE_P(value)->name);
+    smart_str_appendc(key, ':');
+    smart_str_append_long(key, (zend_long) ZSTR_LEN(string));
+    smart_str_appendc(key, ':');
+    smart_str_append(key, string);
+    zend_string_release(string);
+    break;
+  default:
+    return FAILURE;
+  }
+
+  return SUCCESS;
+}
+
+/* Finds the value of a parameter given by position or by name. Names that
+ * aren't spelled like the parameter, e.g. "Key" set on a BoundStatement for
+ * the column key, are kept as they are given and bound by the driver,
+ * which ignores their case. */
+static zval *
+find_value(HashTable *arguments, const char *name, size_t name_length, int index)
+{
+  zend_string *key;
+  zval *value;
+
+  value = zend_hash_index_find(arguments, index);
+  if (value || !name)
+    return value;
+
+  value = zend_hash_str_find(arguments, name, name_length);
+  if (value)
+    return value;
+
+  ZEND_HASH_FOREACH_STR_KEY_VAL(arguments, key, value) {
+    if (key && ZSTR_LEN(key) == name_length &&
+        zend_binary_strcasecmp(ZSTR_VAL(key), ZSTR_LEN(key), name, name_length) == 0)
+      return value;
+  } ZEND_HASH_FOREACH_END();
+
+  return NULL;
+}
+
+/* Builds the key of the partition an entry writes to, which is left empty
+ * when the partition isn't known */
+static int
+get_partition(php_driver_batch_statement_entry *entry, CassSession *session,
+              zend_string *keyspace, const CassSchemaMeta **schema, smart_str *key)
+{
+  php_driver_statement *prepared;
+  HashTable *arguments;
+  int i;
+
+  /* Bound statements are added as their prepared statement and a copy of
+   * the values bound to them */
+  if (Z_TYPE(entry->statement) != IS_OBJECT || Z_ISUNDEF(entry->arguments))
+    return SUCCESS;
+
+  prepared = PHP_DRIVER_GET_STATEMENT(&(entry->statement));
+  if (prepared->type != PHP_DRIVER_PREPARED_STATEMENT)
+    return SUCCESS;
+
+  if (prepared->data.prepared.partition_key_count < 0)
+    resolve_partition_key(prepared, session, keyspace, schema);
+
+  arguments = Z_ARRVAL(entry->arguments);
+
+  for (i = 0; i < prepared->data.prepared.partition_key_count; i++) {
+    int index = prepared->data.prepared.partition_key[i];
+    const char *name = NULL;
+    size_t name_length = 0;
+    zval *value;
+
+    if (cass_prepared_parameter_name(prepared->data.prepared.prepared, index,
+                                     &name, &name_length) != CASS_OK)
+      name = NULL;
+
+    value = find_value(arguments, name, name_length, index);
+
+    if (!value || append_value(key, value) == FAILURE) {
+      smart_str_free(key);
+      return EG(exception) ? FAILURE : SUCCESS;
+    }
+    smart_str_appendc(key, '|');
+  }
+
+  return SUCCESS;
+}
+
+static size_t
+value_size(zval *value)
+{
+  size_t size = VALUE_HEADER_SIZE;
+  zval *current;
+
+  ZVAL_DEREF(value);
+
+  switch (Z_TYPE_P(value)) {
+  case IS_NULL:
+    break;
+  case IS_TRUE:
+  case IS_FALSE:
+    size += 1;
+    break;
+  case IS_LONG:
+  case IS_DOUBLE:
+    size += 8;
+    break;
+  case IS_STRING:
+    size += Z_STRLEN_P(value);
+    break;
+  case IS_ARRAY:
+    ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(value), current) {
+      size += value_size(current);
+    } ZEND_HASH_FOREACH_END();
+    break;
+  default:
+    size += OTHER_VALUE_SIZE;
+    break;
+  }
+
+  return size;
+}
+
+/* Estimates the size of an entry from its query and its values */
+static size_t
+entry_size(php_driver_batch_statement_entry *entry)
+{
+  size_t size = 0;
+  zval *value;
+
+  if (Z_TYPE(entry->statement) == IS_STRING) {
+    size += Z_STRLEN(entry->statement);
+  } else {
+    php_driver_statement *statement = PHP_DRIVER_GET_STATEMENT(&(entry->statement));
+
+    if (statement->type == PHP_DRIVER_SIMPLE_STATEMENT)
+      size += strlen(statement->data.simple.cql);
+    else
+      size += PREPARED_ID_SIZE;
+  }
+
+  if (!Z_ISUNDEF(entry->arguments) && Z_TYPE(entry->arguments) == IS_ARRAY) {
+    ZEND_HASH_FOREACH_VAL(Z_ARRVAL(entry->arguments), value) {
+      size += value_size(value);
+    } ZEND_HASH_FOREACH_END();
+  }
+
+  return size;
+}
+
+int
+php_driver_batch_split(php_driver_statement *batch, CassSession *session,
+                       zend_string *keyspace, zval *groups, zval *unknown)
+{
+  const CassSchemaMeta *schema = NULL;
+  size_t max_bytes = batch->data.batch.max_bytes;
+  size_t *sizes;
+  zend_long count = 0;
+  HashTable filling;
+  zval *current;
+  int result = SUCCESS;
+
+  array_init(groups);
+
+  /* The group that is being filled for each partition */
+  zend_hash_init(&filling, 0, NULL, NULL, 0);
+  sizes = (size_t *) ecalloc(zend_hash_num_elements(&batch->data.batch.statements) + 1,
+                             sizeof(size_t));
+
+  ZEND_HASH_FOREACH_VAL(&batch->data.batch.statements, current) {
+    php_driver_batch_statement_entry *entry =
+      (php_driver_batch_statement_entry *) Z_PTR_P(current);
+    size_t size = entry_size(entry);
+    smart_str key = { 0 };
+    zval *index;
+    zval *group;
+
+    if (batch->data.batch.group_by_partition &&
+        get_partition(entry, session, keyspace, &schema, &key) == FAILURE) {
+      result = FAILURE;
+      break;
+    }
+    smart_str_0(&key);
+
+    if (!key.s && unknown) {
+      zend_hash_next_index_insert(Z_ARRVAL_P(unknown), current);
+      continue;
+    }
+
+    index = key.s
+            ? zend_hash_find(&filling, key.s)
+            : zend_hash_str_find(&filling, "", 0);
+
+    if (!index ||
+        (max_bytes > 0 && sizes[Z_LVAL_P(index)] > 0 &&
+         sizes[Z_LVAL_P(index)] + size > max_bytes)) {
+      zval position;
+      zval entries;
+
+      array_init(&entries);
+      add_next_index_zval(groups, &entries);
+
+      ZVAL_LONG(&position, count++);
+      index = key.s
+              ? zend_hash_update(&filling, key.s, &position)
+              : zend_hash_str_update(&filling, "", 0, &position);
+    }
+
+    sizes[Z_LVAL_P(index)] += size;
+    group = zend_hash_index_find(Z_ARRVAL_P(groups), Z_LVAL_P(index));
+    zend_hash_next_index_insert(Z_ARRVAL_P(group), current);
+
+    smart_str_free(&key);
+  } ZEND_HASH_FOREACH_END();
+
+  efree(sizes);
+  zend_hash_destroy(&filling);
+
+  if (schema)
+    cass_schema_meta_free(schema);
+
+  return result;
+}
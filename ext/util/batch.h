@@ -0,0 +1,30 @@
+/**
+ * Copyright 2015-2017 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PHP_DRIVER_UTIL_BATCH_H
+#define PHP_DRIVER_UTIL_BATCH_H
+
+/* Splits the entries of a batch into groups of entries that write to the
+ * same partition, if the batch groups by partition, and of at most the
+ * batch's maximum size, if it has one. Each group is an array of the
+ * entries as pointers, in the order they were added. Entries whose
+ * partition isn't known share a group, or are appended to unknown when it
+ * isn't NULL. Unqualified tables are looked up in the keyspace, which may
+ * be NULL. */
+int php_driver_batch_split(php_driver_statement *batch, CassSession *session,
+                           zend_string *keyspace, zval *groups, zval *unknown);
+
+#endif /* PHP_DRIVER_UTIL_BATCH_H */
@@ -0,0 +1,778 @@
+/**
+ * Copyright 2015-2017 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "php_driver.h"
+#include "php_driver_globals.h"
+#include "php_driver_types.h"
+#include "util/bind.h"
+#include "util/collections.h"
+#include "util/inet.h"
+#include "util/math.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#if !defined(HAVE_STDINT_H) && !defined(_MSC_STDINT_H_)
+#  define INT8_MAX 127
+#  define INT8_MIN (-INT8_MAX-1)
+#  define INT16_MAX 32767
+#  define INT16_MIN (-INT16_MAX-1)
+#endif
+
+#define CHECK_RESULT(rc) \
+{ \
+  ASSERT_SUCCESS_VALUE(rc, FAILURE) \
+  return SUCCESS; \
+}
+
+typedef enum {
+  BIND_STATEMENT,
+  BIND_COLLECTION,
+  BIND_TUPLE,
+  BIND_USER_TYPE
+} bind_target_kind;
+
+/* Where a value is bound to: a statement parameter (by index or by name), the
+ * next element of a collection, a tuple element (by index) or a user type
+ * field (by name). The declared type is CASS_VALUE_TYPE_UNKNOWN when it is
+ * not known, e.g. for the parameters of simple statements. */
+typedef struct {
+  bind_target_kind kind;
+  void *dest;
+  size_t index;
+  const char *name;
+  const CassDataType *data_type;
+  CassValueType type;
+} bind_target;
+
+#define BIND(target, suffix, ...) \
+  ((target)->kind == BIND_STATEMENT \
+   ? ((target)->name \
+      ? cass_statement_bind_##suffix##_by_name((CassStatement *) (target)->dest, (target)->name, __VA_ARGS__) \
+      : cass_statement_bind_##suffix((CassStatement *) (target)->dest, (target)->index, __VA_ARGS__)) \
+   : (target)->kind == BIND_COLLECTION \
+   ? cass_collection_append_##suffix((CassCollection *) (target)->dest, __VA_ARGS__) \
+   : (target)->kind == BIND_TUPLE \
+   ? cass_tuple_set_##suffix((CassTuple *) (target)->dest, (target)->index, __VA_ARGS__) \
+   : cass_user_type_set_##suffix##_by_name((CassUserType *) (target)->dest, (target)->name, __VA_ARGS__))
+
+typedef int (*binder_func)(bind_target *target, zval *value);
+
+typedef struct {
+  zend_class_entry **ce;
+  binder_func bind;
+} binder_entry;
+
+/* Class entries are at least 8 byte aligned, drop the low bits so keys
+ * spread across the buckets of the lookup cache */
+#define BINDER_KEY(ce) (((zend_ulong) (uintptr_t) (ce)) >> 3)
+
+static void
+bind_target_init(bind_target *target, bind_target_kind kind, void *dest,
+                 const CassDataType *data_type)
+{
+  target->kind      = kind;
+  target->dest      = dest;
+  target->index     = 0;
+  target->name      = NULL;
+  target->data_type = data_type;
+  target->type      = data_type ? cass_data_type_type(data_type)
+                                : CASS_VALUE_TYPE_UNKNOWN;
+}
+
+static int bind_argument(bind_target *target, zval *value);
+
+static int
+bind_float(bind_target *target, zval *value)
+{
+  php_driver_numeric *float_number = PHP_DRIVER_GET_NUMERIC(value);
+  CHECK_RESULT(BIND(target, float, float_number->data.floating.value));
+}
+
+static int
+bind_bigint(bind_target *target, zval *value)
+{
+  php_driver_numeric *bigint = PHP_DRIVER_GET_NUMERIC(value);
+  CHECK_RESULT(BIND(target, int64, bigint->data.bigint.value));
+}
+
+static int
+bind_smallint(bind_target *target, zval *value)
+{
+  php_driver_numeric *smallint = PHP_DRIVER_GET_NUMERIC(value);
+  CHECK_RESULT(BIND(target, int16, smallint->data.smallint.value));
+}
+
+static int
+bind_tinyint(bind_target *target, zval *value)
+{
+  php_driver_numeric *tinyint = PHP_DRIVER_GET_NUMERIC(value);
+  CHECK_RESULT(BIND(target, int8, tinyint->data.tinyint.value));
+}
+
+static int
+bind_timestamp(bind_target *target, zval *value)
+{
+  php_driver_timestamp *timestamp = PHP_DRIVER_GET_TIMESTAMP(value);
+  CHECK_RESULT(BIND(target, int64, timestamp->timestamp));
+}
+
+static int
+bind_date(bind_target *target, zval *value)
+{
+  php_driver_date *date = PHP_DRIVER_GET_DATE(value);
+  CHECK_RESULT(BIND(target, uint32, date->date));
+}
+
+static int
+bind_time(bind_target *target, zval *value)
+{
+  php_driver_time *time = PHP_DRIVER_GET_TIME(value);
+  CHECK_RESULT(BIND(target, int64, time->time));
+}
+
+static int
+bind_blob(bind_target *target, zval *value)
+{
+  php_driver_blob *blob = PHP_DRIVER_GET_BLOB(value);
+  CHECK_RESULT(BIND(target, bytes, blob->data, blob->size));
+}
+
+static int
+bind_varint(bind_target *target, zval *value)
+{
+  php_driver_numeric *varint = PHP_DRIVER_GET_NUMERIC(value);
+  size_t size;
+  cass_byte_t *data = export_twos_complement(varint->data.varint.value, &size);
+  CassError rc = BIND(target, bytes, data, size);
+  free(data);
+  CHECK_RESULT(rc);
+}
+
+static int
+bind_decimal(bind_target *target, zval *value)
+{
+  php_driver_numeric *decimal = PHP_DRIVER_GET_NUMERIC(value);
+  size_t size;
+  cass_byte_t *data = export_twos_complement(decimal->data.decimal.value, &size);
+  CassError rc = BIND(target, decimal, data, size, decimal->data.decimal.scale);
+  free(data);
+  CHECK_RESULT(rc);
+}
+
+static int
+bind_uuid(bind_target *target, zval *value)
+{
+  php_driver_uuid *uuid = PHP_DRIVER_GET_UUID(value);
+  CHECK_RESULT(BIND(target, uuid, uuid->uuid));
+}
+
+static int
+bind_inet(bind_target *target, zval *value)
+{
+  php_driver_inet *inet = PHP_DRIVER_GET_INET(value);
+  CHECK_RESULT(BIND(target, inet, inet->inet));
+}
+
+static int
+bind_duration(bind_target *target, zval *value)
+{
+  php_driver_duration *duration = PHP_DRIVER_GET_DURATION(value);
+  CHECK_RESULT(BIND(target, duration,
+                    duration->months, duration->days, duration->nanos));
+}
+
+static int
+bind_set(bind_target *target, zval *value)
+{
+  CassError rc;
+  CassCollection *collection;
+  php_driver_set *set = PHP_DRIVER_GET_SET(value);
+  if (!php_driver_collection_from_set(set, &collection))
+    return FAILURE;
+
+  rc = BIND(target, collection, collection);
+  cass_collection_free(collection);
+  CHECK_RESULT(rc);
+}
+
+static int
+bind_map(bind_target *target, zval *value)
+{
+  CassError rc;
+  CassCollection *collection;
+  php_driver_map *map = PHP_DRIVER_GET_MAP(value);
+  if (!php_driver_collection_from_map(map, &collection))
+    return FAILURE;
+
+  rc = BIND(target, collection, collection);
+  cass_collection_free(collection);
+  CHECK_RESULT(rc);
+}
+
+static int
+bind_collection(bind_target *target, zval *value)
+{
+  CassError rc;
+  CassCollection *collection;
+  php_driver_collection *coll = PHP_DRIVER_GET_COLLECTION(value);
+  if (!php_driver_collection_from_collection(coll, &collection))
+    return FAILURE;
+
+  rc = BIND(target, collection, collection);
+  cass_collection_free(collection);
+  CHECK_RESULT(rc);
+}
+
+static int
+bind_tuple(bind_target *target, zval *value)
+{
+  CassError rc;
+  CassTuple *tup;
+  php_driver_tuple *tuple = PHP_DRIVER_GET_TUPLE(value);
+  if (!php_driver_tuple_from_tuple(tuple, &tup))
+    return FAILURE;
+
+  rc = BIND(target, tuple, tup);
+  cass_tuple_free(tup);
+  CHECK_RESULT(rc);
+}
+
+static int
+bind_user_type(bind_target *target, zval *value)
+{
+  CassError rc;
+  CassUserType *ut;
+  php_driver_user_type_value *user_type_value = PHP_DRIVER_GET_USER_TYPE_VALUE(value);
+  if (!php_driver_user_type_from_user_type_value(user_type_value, &ut))
+    return FAILURE;
+
+  rc = BIND(target, user_type, ut);
+  cass_user_type_free(ut);
+  CHECK_RESULT(rc);
+}
+
+/* Plain PHP scalars are coerced to the declared type of the parameter when
+ * it is known, which spares wrapping them in value objects */
+static int
+bind_long(bind_target *target, zend_long value)
+{
+  switch (target->type) {
+  case CASS_VALUE_TYPE_BIGINT:
+  case CASS_VALUE_TYPE_COUNTER:
+  case CASS_VALUE_TYPE_TIMESTAMP:
+  case CASS_VALUE_TYPE_TIME:
+    CHECK_RESULT(BIND(target, int64, (cass_int64_t) value));
+  case CASS_VALUE_TYPE_SMALL_INT:
+    if (value < INT16_MIN || value > INT16_MAX) {
+      zend_throw_exception_ex(php_driver_range_exception_ce, 0,
+        "value must be between -32768 and 32767, " ZEND_LONG_FMT " given", value);
+      return FAILURE;
+    }
+    CHECK_RESULT(BIND(target, int16, (cass_int16_t) value));
+  case CASS_VALUE_TYPE_TINY_INT:
+    if (value < INT8_MIN || value > INT8_MAX) {
+      zend_throw_exception_ex(php_driver_range_exception_ce, 0,
+        "value must be between -128 and 127, " ZEND_LONG_FMT " given", value);
+      return FAILURE;
+    }
+    CHECK_RESULT(BIND(target, int8, (cass_int8_t) value));
+  case CASS_VALUE_TYPE_FLOAT:
+    CHECK_RESULT(BIND(target, float, (cass_float_t) value));
+  case CASS_VALUE_TYPE_DOUBLE:
+    CHECK_RESULT(BIND(target, double, (cass_double_t) value));
+  case CASS_VALUE_TYPE_VARINT:
+    {
+      CassError rc;
+      size_t size;
+      cass_byte_t *data;
+      mpz_t number;
+
+      mpz_init(number);
+      mpz_set_si(number, value);
+      data = export_twos_complement(number, &size);
+      mpz_clear(number);
+
+      rc = BIND(target, bytes, data, size);
+      free(data);
+      CHECK_RESULT(rc);
+    }
+  default:
+    CHECK_RESULT(BIND(target, int32, (cass_int32_t) value));
+  }
+}
+
+static int
+bind_double(bind_target *target, double value)
+{
+  if (target->type == CASS_VALUE_TYPE_FLOAT)
+    CHECK_RESULT(BIND(target, float, (cass_float_t) value));
+
+  CHECK_RESULT(BIND(target, double, value));
+}
+
+static int
+bind_string(bind_target *target, zval *value)
+{
+  switch (target->type) {
+  case CASS_VALUE_TYPE_UUID:
+  case CASS_VALUE_TYPE_TIMEUUID:
+    {
+      CassUuid uuid;
+      if (cass_uuid_from_string_n(Z_STRVAL_P(value), Z_STRLEN_P(value), &uuid) != CASS_OK) {
+        zend_throw_exception_ex(php_driver_invalid_argument_exception_ce, 0,
+                                "Invalid UUID: '%.*s'", (int) Z_STRLEN_P(value), Z_STRVAL_P(value));
+        return FAILURE;
+      }
+      CHECK_RESULT(BIND(target, uuid, uuid));
+    }
+  case CASS_VALUE_TYPE_INET:
+    {
+      CassInet inet;
+      if (!php_driver_parse_ip_address(Z_STRVAL_P(value), &inet))
+        return FAILURE;
+      CHECK_RESULT(BIND(target, inet, inet));
+    }
+  case CASS_VALUE_TYPE_VARINT:
+    {
+      CassError rc;
+      size_t size;
+      cass_byte_t *data;
+      mpz_t number;
+
+      mpz_init(number);
+      if (!php_driver_parse_varint(Z_STRVAL_P(value), Z_STRLEN_P(value), &number)) {
+        mpz_clear(number);
+        return FAILURE;
+      }
+      data = export_twos_complement(number, &size);
+      mpz_clear(number);
+
+      rc = BIND(target, bytes, data, size);
+      free(data);
+      CHECK_RESULT(rc);
+    }
+  default:
+    CHECK_RESULT(BIND(target, string, Z_STRVAL_P(value)));
+  }
+}
+
+/* Order matters for subclasses and implementors: the first entry a class is
+ * an instance of wins, which mirrors the order of the former instanceof checks */
+static const binder_entry binders[] = {
+  { &php_driver_float_ce,           bind_float      },
+  { &php_driver_bigint_ce,          bind_bigint     },
+  { &php_driver_smallint_ce,        bind_smallint   },
+  { &php_driver_tinyint_ce,         bind_tinyint    },
+  { &php_driver_timestamp_ce,       bind_timestamp  },
+  { &php_driver_date_ce,            bind_date       },
+  { &php_driver_time_ce,            bind_time       },
+  { &php_driver_blob_ce,            bind_blob       },
+  { &php_driver_varint_ce,          bind_varint     },
+  { &php_driver_decimal_ce,         bind_decimal    },
+  { &php_driver_uuid_interface_ce,  bind_uuid       },
+  { &php_driver_inet_ce,            bind_inet       },
+  { &php_driver_duration_ce,        bind_duration   },
+  { &php_driver_set_ce,             bind_set        },
+  { &php_driver_map_ce,             bind_map        },
+  { &php_driver_collection_ce,      bind_collection },
+  { &php_driver_tuple_ce,           bind_tuple      },
+  { &php_driver_user_type_value_ce, bind_user_type  },
+  { NULL,                           NULL            }
+};
+
+static void
+binder_cache_add(HashTable *cache, zend_class_entry *ce, const binder_entry *entry)
+{
+  zval zentry;
+  ZVAL_PTR(&zentry, (void *) entry);
+  zend_hash_index_update(cache, BINDER_KEY(ce), &zentry);
+}
+
+/* Finds the binder for a class. Exact matches are seeded into the cache up
+ * front, anything else (e.g. Uuid and Timeuuid through UuidInterface) is
+ * resolved once by walking the table and then cached, including misses. The
+ * cache lives for the request because user classes do not outlive it. */
+static const binder_entry *
+binder_find(zend_class_entry *ce)
+{
+  HashTable *cache = PHP_DRIVER_G(binder_cache);
+  const binder_entry *entry;
+  zval *cached;
+
+  if (!cache) {
+    ALLOC_HASHTABLE(cache);
+    zend_hash_init(cache, 32, NULL, NULL, 0);
+    for (entry = binders; entry->ce; entry++) {
+      binder_cache_add(cache, *entry->ce, entry);
+    }
+    PHP_DRIVER_G(binder_cache) = cache;
+  }
+
+  cached = zend_hash_index_find(cache, BINDER_KEY(ce));
+  if (cached) {
+    return (const binder_entry *) Z_PTR_P(cached);
+  }
+
+  for (entry = binders; entry->ce; entry++) {
+    if (instanceof_function(ce, *entry->ce)) {
+      break;
+    }
+  }
+
+  if (!entry->ce) {
+    entry = NULL;
+  }
+
+  binder_cache_add(cache, ce, entry);
+  return entry;
+}
+
+static int
+bind_null(bind_target *target)
+{
+  switch (target->kind) {
+  case BIND_STATEMENT:
+    if (target->name) {
+      CHECK_RESULT(cass_statement_bind_null_by_name((CassStatement *) target->dest, target->name));
+    }
+    CHECK_RESULT(cass_statement_bind_null((CassStatement *) target->dest, target->index));
+  case BIND_TUPLE:
+    CHECK_RESULT(cass_tuple_set_null((CassTuple *) target->dest, target->index));
+  case BIND_USER_TYPE:
+    CHECK_RESULT(cass_user_type_set_null_by_name((CassUserType *) target->dest, target->name));
+  default:
+    zend_throw_exception_ex(php_driver_invalid_argument_exception_ce, 0,
+                            "Collections cannot contain null values");
+    return FAILURE;
+  }
+}
+
+static int
+is_string_type(CassValueType type)
+{
+  return type == CASS_VALUE_TYPE_TEXT ||
+         type == CASS_VALUE_TYPE_VARCHAR ||
+         type == CASS_VALUE_TYPE_ASCII;
+}
+
+/* PHP arrays bound to a list, set or map are encoded straight into a
+ * CassCollection using the element types of the declared type */
+static int
+bind_array_as_collection(bind_target *target, HashTable *values)
+{
+  int result = SUCCESS;
+  CassError rc = CASS_OK;
+  CassCollection *collection;
+  bind_target key_target;
+  bind_target value_target;
+  zend_ulong num_key;
+  zend_string *key;
+  zval *current;
+
+  collection = cass_collection_new_from_data_type(target->data_type,
+                                                  zend_hash_num_elements(values));
+
+  if (target->type == CASS_VALUE_TYPE_MAP) {
+    bind_target_init(&key_target, BIND_COLLECTION, collection,
+                     cass_data_type_sub_data_type(target->data_type, 0));
+    bind_target_init(&value_target, BIND_COLLECTION, collection,
+                     cass_data_type_sub_data_type(target->data_type, 1));
+
+    ZEND_HASH_FOREACH_KEY_VAL(values, num_key, key, current) {
+      zval zkey;
+
+      if (key) {
+        ZVAL_STR(&zkey, key);
+        result = bind_argument(&key_target, &zkey);
+      } else if (is_string_type(key_target.type)) {
+        /* PHP stores numeric string keys as integers */
+        ZVAL_STR(&zkey, strpprintf(0, ZEND_LONG_FMT, (zend_long) num_key));
+        result = bind_argument(&key_target, &zkey);
+        zval_ptr_dtor(&zkey);
+      } else {
+        ZVAL_LONG(&zkey, num_key);
+        result = bind_argument(&key_target, &zkey);
+      }
+
+      if (result == SUCCESS)
+        result = bind_argument(&value_target, current);
+
+      if (result == FAILURE) break;
+    } ZEND_HASH_FOREACH_END();
+  } else {
+    bind_target_init(&value_target, BIND_COLLECTION, collection,
+                     cass_data_type_sub_data_type(target->data_type, 0));
+
+    ZEND_HASH_FOREACH_VAL(values, current) {
+      result = bind_argument(&value_target, current);
+      if (result == FAILURE) break;
+    } ZEND_HASH_FOREACH_END();
+  }
+
+  if (result == SUCCESS)
+    rc = BIND(target, collection, collection);
+
+  cass_collection_free(collection);
+
+  if (result == FAILURE)
+    return FAILURE;
+
+  CHECK_RESULT(rc);
+}
+
+/* Tuple elements are taken in array order */
+static int
+bind_array_as_tuple(bind_target *target, HashTable *values)
+{
+  int result = SUCCESS;
+  CassError rc = CASS_OK;
+  CassTuple *tuple;
+  bind_target element;
+  size_t count = cass_data_type_sub_type_count(target->data_type);
+  zval *current;
+
+  if (zend_hash_num_elements(values) > count) {
+    zend_throw_exception_ex(php_driver_invalid_argument_exception_ce, 0,
+                            "Expected at most %d tuple values, %d given",
+                            (int) count, (int) zend_hash_num_elements(values));
+    return FAILURE;
+  }
+
+  tuple = cass_tuple_new_from_data_type(target->data_type);
+
+  bind_target_init(&element, BIND_TUPLE, tuple, NULL);
+  ZEND_HASH_FOREACH_VAL(values, current) {
+    const CassDataType *data_type =
+      cass_data_type_sub_data_type(target->data_type, element.index);
+
+    element.data_type = data_type;
+    element.type      = data_type ? cass_data_type_type(data_type)
+                                  : CASS_VALUE_TYPE_UNKNOWN;
+
+    result = bind_argument(&element, current);
+    if (result == FAILURE) break;
+
+    element.index++;
+  } ZEND_HASH_FOREACH_END();
+
+  if (result == SUCCESS)
+    rc = BIND(target, tuple, tuple);
+
+  cass_tuple_free(tuple);
+
+  if (result == FAILURE)
+    return FAILURE;
+
+  CHECK_RESULT(rc);
+}
+
+/* User type fields are taken from the string keys of the array */
+static int
+bind_array_as_user_type(bind_target *target, HashTable *values)
+{
+  int result = SUCCESS;
+  CassError rc = CASS_OK;
+  CassUserType *user_type;
+  bind_target field;
+  zend_string *key;
+  zval *current;
+
+  user_type = cass_user_type_new_from_data_type(target->data_type);
+
+  ZEND_HASH_FOREACH_STR_KEY_VAL(values, key, current) {
+    const CassDataType *data_type = NULL;
+
+    if (key) {
+      data_type = cass_data_type_sub_data_type_by_name_n(target->data_type,
+                                                         ZSTR_VAL(key), ZSTR_LEN(key));
+    }
+
+    if (!data_type) {
+      zend_throw_exception_ex(php_driver_invalid_argument_exception_ce, 0,
+                              "Invalid user type field name '%s'",
+                              key ? ZSTR_VAL(key) : "");
+      result = FAILURE;
+      break;
+    }
+
+    bind_target_init(&field, BIND_USER_TYPE, user_type, data_type);
+    field.name = ZSTR_VAL(key);
+
+    result = bind_argument(&field, current);
+    if (result == FAILURE) break;
+  } ZEND_HASH_FOREACH_END();
+
+  if (result == SUCCESS)
+    rc = BIND(target, user_type, user_type);
+
+  cass_user_type_free(user_type);
+
+  if (result == FAILURE)
+    return FAILURE;
+
+  CHECK_RESULT(rc);
+}
+
+static int
+bind_array(bind_target *target, HashTable *values)
+{
+  switch (target->type) {
+  case CASS_VALUE_TYPE_LIST:
+  case CASS_VALUE_TYPE_SET:
+  case CASS_VALUE_TYPE_MAP:
+    return bind_array_as_collection(target, values);
+  case CASS_VALUE_TYPE_TUPLE:
+    return bind_array_as_tuple(target, values);
+  case CASS_VALUE_TYPE_UDT:
+    return bind_array_as_user_type(target, values);
+  default:
+    return FAILURE;
+  }
+}
+
+static int
+bind_argument(bind_target *target, zval *value)
+{
+  const binder_entry *entry;
+
+  ZVAL_DEREF(value);
+
+  switch (Z_TYPE_P(value)) {
+  case IS_NULL:
+    return bind_null(target);
+  case IS_STRING:
+    return bind_string(target, value);
+  case IS_DOUBLE:
+    return bind_double(target, Z_DVAL_P(value));
+  case IS_LONG:
+    return bind_long(target, Z_LVAL_P(value));
+  case IS_TRUE:
+    CHECK_RESULT(BIND(target, bool, cass_true));
+  case IS_FALSE:
+    CHECK_RESULT(BIND(target, bool, cass_false));
+  case IS_ARRAY:
+    return bind_array(target, Z_ARRVAL_P(value));
+  case IS_OBJECT:
+    entry = binder_find(Z_OBJCE_P(value));
+    if (entry) {
+      return entry->bind(target, value);
+    }
+    break;
+  default:
+    break;
+  }
+
+  return FAILURE;
+}
+
+int
+php_driver_bind_argument_by_index(CassStatement *statement, const CassDataType *data_type,
+                                  size_t index, zval *value)
+{
+  bind_target target;
+
+  bind_target_init(&target, BIND_STATEMENT, statement, data_type);
+  target.index = index;
+
+  return bind_argument(&target, value);
+}
+
+int
+php_driver_bind_argument_by_name(CassStatement *statement, const CassDataType *data_type,
+                                 const char *name, zval *value)
+{
+  bind_target target;
+
+  bind_target_init(&target, BIND_STATEMENT, statement, data_type);
+  target.name = name;
+
+  return bind_argument(&target, value);
+}
+
+int
+php_driver_bind_parameter_index(php_driver_statement *source, zend_string *name,
+                                zend_ulong *index)
+{
+  zval *position;
+
+  if (!source || source->type != PHP_DRIVER_PREPARED_STATEMENT ||
+      !source->data.prepared.param_names)
+    return FAILURE;
+
+  position = zend_hash_find(source->data.prepared.param_names, name);
+  if (!position || Z_LVAL_P(position) < 0)
+    return FAILURE;
+
+  *index = (zend_ulong) Z_LVAL_P(position);
+  return SUCCESS;
+}
+
+int
+php_driver_bind_argument(CassStatement *statement, php_driver_statement *source,
+                         zend_string *name, zend_ulong index, zval *value)
+{
+  const CassPrepared *prepared = NULL;
+  const CassDataType *data_type = NULL;
+
+  if (source && source->type == PHP_DRIVER_PREPARED_STATEMENT)
+    prepared = source->data.prepared.prepared;
+
+  /* Resolve names to positions up front; names the map does not know
+   * (e.g. spelled in a different case) are left to the driver */
+  if (name && php_driver_bind_parameter_index(source, name, &index) == SUCCESS)
+    name = NULL;
+
+  if (name) {
+    if (prepared)
+      data_type = cass_prepared_parameter_data_type_by_name_n(prepared, ZSTR_VAL(name), ZSTR_LEN(name));
+    return php_driver_bind_argument_by_name(statement, data_type, ZSTR_VAL(name), value);
+  }
+
+  if (prepared && index < source->data.prepared.param_count)
+    data_type = source->data.prepared.param_types[index];
+  return php_driver_bind_argument_by_index(statement, data_type, index, value);
+}
+
+int
+php_driver_bind_arguments(CassStatement *statement, php_driver_statement *source,
+                          HashTable *arguments)
+{
+  int rc = SUCCESS;
+
+  zval *current;
+  zend_ulong num_key;
+
+  zend_string *key;
+  ZEND_HASH_FOREACH_KEY_VAL(arguments, num_key, key, current) {
+    rc = php_driver_bind_argument(statement, source, key, num_key, current);
+    if (rc == FAILURE) break;
+  } ZEND_HASH_FOREACH_END();
+
+  return rc;
+}
+
+void
+php_driver_bind_cache_destroy()
+{
+  HashTable *cache = PHP_DRIVER_G(binder_cache);
+
+  if (cache) {
+    zend_hash_destroy(cache);
+    FREE_HASHTABLE(cache);
+    PHP_DRIVER_G(binder_cache) = NULL;
+  }
+}
@@ -0,0 +1,39 @@
+/**
+ * Copyright 2015-2017 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PHP_DRIVER_UTIL_BIND_H
+#define PHP_DRIVER_UTIL_BIND_H
+
+/* The data type is the declared type of the parameter, or NULL when unknown */
+int  php_driver_bind_argument_by_index(CassStatement *statement, const CassDataType *data_type,
+                                       size_t index, zval *value);
+int  php_driver_bind_argument_by_name(CassStatement *statement, const CassDataType *data_type,
+                                      const char *name, zval *value);
+/* Resolves a parameter name of a prepared statement to its position */
+int  php_driver_bind_parameter_index(php_driver_statement *source, zend_string *name,
+                                     zend_ulong *index);
+/* Binds a single argument given either by name or, when name is NULL, by index */
+int  php_driver_bind_argument(CassStatement *statement, php_driver_statement *source,
+                              zend_string *name, zend_ulong index, zval *value);
+/* Binds an array of arguments; the source statement provides the declared
+ * parameter types when it is prepared and may be NULL */
+int  php_driver_bind_arguments(CassStatement *statement, php_driver_statement *source,
+                               HashTable *arguments);
+
+/* Releases the per-request cache of class to binder lookups */
+void php_driver_bind_cache_destroy();
+
+#endif /* PHP_DRIVER_UTIL_BIND_H */
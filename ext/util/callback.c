@@ -0,0 +1,265 @@
+/**
+ * Copyright 2015-2017 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "php_driver.h"
+#include "php_driver_globals.h"
+#include "php_driver_types.h"
+#include "util/callback.h"
+#include "util/future.h"
+
+ZEND_EXTERN_MODULE_GLOBALS(php_driver)
+
+/* Callbacks are kept as arrays holding the future followed by pairs of
+ * success and error callbacks, in the order then() was called */
+struct php_driver_callbacks_ {
+  /* Completion callbacks of the driver only push the future here, so user
+   * callbacks always run in the request's own thread */
+  php_driver_future_queue *queue;
+  /* Callbacks keyed by the address of the future they wait on */
+  HashTable pending;
+  /* Callbacks of futures that had resolved already */
+  HashTable ready;
+};
+
+static php_driver_callbacks *
+callbacks_get()
+{
+  php_driver_callbacks *callbacks = PHP_DRIVER_G(callbacks);
+
+  if (!callbacks) {
+    callbacks = emalloc(sizeof(php_driver_callbacks));
+    callbacks->queue = php_driver_future_queue_new(16);
+    zend_hash_init(&callbacks->pending, 0, NULL, ZVAL_PTR_DTOR, 0);
+    zend_hash_init(&callbacks->ready, 0, NULL, ZVAL_PTR_DTOR, 0);
+    PHP_DRIVER_G(callbacks) = callbacks;
+  }
+
+  return callbacks;
+}
+
+static int
+callback_call(zval *callback, zval *arg)
+{
+  zval retval;
+
+  ZVAL_UNDEF(&retval);
+  call_user_function(NULL, NULL, callback, &retval, 1, arg);
+  zval_ptr_dtor(&retval);
+
+  return EG(exception) ? FAILURE : SUCCESS;
+}
+
+static int
+callbacks_invoke(zval *entry)
+{
+  zval *future = zend_hash_index_find(Z_ARRVAL_P(entry), 0);
+  zval *pair;
+  zval value;
+  int failed;
+  int result = SUCCESS;
+
+  ZVAL_UNDEF(&value);
+  CASS_COMPAT_zend_call_method_with_0_params(future, Z_OBJCE_P(future), NULL, "get", &value);
+
+  failed = EG(exception) != NULL;
+  if (failed) {
+    zval_ptr_dtor(&value);
+    ZVAL_OBJ(&value, EG(exception));
+    Z_ADDREF(value);
+    zend_clear_exception();
+  }
+
+  ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(entry), pair) {
+    zval *on_success, *on_error;
+
+    if (Z_TYPE_P(pair) != IS_ARRAY)
+      continue;
+
+    on_success = zend_hash_index_find(Z_ARRVAL_P(pair), 0);
+    on_error   = zend_hash_index_find(Z_ARRVAL_P(pair), 1);
+
+    if (!failed) {
+      result = callback_call(on_success, &value);
+    } else if (Z_TYPE_P(on_error) != IS_NULL) {
+      result = callback_call(on_error, &value);
+    } else {
+      Z_ADDREF(value);
+      zend_throw_exception_object(&value);
+      result = FAILURE;
+    }
+
+    if (result == FAILURE)
+      break;
+  } ZEND_HASH_FOREACH_END();
+
+  zval_ptr_dtor(&value);
+
+  return result;
+}
+
+void
+php_driver_future_then(INTERNAL_FUNCTION_PARAMETERS)
+{
+  zval *on_success = NULL;
+  zval *on_error = NULL;
+  php_driver_callbacks *callbacks;
+  CassFuture *handle = NULL;
+  zval *entry;
+  zval pair;
+
+  if (zend_parse_parameters(ZEND_NUM_ARGS(), "z|z!", &on_success, &on_error) == FAILURE) {
+    return;
+  }
+
+  if (!zend_is_callable(on_success, 0, NULL)) {
+    throw_invalid_argument(on_success, "onSuccess", "a callable");
+    return;
+  }
+
+  if (on_error && !zend_is_callable(on_error, 0, NULL)) {
+    throw_invalid_argument(on_error, "onError", "a callable or null");
+    return;
+  }
+
+  php_driver_future_get_handle(getThis(), &handle);
+
+  callbacks = callbacks_get();
+
+  if (!handle) {
+    zval ready;
+    array_init(&ready);
+    Z_ADDREF_P(getThis());
+    add_next_index_zval(&ready, getThis());
+    entry = zend_hash_next_index_insert(&callbacks->ready, &ready);
+  } else {
+    zend_ulong key = (zend_ulong) (uintptr_t) handle;
+
+    entry = zend_hash_index_find(&callbacks->pending, key);
+    if (!entry) {
+      zval pending;
+
+      if (php_driver_future_queue_add(callbacks->queue, handle) == FAILURE)
+        return;
+
+      array_init(&pending);
+      Z_ADDREF_P(getThis());
+      add_next_index_zval(&pending, getThis());
+      entry = zend_hash_index_update(&callbacks->pending, key, &pending);
+    }
+  }
+
+  array_init(&pair);
+  Z_TRY_ADDREF_P(on_success);
+  add_next_index_zval(&pair, on_success);
+  if (on_error) {
+    Z_TRY_ADDREF_P(on_error);
+    add_next_index_zval(&pair, on_error);
+  } else {
+    add_next_index_null(&pair);
+  }
+  add_next_index_zval(entry, &pair);
+
+  RETURN_ZVAL(getThis(), 1, 0);
+}
+
+int
+php_driver_callbacks_run(int wait, zend_long *count)
+{
+  php_driver_callbacks *callbacks = PHP_DRIVER_G(callbacks);
+
+  *count = 0;
+
+  if (!callbacks)
+    return SUCCESS;
+
+  while (1) {
+    CassFuture *future;
+    zend_ulong key;
+    zval *found;
+    zval entry;
+    int result;
+
+    if (zend_hash_num_elements(&callbacks->ready) > 0) {
+      HashPosition pos;
+
+      zend_hash_internal_pointer_reset_ex(&callbacks->ready, &pos);
+      zend_hash_get_current_key_ex(&callbacks->ready, NULL, &key, &pos);
+      found = zend_hash_get_current_data_ex(&callbacks->ready, &pos);
+      ZVAL_COPY(&entry, found);
+      zend_hash_index_del(&callbacks->ready, key);
+    } else {
+      future = wait
+             ? php_driver_future_queue_wait_until(callbacks->queue, 0)
+             : php_driver_future_queue_poll(callbacks->queue);
+      if (!future)
+        break;
+
+      key = (zend_ulong) (uintptr_t) future;
+      found = zend_hash_index_find(&callbacks->pending, key);
+      if (!found)
+        continue;
+      ZVAL_COPY(&entry, found);
+      zend_hash_index_del(&callbacks->pending, key);
+    }
+
+    result = callbacks_invoke(&entry);
+    zval_ptr_dtor(&entry);
+    (*count)++;
+
+    if (result == FAILURE)
+      return FAILURE;
+  }
+
+  return SUCCESS;
+}
+
+int
+php_driver_callbacks_pending()
+{
+  php_driver_callbacks *callbacks = PHP_DRIVER_G(callbacks);
+
+  return callbacks &&
+         (zend_hash_num_elements(&callbacks->pending) > 0 ||
+          zend_hash_num_elements(&callbacks->ready) > 0);
+}
+
+void
+php_driver_callbacks_shutdown()
+{
+  php_driver_callbacks *callbacks = PHP_DRIVER_G(callbacks);
+  zend_long count;
+
+  if (!callbacks)
+    return;
+
+  /* User code can't run after a fatal error */
+  if (!CG(unclean_shutdown)) {
+    zend_try {
+      if (php_driver_callbacks_run(1, &count) == FAILURE) {
+        zend_clear_exception();
+        php_error_docref(NULL, E_WARNING,
+                         "A callback threw an exception at the end of the request, "
+                         "remaining callbacks were dropped");
+      }
+    } zend_end_try();
+  }
+
+  PHP_DRIVER_G(callbacks) = NULL;
+  php_driver_future_queue_free(callbacks->queue);
+  zend_hash_destroy(&callbacks->pending);
+  zend_hash_destroy(&callbacks->ready);
+  efree(callbacks);
+}
@@ -0,0 +1,34 @@
+/**
+ * Copyright 2015-2017 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PHP_DRIVER_UTIL_CALLBACK_H
+#define PHP_DRIVER_UTIL_CALLBACK_H
+
+typedef struct php_driver_callbacks_ php_driver_callbacks;
+
+/* Implements then() of a Future: the callbacks get the result of get() or
+ * the exception it throws once the future has resolved and callbacks are
+ * run. Without an error callback the exception is thrown by the run. */
+void php_driver_future_then(INTERNAL_FUNCTION_PARAMETERS);
+/* Runs the callbacks of resolved futures in the order they resolved. When
+ * waiting, runs until no callbacks are left, including ones added meanwhile. */
+int  php_driver_callbacks_run(int wait, zend_long *count);
+/* Returns whether callbacks wait to be run */
+int  php_driver_callbacks_pending();
+/* Runs the remaining callbacks at the end of a request and frees them */
+void php_driver_callbacks_shutdown();
+
+#endif /* PHP_DRIVER_UTIL_CALLBACK_H */
@@ -0,0 +1,112 @@
+/**
+ * Copyright 2015-2017 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "php_driver.h"
+#include "util/cql.h"
+
+#include <ctype.h>
+
+const char *
+php_driver_cql_skip_space(const char *cql)
+{
+  while (isspace((unsigned char) *cql))
+    cql++;
+
+  return cql;
+}
+
+int
+php_driver_cql_is_identifier_char(char c)
+{
+  return isalnum((unsigned char) c) || c == '_';
+}
+
+int
+php_driver_cql_match_keyword(const char **cql, const char *keyword)
+{
+  const char *p = php_driver_cql_skip_space(*cql);
+  size_t i;
+
+  for (i = 0; keyword[i]; i++) {
+    if (tolower((unsigned char) p[i]) != keyword[i])
+      return 0;
+  }
+
+  if (php_driver_cql_is_identifier_char(p[i]))
+    return 0;
+
+  *cql = p + i;
+  return 1;
+}
+
+int
+php_driver_cql_parse_identifier(const char **cql, smart_str *name)
+{
+  const char *p = php_driver_cql_skip_space(*cql);
+
+  if (*p == '"') {
+    for (p++; *p; p++) {
+      if (*p == '"') {
+        if (p[1] != '"')
+          break;
+        p++;
+      }
+      smart_str_appendc(name, *p);
+    }
+
+    if (*p != '"')
+      return FAILURE;
+    p++;
+  } else {
+    if (!php_driver_cql_is_identifier_char(*p))
+      return FAILURE;
+
+    for (; php_driver_cql_is_identifier_char(*p); p++)
+      smart_str_appendc(name, tolower((unsigned char) *p));
+  }
+
+  smart_str_0(name);
+  *cql = p;
+  return SUCCESS;
+}
+
+int
+php_driver_cql_parse_use(const char *cql, const char **keyspace, size_t *keyspace_len)
+{
+  smart_str name = { 0 };
+  const char *start;
+  int result;
+
+  if (!php_driver_cql_match_keyword(&cql, "use"))
+    return FAILURE;
+
+  start = php_driver_cql_skip_space(cql);
+  cql = start;
+  result = php_driver_cql_parse_identifier(&cql, &name);
+  smart_str_free(&name);
+
+  if (result == FAILURE)
+    return FAILURE;
+
+  *keyspace = start;
+  *keyspace_len = (size_t) (cql - start);
+
+  cql = php_driver_cql_skip_space(cql);
+  if (*cql == ';')
+    cql = php_driver_cql_skip_space(cql + 1);
+
+  return *cql == '\0' ? SUCCESS : FAILURE;
+}
@@ -0,0 +1,33 @@
+/**
+ * Copyright 2015-2017 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PHP_DRIVER_UTIL_CQL_H
+#define PHP_DRIVER_UTIL_CQL_H
+
+#include <zend_smart_str.h>
+
+/* Just enough of a CQL tokenizer to find the names a statement refers to */
+const char *php_driver_cql_skip_space(const char *cql);
+int php_driver_cql_is_identifier_char(char c);
+/* Consumes the lowercase keyword if it's the next word, ignoring case */
+int php_driver_cql_match_keyword(const char **cql, const char *keyword);
+/* Reads a name the way Cassandra does: quoted names are taken as they are
+ * and unquoted ones are lowercased */
+int php_driver_cql_parse_identifier(const char **cql, smart_str *name);
+/* Finds the keyspace of a "USE <keyspace>" statement, as it is written */
+int php_driver_cql_parse_use(const char *cql, const char **keyspace, size_t *keyspace_len);
+
+#endif /* PHP_DRIVER_UTIL_CQL_H */
@@ -0,0 +1,220 @@
+/**
+ * Copyright 2015-2017 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "php_driver.h"
+#include "php_driver_types.h"
+#include "util/detached.h"
+#include "util/future.h"
+
+#include <uv.h>
+
+#define DETACHED_ERRORS 64
+#define DETACHED_MESSAGE_SIZE 256
+
+typedef struct {
+  CassError code;
+  char message[DETACHED_MESSAGE_SIZE];
+} detached_error;
+
+struct php_driver_detached_ {
+  uv_mutex_t lock;
+  uv_cond_t cond;
+  /* Held by the owner and by every request in flight */
+  unsigned int refs;
+  size_t in_flight;
+  size_t limit;
+  /* Failures since the errors were last taken */
+  zend_long failed;
+  /* Ring of the most recent failures */
+  detached_error errors[DETACHED_ERRORS];
+  size_t head;
+  size_t count;
+};
+
+static void
+detached_unref(php_driver_detached *detached)
+{
+  int last;
+
+  uv_mutex_lock(&detached->lock);
+  last = --detached->refs == 0;
+  uv_mutex_unlock(&detached->lock);
+
+  if (last) {
+    uv_cond_destroy(&detached->cond);
+    uv_mutex_destroy(&detached->lock);
+    free(detached);
+  }
+}
+
+/* Runs on the driver's I/O threads, so only plain allocations are allowed */
+static void
+detached_callback(CassFuture *future, void *data)
+{
+  php_driver_detached *detached = (php_driver_detached *) data;
+  CassError rc = cass_future_error_code(future);
+
+  uv_mutex_lock(&detached->lock);
+  if (rc != CASS_OK) {
+    detached_error *error;
+    const char *message;
+    size_t message_len;
+
+    if (detached->count == DETACHED_ERRORS) {
+      detached->head = (detached->head + 1) % DETACHED_ERRORS;
+      detached->count--;
+    }
+    error = &detached->errors[(detached->head + detached->count) % DETACHED_ERRORS];
+    detached->count++;
+    detached->failed++;
+
+    cass_future_error_message(future, &message, &message_len);
+    if (message_len >= DETACHED_MESSAGE_SIZE)
+      message_len = DETACHED_MESSAGE_SIZE - 1;
+    memcpy(error->message, message, message_len);
+    error->message[message_len] = '\0';
+    error->code = rc;
+  }
+  detached->in_flight--;
+  uv_cond_signal(&detached->cond);
+  uv_mutex_unlock(&detached->lock);
+
+  detached_unref(detached);
+}
+
+php_driver_detached *
+php_driver_detached_new(size_t limit)
+{
+  php_driver_detached *detached =
+      (php_driver_detached *) calloc(1, sizeof(php_driver_detached));
+
+  uv_mutex_init(&detached->lock);
+  uv_cond_init(&detached->cond);
+  detached->refs  = 1;
+  detached->limit = limit;
+
+  return detached;
+}
+
+void
+php_driver_detached_free(php_driver_detached *detached)
+{
+  if (detached)
+    detached_unref(detached);
+}
+
+int
+php_driver_detached_reserve(php_driver_detached *detached, zval *timeout)
+{
+  cass_duration_t timeout_us;
+  uint64_t deadline = 0;
+  int timed_out = 0;
+
+  if (php_driver_future_get_timeout(timeout, &timeout_us) == FAILURE) {
+    return FAILURE;
+  }
+
+  if (timeout_us > 0)
+    deadline = uv_hrtime() + timeout_us * 1000;
+
+  uv_mutex_lock(&detached->lock);
+  while (detached->in_flight >= detached->limit) {
+    if (deadline == 0) {
+      uv_cond_wait(&detached->cond, &detached->lock);
+    } else {
+      uint64_t now = uv_hrtime();
+      if (now >= deadline) {
+        timed_out = 1;
+        break;
+      }
+      uv_cond_timedwait(&detached->cond, &detached->lock, deadline - now);
+    }
+  }
+  if (!timed_out) {
+    detached->in_flight++;
+    detached->refs++;
+  }
+  uv_mutex_unlock(&detached->lock);
+
+  if (timed_out) {
+    php_driver_future_throw_timeout(timeout_us);
+    return FAILURE;
+  }
+
+  return SUCCESS;
+}
+
+void
+php_driver_detached_release(php_driver_detached *detached)
+{
+  uv_mutex_lock(&detached->lock);
+  detached->in_flight--;
+  uv_cond_signal(&detached->cond);
+  uv_mutex_unlock(&detached->lock);
+
+  detached_unref(detached);
+}
+
+void
+php_driver_detached_add(php_driver_detached *detached, CassFuture *future)
+{
+  /* The driver keeps the future alive until the callback has returned */
+  if (php_driver_future_set_callback(future, detached_callback, detached) != CASS_OK)
+    detached_callback(future, detached);
+
+  cass_future_free(future);
+}
+
+void
+php_driver_detached_errors(php_driver_detached *detached, zval *return_value)
+{
+  detached_error *taken = NULL;
+  zend_long failed = 0;
+  size_t i, count = 0;
+  zval errors;
+
+  /* Copied out first so that callbacks never wait on PHP allocations */
+  if (detached) {
+    taken = (detached_error *) emalloc(sizeof(detached->errors));
+    uv_mutex_lock(&detached->lock);
+    for (; count < detached->count; count++)
+      taken[count] = detached->errors[(detached->head + count) % DETACHED_ERRORS];
+    failed = detached->failed;
+    detached->head   = 0;
+    detached->count  = 0;
+    detached->failed = 0;
+    uv_mutex_unlock(&detached->lock);
+  }
+
+  array_init(&errors);
+  for (i = 0; i < count; i++) {
+    zval exception;
+
+    zend_throw_exception_ex(exception_class(taken[i].code), taken[i].code,
+                            "%s", taken[i].message);
+    ZVAL_OBJ(&exception, EG(exception));
+    Z_ADDREF(exception);
+    zend_clear_exception();
+    add_next_index_zval(&errors, &exception);
+  }
+
+  if (taken)
+    efree(taken);
+
+  array_init(return_value);
+  add_assoc_long(return_value, "count", failed);
+  add_assoc_zval(return_value, "errors", &errors);
+}
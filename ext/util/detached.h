@@ -0,0 +1,39 @@
+/**
+ * Copyright 2015-2017 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PHP_DRIVER_UTIL_DETACHED_H
+#define PHP_DRIVER_UTIL_DETACHED_H
+
+/* Tracks requests whose results nobody waits for. Failures are counted and
+ * the most recent ones are kept until they are taken. */
+typedef struct php_driver_detached_ php_driver_detached;
+
+php_driver_detached *php_driver_detached_new(size_t limit);
+/* Requests still in flight may outlive the tracker */
+void php_driver_detached_free(php_driver_detached *detached);
+/* Waits until fewer than the limit of requests are in flight and reserves a
+ * slot for the next one */
+int  php_driver_detached_reserve(php_driver_detached *detached, zval *timeout);
+/* Gives back a reserved slot that wasn't used */
+void php_driver_detached_release(php_driver_detached *detached);
+/* Takes ownership of the future of a request in a reserved slot, which is
+ * released once the request completes */
+void php_driver_detached_add(php_driver_detached *detached, CassFuture *future);
+/* Stores the number of failures since the last call and the exceptions of
+ * the most recent ones */
+void php_driver_detached_errors(php_driver_detached *detached, zval *return_value);
+
+#endif /* PHP_DRIVER_UTIL_DETACHED_H */
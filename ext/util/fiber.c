@@ -0,0 +1,332 @@
+/**
+ * Copyright 2015-2017 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "php_driver.h"
+#include "php_driver_globals.h"
+#include "php_driver_types.h"
+#include "util/fiber.h"
+#include "util/future.h"
+
+#include <uv.h>
+
+ZEND_EXTERN_MODULE_GLOBALS(php_driver)
+
+#if PHP_VERSION_ID >= 80100
+#include <Zend/zend_fibers.h>
+
+struct php_driver_fiber_loop_ {
+  /* Held by run() and by every fiber suspended in await() */
+  unsigned int refs;
+  php_driver_future_queue *queue;
+  /* Fibers started by run(), keyed by object handle */
+  HashTable fibers;
+  /* What each suspended fiber waits for, keyed by object handle */
+  HashTable waiters;
+  /* Futures in the queue that haven't been taken yet */
+  HashTable futures;
+};
+
+typedef struct {
+  CassFuture *future;
+  uint64_t deadline;
+} fiber_waiter;
+
+static void
+fiber_waiter_dtor(zval *waiter)
+{
+  efree(Z_PTR_P(waiter));
+}
+
+static php_driver_fiber_loop *
+fiber_loop_new()
+{
+  php_driver_fiber_loop *loop = emalloc(sizeof(php_driver_fiber_loop));
+
+  loop->refs  = 1;
+  loop->queue = php_driver_future_queue_new(16);
+  zend_hash_init(&loop->fibers, 0, NULL, ZVAL_PTR_DTOR, 0);
+  zend_hash_init(&loop->waiters, 0, NULL, fiber_waiter_dtor, 0);
+  zend_hash_init(&loop->futures, 0, NULL, NULL, 0);
+
+  return loop;
+}
+
+static void
+fiber_loop_release(php_driver_fiber_loop *loop)
+{
+  if (--loop->refs > 0)
+    return;
+
+  php_driver_future_queue_free(loop->queue);
+  zend_hash_destroy(&loop->fibers);
+  zend_hash_destroy(&loop->waiters);
+  zend_hash_destroy(&loop->futures);
+  efree(loop);
+}
+
+static int
+fiber_call(zval *fiber, const char *method, size_t method_len, zval *retval)
+{
+  ZVAL_UNDEF(retval);
+  zend_call_method(Z_OBJ_P(fiber), zend_ce_fiber, NULL,
+                   method, method_len, retval, 0, NULL, NULL);
+
+  return EG(exception) ? FAILURE : SUCCESS;
+}
+
+/* Resumes the fibers whose futures resolved or whose timeouts expired */
+static int
+fiber_loop_resume(php_driver_fiber_loop *loop, CassFuture *resolved, int all)
+{
+  zend_ulong *handles;
+  zend_ulong handle;
+  fiber_waiter *waiter;
+  uint64_t now = uv_hrtime();
+  size_t i, count = 0;
+  int result = SUCCESS;
+
+  handles = safe_emalloc(zend_hash_num_elements(&loop->waiters), sizeof(zend_ulong), 0);
+
+  ZEND_HASH_FOREACH_NUM_KEY_PTR(&loop->waiters, handle, waiter) {
+    /* A future that resolved at the address of the one waited on has to be
+     * added to the queue again by await() */
+    if (all ||
+        waiter->future == resolved ||
+        cass_future_ready(waiter->future) ||
+        (waiter->deadline > 0 && now >= waiter->deadline)) {
+      handles[count++] = handle;
+    }
+  } ZEND_HASH_FOREACH_END();
+
+  for (i = 0; i < count && result == SUCCESS; i++) {
+    zval *fiber = zend_hash_index_find(&loop->fibers, handles[i]);
+    zval retval;
+
+    if (fiber) {
+      result = fiber_call(fiber, "resume", sizeof("resume") - 1, &retval);
+      zval_ptr_dtor(&retval);
+    }
+  }
+
+  efree(handles);
+
+  return result;
+}
+
+static int
+fiber_loop_run(php_driver_fiber_loop *loop, HashTable *tasks, zval *fibers)
+{
+  zend_string *key;
+  zend_ulong index;
+  zval *task;
+  zval *fiber;
+  zval retval;
+
+  ZEND_HASH_FOREACH_KEY_VAL(tasks, index, key, task) {
+    zval object;
+
+    object_init_ex(&object, zend_ce_fiber);
+    zend_call_known_instance_method_with_1_params(zend_ce_fiber->constructor,
+                                                  Z_OBJ(object), NULL, task);
+    if (EG(exception)) {
+      zval_ptr_dtor(&object);
+      return FAILURE;
+    }
+
+    if (key) {
+      zend_hash_update(Z_ARRVAL_P(fibers), key, &object);
+    } else {
+      zend_hash_index_update(Z_ARRVAL_P(fibers), index, &object);
+    }
+    Z_ADDREF(object);
+    zend_hash_index_update(&loop->fibers, Z_OBJ_HANDLE(object), &object);
+  } ZEND_HASH_FOREACH_END();
+
+  ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(fibers), fiber) {
+    int result = fiber_call(fiber, "start", sizeof("start") - 1, &retval);
+    zval_ptr_dtor(&retval);
+    if (result == FAILURE)
+      return FAILURE;
+  } ZEND_HASH_FOREACH_END();
+
+  while (zend_hash_num_elements(&loop->waiters) > 0) {
+    CassFuture *resolved;
+    fiber_waiter *waiter;
+    uint64_t deadline = 0;
+
+    ZEND_HASH_FOREACH_PTR(&loop->waiters, waiter) {
+      if (waiter->deadline > 0 && (deadline == 0 || waiter->deadline < deadline))
+        deadline = waiter->deadline;
+    } ZEND_HASH_FOREACH_END();
+
+    resolved = php_driver_future_queue_wait_until(loop->queue, deadline);
+    if (resolved)
+      zend_hash_index_del(&loop->futures, (zend_ulong) (uintptr_t) resolved);
+
+    /* Nothing is pending and nothing timed out, so let the waiters retry
+     * rather than wait forever */
+    if (fiber_loop_resume(loop, resolved,
+                          !resolved && deadline == 0) == FAILURE)
+      return FAILURE;
+  }
+
+  return SUCCESS;
+}
+
+int
+php_driver_fiber_run(HashTable *tasks, zval *return_value)
+{
+  php_driver_fiber_loop *loop;
+  zend_string *key;
+  zend_ulong index;
+  zval fibers;
+  zval *fiber;
+  int result;
+
+  if (PHP_DRIVER_G(fiber_loop)) {
+    zend_throw_exception_ex(php_driver_logic_exception_ce, 0,
+                            "Tasks are already running");
+    return FAILURE;
+  }
+
+  loop = fiber_loop_new();
+  PHP_DRIVER_G(fiber_loop) = loop;
+
+  array_init(&fibers);
+  array_init(return_value);
+
+  result = fiber_loop_run(loop, tasks, &fibers);
+
+  ZEND_HASH_FOREACH_KEY_VAL(Z_ARRVAL(fibers), index, key, fiber) {
+    zval retval;
+
+    if (result == FAILURE)
+      break;
+
+    result = fiber_call(fiber, "isTerminated", sizeof("isTerminated") - 1, &retval);
+    if (result == SUCCESS && Z_TYPE(retval) != IS_TRUE) {
+      zend_throw_exception_ex(php_driver_logic_exception_ce, 0,
+                              "A task was suspended by something other than the driver");
+      result = FAILURE;
+    }
+    zval_ptr_dtor(&retval);
+    if (result == FAILURE)
+      break;
+
+    result = fiber_call(fiber, "getReturn", sizeof("getReturn") - 1, &retval);
+    if (result == FAILURE)
+      break;
+
+    if (key) {
+      zend_hash_update(Z_ARRVAL_P(return_value), key, &retval);
+    } else {
+      zend_hash_index_update(Z_ARRVAL_P(return_value), index, &retval);
+    }
+  } ZEND_HASH_FOREACH_END();
+
+  /* Fibers destroyed while suspended unwind through await() */
+  PHP_DRIVER_G(fiber_loop) = NULL;
+  zval_ptr_dtor(&fibers);
+  zend_hash_clean(&loop->fibers);
+  fiber_loop_release(loop);
+
+  return result;
+}
+
+int
+php_driver_fiber_await(CassFuture *future, cass_duration_t timeout_us, int *suspended)
+{
+  php_driver_fiber_loop *loop = PHP_DRIVER_G(fiber_loop);
+  zend_ulong handle;
+  uint64_t deadline = 0;
+  int result = SUCCESS;
+
+  *suspended = 0;
+
+  if (!loop || !EG(active_fiber) || zend_fiber_switch_blocked())
+    return SUCCESS;
+
+  handle = EG(active_fiber)->std.handle;
+  if (!zend_hash_index_exists(&loop->fibers, handle))
+    return SUCCESS;
+
+  if (timeout_us > 0)
+    deadline = uv_hrtime() + timeout_us * 1000;
+
+  loop->refs++;
+
+  while (!cass_future_ready(future)) {
+    zend_ulong key = (zend_ulong) (uintptr_t) future;
+    fiber_waiter *waiter;
+    zval retval;
+
+    /* Futures that already have a callback can only be blocked on */
+    if (!zend_hash_index_exists(&loop->futures, key)) {
+      if (php_driver_future_queue_try_add(loop->queue, future) != CASS_OK) {
+        *suspended = 0;
+        break;
+      }
+      zend_hash_index_add_empty_element(&loop->futures, key);
+    }
+
+    waiter = emalloc(sizeof(fiber_waiter));
+    waiter->future   = future;
+    waiter->deadline = deadline;
+    zend_hash_index_update_ptr(&loop->waiters, handle, waiter);
+
+    *suspended = 1;
+    ZVAL_UNDEF(&retval);
+    zend_call_method(NULL, zend_ce_fiber, NULL, "suspend", sizeof("suspend") - 1,
+                     &retval, 0, NULL, NULL);
+    zval_ptr_dtor(&retval);
+    zend_hash_index_del(&loop->waiters, handle);
+
+    if (EG(exception)) {
+      result = FAILURE;
+      break;
+    }
+
+    /* Resumed by someone else after run() returned */
+    if (PHP_DRIVER_G(fiber_loop) != loop) {
+      *suspended = 0;
+      break;
+    }
+
+    if (deadline > 0 && uv_hrtime() >= deadline)
+      break;
+  }
+
+  fiber_loop_release(loop);
+
+  return result;
+}
+#else
+int
+php_driver_fiber_run(HashTable *tasks, zval *return_value)
+{
+  zend_throw_exception_ex(php_driver_logic_exception_ce, 0,
+                          "Running tasks in fibers requires PHP 8.1 or later");
+  return FAILURE;
+}
+
+int
+php_driver_fiber_await(CassFuture *future, cass_duration_t timeout_us, int *suspended)
+{
+  *suspended = 0;
+
+  return SUCCESS;
+}
+#endif
@@ -0,0 +1,30 @@
+/**
+ * Copyright 2015-2017 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PHP_DRIVER_UTIL_FIBER_H
+#define PHP_DRIVER_UTIL_FIBER_H
+
+typedef struct php_driver_fiber_loop_ php_driver_fiber_loop;
+
+/* Runs every task in its own fiber until all of them have returned and
+ * stores their return values under the keys of the tasks */
+int php_driver_fiber_run(HashTable *tasks, zval *return_value);
+/* Suspends the current fiber until the future resolves or the timeout in
+ * microseconds expires, if the fiber was started by php_driver_fiber_run().
+ * Leaves suspended at 0 when the caller has to block instead. */
+int php_driver_fiber_await(CassFuture *future, cass_duration_t timeout_us, int *suspended);
+
+#endif /* PHP_DRIVER_UTIL_FIBER_H */
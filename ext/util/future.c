@@ -17,33 +17,236 @@
 #include "php_driver.h"
 #include "php_driver_types.h"
 #include "future.h"
+#include "fiber.h"
 
-int
-php_driver_future_wait_timed(CassFuture *future, zval *timeout)
+#include <uv.h>
+
+#ifndef PHP_WIN32
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/* Futures waited on together all signal this condition when they resolve */
+static uv_once_t notify_once = UV_ONCE_INIT;
+static uv_mutex_t notify_lock;
+static uv_cond_t notify_cond;
+
+static void
+notify_initialize()
 {
-  cass_duration_t timeout_us;
+  uv_mutex_init(&notify_lock);
+  uv_cond_init(&notify_cond);
+}
 
-  if (cass_future_ready(future)) return SUCCESS;
+static void
+notify_all()
+{
+  uv_once(&notify_once, notify_initialize);
+  uv_mutex_lock(&notify_lock);
+  uv_cond_broadcast(&notify_cond);
+  uv_mutex_unlock(&notify_lock);
+}
+
+/* The driver only takes one callback per future, so the callbacks registered
+ * through php_driver_future_set_callback() are chained and dispatched by a
+ * single one. Chains are removed once they have been dispatched. */
+#define CHAIN_BUCKETS 64
+
+typedef struct future_link_ {
+  CassFutureCallback callback;
+  void *data;
+  struct future_link_ *next;
+} future_link;
+
+typedef struct future_chain_ {
+  CassFuture *future;
+  future_link *first;
+  future_link **last;
+  struct future_chain_ *next;
+} future_chain;
+
+static uv_once_t chain_once = UV_ONCE_INIT;
+static uv_mutex_t chain_lock;
+static future_chain *chains[CHAIN_BUCKETS];
+
+static void
+chain_initialize()
+{
+  uv_mutex_init(&chain_lock);
+}
+
+/* Must be called with the lock held */
+static future_chain **
+chain_find(CassFuture *future)
+{
+  future_chain **chain = &chains[((uintptr_t) future >> 4) % CHAIN_BUCKETS];
+
+  while (*chain && (*chain)->future != future)
+    chain = &(*chain)->next;
+
+  return chain;
+}
+
+static void
+chain_free(future_chain *chain)
+{
+  while (chain->first) {
+    future_link *link = chain->first;
+    chain->first = link->next;
+    free(link);
+  }
+  free(chain);
+}
+
+/* Runs on the driver's I/O threads, so only plain allocations are allowed */
+static void
+chain_dispatch(CassFuture *future, void *data)
+{
+  future_chain *chain;
+  future_link *link;
+
+  uv_mutex_lock(&chain_lock);
+  chain = *chain_find(future);
+  if (chain)
+    *chain_find(future) = chain->next;
+  uv_mutex_unlock(&chain_lock);
+
+  if (!chain)
+    return;
+
+  for (link = chain->first; link; link = link->next)
+    link->callback(future, link->data);
+
+  chain_free(chain);
+}
+
+CassError
+php_driver_future_set_callback(CassFuture *future, CassFutureCallback callback, void *data)
+{
+  future_link *link = (future_link *) malloc(sizeof(future_link));
+  future_chain *chain;
+  CassError rc;
+
+  link->callback = callback;
+  link->data     = data;
+  link->next     = NULL;
+
+  uv_once(&chain_once, chain_initialize);
+
+  uv_mutex_lock(&chain_lock);
+  chain = *chain_find(future);
+  if (chain) {
+    future_link *other;
+
+    /* Repeated waits on the same future only need to be notified once */
+    for (other = chain->first; other; other = other->next) {
+      if (other->callback == callback && other->data == data)
+        break;
+    }
+    if (other) {
+      free(link);
+    } else {
+      *chain->last = link;
+      chain->last  = &link->next;
+    }
+    uv_mutex_unlock(&chain_lock);
+    return CASS_OK;
+  }
+
+  chain = (future_chain *) malloc(sizeof(future_chain));
+  chain->future = future;
+  chain->first  = link;
+  chain->last   = &link->next;
+  chain->next   = NULL;
+  *chain_find(future) = chain;
+  uv_mutex_unlock(&chain_lock);
+
+  /* The chain is dispatched right away when the future is already resolved */
+  rc = cass_future_set_callback(future, chain_dispatch, NULL);
+
+  if (rc != CASS_OK) {
+    uv_mutex_lock(&chain_lock);
+    if (*chain_find(future) == chain)
+      *chain_find(future) = chain->next;
+    uv_mutex_unlock(&chain_lock);
+    chain_free(chain);
+  }
+
+  return rc;
+}
+
+struct php_driver_future_queue_ {
+  uv_mutex_t lock;
+  uv_cond_t cond;
+  /* Held by the owner and by every future whose callback hasn't run */
+  unsigned int refs;
+  size_t pending;
+  /* Ring of resolved futures not taken yet */
+  CassFuture **completed;
+  size_t capacity;
+  size_t head;
+  size_t count;
+  /* Pipe that is readable while resolved futures are waiting, if opened */
+  int fds[2];
+};
+
+int
+php_driver_future_get_timeout(zval *timeout, cass_duration_t *timeout_us)
+{
+  *timeout_us = 0;
 
   if (timeout == NULL ||
       Z_TYPE_P(timeout) == IS_NULL ||
       Z_TYPE_P(timeout) == IS_UNDEF) {
+    return SUCCESS;
+  }
 
-    cass_future_wait(future);
+  if ((Z_TYPE_P(timeout) == IS_LONG && Z_LVAL_P(timeout) > 0)) {
+    *timeout_us = Z_LVAL_P(timeout) * 1000000;
+  } else if ((Z_TYPE_P(timeout) == IS_DOUBLE && Z_DVAL_P(timeout) > 0)) {
+    *timeout_us = ceil(Z_DVAL_P(timeout) * 1000000);
   } else {
-    if ((Z_TYPE_P(timeout) == IS_LONG && Z_LVAL_P(timeout) > 0)) {
-      timeout_us = Z_LVAL_P(timeout) * 1000000;
-    } else if ((Z_TYPE_P(timeout) == IS_DOUBLE && Z_DVAL_P(timeout) > 0)) {
-      timeout_us = ceil(Z_DVAL_P(timeout) * 1000000);
-    } else {
-      INVALID_ARGUMENT_VALUE(timeout, "an positive number of seconds or null", FAILURE);
-    }
+    INVALID_ARGUMENT_VALUE(timeout, "an positive number of seconds or null", FAILURE);
+  }
+
+  return SUCCESS;
+}
 
-    if (!cass_future_wait_timed(future, timeout_us)) {
-      zend_throw_exception_ex(php_driver_timeout_exception_ce, 0,
-                              "Future hasn't resolved within %f seconds", timeout_us / 1000000.0);
+void
+php_driver_future_throw_timeout(cass_duration_t timeout_us)
+{
+  zend_throw_exception_ex(php_driver_timeout_exception_ce, 0,
+                          "Future hasn't resolved within %f seconds", timeout_us / 1000000.0);
+}
+
+int
+php_driver_future_wait_timed(CassFuture *future, zval *timeout)
+{
+  cass_duration_t timeout_us;
+  int suspended;
+
+  if (cass_future_ready(future)) return SUCCESS;
+
+  if (php_driver_future_get_timeout(timeout, &timeout_us) == FAILURE) {
+    return FAILURE;
+  }
+
+  /* Inside Fibers::run() other tasks keep running in the meantime */
+  if (php_driver_fiber_await(future, timeout_us, &suspended) == FAILURE) {
+    return FAILURE;
+  }
+
+  if (suspended) {
+    if (!cass_future_ready(future)) {
+      php_driver_future_throw_timeout(timeout_us);
       return FAILURE;
     }
+  } else if (timeout_us == 0) {
+    cass_future_wait(future);
+  } else if (!cass_future_wait_timed(future, timeout_us)) {
+    php_driver_future_throw_timeout(timeout_us);
+    return FAILURE;
   }
 
   return SUCCESS;
@@ -63,3 +266,389 @@ php_driver_future_is_error(CassFuture *future)
   }
   return SUCCESS;
 }
+
+void
+php_driver_future_error(CassFuture *future, zval *exception)
+{
+  ZVAL_UNDEF(exception);
+
+  if (php_driver_future_is_error(future) == FAILURE) {
+    ZVAL_OBJ(exception, EG(exception));
+    Z_ADDREF_P(exception);
+    zend_clear_exception();
+  }
+}
+
+static void
+future_queue_unref(php_driver_future_queue *queue)
+{
+  int last;
+
+  uv_mutex_lock(&queue->lock);
+  last = --queue->refs == 0;
+  uv_mutex_unlock(&queue->lock);
+
+  if (last) {
+#ifndef PHP_WIN32
+    if (queue->fds[0] >= 0) {
+      close(queue->fds[0]);
+      close(queue->fds[1]);
+    }
+#endif
+    uv_cond_destroy(&queue->cond);
+    uv_mutex_destroy(&queue->lock);
+    free(queue->completed);
+    free(queue);
+  }
+}
+
+/* Must be called with the lock held */
+static void
+future_queue_wake(php_driver_future_queue *queue)
+{
+  uv_cond_signal(&queue->cond);
+#ifndef PHP_WIN32
+  if (queue->fds[1] >= 0) {
+    char token = 0;
+    /* A full pipe is readable already, so the token can be dropped */
+    if (write(queue->fds[1], &token, 1) < 0) { }
+  }
+#endif
+}
+
+/* Runs on the driver's I/O threads, so only plain allocations are allowed */
+static void
+future_queue_callback(CassFuture *future, void *data)
+{
+  php_driver_future_queue *queue = (php_driver_future_queue *) data;
+
+  uv_mutex_lock(&queue->lock);
+  queue->completed[(queue->head + queue->count) % queue->capacity] = future;
+  queue->count++;
+  queue->pending--;
+  future_queue_wake(queue);
+  uv_mutex_unlock(&queue->lock);
+
+  /* Also wake up waits on futures that are in a queue */
+  notify_all();
+
+  future_queue_unref(queue);
+}
+
+php_driver_future_queue *
+php_driver_future_queue_new(size_t capacity)
+{
+  php_driver_future_queue *queue =
+    (php_driver_future_queue *) malloc(sizeof(php_driver_future_queue));
+
+  if (capacity == 0)
+    capacity = 1;
+
+  uv_mutex_init(&queue->lock);
+  uv_cond_init(&queue->cond);
+  queue->refs      = 1;
+  queue->pending   = 0;
+  queue->completed = (CassFuture **) malloc(capacity * sizeof(CassFuture *));
+  queue->capacity  = capacity;
+  queue->head      = 0;
+  queue->count     = 0;
+  queue->fds[0]    = -1;
+  queue->fds[1]    = -1;
+
+  return queue;
+}
+
+void
+php_driver_future_queue_free(php_driver_future_queue *queue)
+{
+  future_queue_unref(queue);
+}
+
+CassError
+php_driver_future_queue_try_add(php_driver_future_queue *queue, CassFuture *future)
+{
+  CassError rc;
+
+  uv_mutex_lock(&queue->lock);
+  if (queue->pending + queue->count == queue->capacity) {
+    size_t i, capacity = queue->capacity * 2;
+    CassFuture **completed = (CassFuture **) malloc(capacity * sizeof(CassFuture *));
+    for (i = 0; i < queue->count; i++)
+      completed[i] = queue->completed[(queue->head + i) % queue->capacity];
+    free(queue->completed);
+    queue->completed = completed;
+    queue->capacity  = capacity;
+    queue->head      = 0;
+  }
+  queue->refs++;
+  queue->pending++;
+  uv_mutex_unlock(&queue->lock);
+
+  /* The callback runs right away when the future is already resolved */
+  rc = php_driver_future_set_callback(future, future_queue_callback, queue);
+
+  if (rc != CASS_OK) {
+    /* A future whose callbacks were dispatched already has resolved */
+    int resolved = rc == CASS_ERROR_LIB_CALLBACK_ALREADY_SET && cass_future_ready(future);
+
+    uv_mutex_lock(&queue->lock);
+    queue->refs--;
+    queue->pending--;
+    if (resolved) {
+      queue->completed[(queue->head + queue->count) % queue->capacity] = future;
+      queue->count++;
+      future_queue_wake(queue);
+    }
+    uv_mutex_unlock(&queue->lock);
+
+    if (!resolved)
+      return rc;
+  }
+
+  return CASS_OK;
+}
+
+int
+php_driver_future_queue_add(php_driver_future_queue *queue, CassFuture *future)
+{
+  CassError rc = php_driver_future_queue_try_add(queue, future);
+
+  if (rc != CASS_OK) {
+    zend_throw_exception_ex(php_driver_logic_exception_ce, rc,
+                            "The future is already being waited on: %s",
+                            cass_error_desc(rc));
+    return FAILURE;
+  }
+
+  return SUCCESS;
+}
+
+void
+php_driver_future_queue_wake(php_driver_future_queue *queue)
+{
+  uv_mutex_lock(&queue->lock);
+  future_queue_wake(queue);
+  uv_mutex_unlock(&queue->lock);
+}
+
+/* Returns 0 when the deadline passes before a future resolves */
+static int
+future_queue_take(php_driver_future_queue *queue, uint64_t deadline, CassFuture **future)
+{
+  int timed_out = 0;
+
+  *future = NULL;
+
+  uv_mutex_lock(&queue->lock);
+  while (queue->count == 0 && queue->pending > 0) {
+    if (deadline == 0) {
+      uv_cond_wait(&queue->cond, &queue->lock);
+    } else {
+      uint64_t now = uv_hrtime();
+      if (now >= deadline) {
+        timed_out = 1;
+        break;
+      }
+      uv_cond_timedwait(&queue->cond, &queue->lock, deadline - now);
+    }
+  }
+
+  if (queue->count > 0) {
+    *future = queue->completed[queue->head];
+    queue->head = (queue->head + 1) % queue->capacity;
+    queue->count--;
+  }
+  uv_mutex_unlock(&queue->lock);
+
+  return !timed_out;
+}
+
+int
+php_driver_future_queue_next(php_driver_future_queue *queue, zval *timeout, CassFuture **future)
+{
+  cass_duration_t timeout_us;
+  uint64_t deadline = 0;
+
+  if (php_driver_future_get_timeout(timeout, &timeout_us) == FAILURE) {
+    return FAILURE;
+  }
+
+  if (timeout_us > 0)
+    deadline = uv_hrtime() + timeout_us * 1000;
+
+  if (!future_queue_take(queue, deadline, future)) {
+    php_driver_future_throw_timeout(timeout_us);
+    return FAILURE;
+  }
+
+  return SUCCESS;
+}
+
+CassFuture *
+php_driver_future_queue_wait_until(php_driver_future_queue *queue, uint64_t deadline)
+{
+  CassFuture *future;
+
+  future_queue_take(queue, deadline, &future);
+
+  return future;
+}
+
+CassFuture *
+php_driver_future_queue_poll(php_driver_future_queue *queue)
+{
+  CassFuture *future = NULL;
+
+  uv_mutex_lock(&queue->lock);
+  if (queue->count > 0) {
+    future = queue->completed[queue->head];
+    queue->head = (queue->head + 1) % queue->capacity;
+    queue->count--;
+  }
+#ifndef PHP_WIN32
+  /* Tokens are written along with futures, so none are left once empty */
+  if (queue->count == 0 && queue->fds[0] >= 0) {
+    char tokens[64];
+    while (read(queue->fds[0], tokens, sizeof(tokens)) > 0);
+  }
+#endif
+  uv_mutex_unlock(&queue->lock);
+
+  return future;
+}
+
+size_t
+php_driver_future_queue_size(php_driver_future_queue *queue)
+{
+  size_t size;
+
+  uv_mutex_lock(&queue->lock);
+  size = queue->pending + queue->count;
+  uv_mutex_unlock(&queue->lock);
+
+  return size;
+}
+
+int
+php_driver_future_queue_fd(php_driver_future_queue *queue)
+{
+#ifndef PHP_WIN32
+  int fd = -1;
+
+  uv_mutex_lock(&queue->lock);
+  if (queue->fds[0] < 0 && pipe(queue->fds) == 0) {
+    fcntl(queue->fds[0], F_SETFL, fcntl(queue->fds[0], F_GETFL) | O_NONBLOCK);
+    fcntl(queue->fds[1], F_SETFL, fcntl(queue->fds[1], F_GETFL) | O_NONBLOCK);
+    fcntl(queue->fds[0], F_SETFD, FD_CLOEXEC);
+    fcntl(queue->fds[1], F_SETFD, FD_CLOEXEC);
+
+    /* Futures that resolved before the pipe existed */
+    if (queue->count > 0) {
+      char token = 0;
+      if (write(queue->fds[1], &token, 1) < 0) { }
+    }
+  }
+  /* The caller owns a duplicate, the queue keeps its own read end open so
+   * that writes never fail with a broken pipe */
+  if (queue->fds[0] >= 0)
+    fd = dup(queue->fds[0]);
+  uv_mutex_unlock(&queue->lock);
+
+  return fd;
+#else
+  return -1;
+#endif
+}
+
+int
+php_driver_future_get_handle(zval *future, CassFuture **handle)
+{
+  zend_class_entry *ce = Z_OBJCE_P(future);
+
+  *handle = NULL;
+
+  if (ce == php_driver_future_rows_ce) {
+    php_driver_future_rows *future_rows = PHP_DRIVER_GET_FUTURE_ROWS(future);
+    if (!future_rows->result)
+      *handle = future_rows->future;
+  } else if (ce == php_driver_future_prepared_statement_ce) {
+    *handle = PHP_DRIVER_GET_FUTURE_PREPARED_STATEMENT(future)->future;
+  } else if (ce == php_driver_future_session_ce) {
+    *handle = PHP_DRIVER_GET_FUTURE_SESSION(future)->future;
+  } else if (ce == php_driver_future_close_ce) {
+    *handle = PHP_DRIVER_GET_FUTURE_CLOSE(future)->future;
+  } else if (ce != php_driver_future_value_ce) {
+    return FAILURE;
+  }
+
+  return SUCCESS;
+}
+
+static void
+notify_callback(CassFuture *future, void *data)
+{
+  notify_all();
+}
+
+static size_t
+count_ready(CassFuture **futures, size_t count)
+{
+  size_t i, ready = 0;
+
+  for (i = 0; i < count; i++) {
+    if (!futures[i] || cass_future_ready(futures[i]))
+      ready++;
+  }
+
+  return ready;
+}
+
+int
+php_driver_future_wait_many(CassFuture **futures, size_t count, size_t needed, zval *timeout)
+{
+  cass_duration_t timeout_us;
+  uint64_t deadline = 0;
+  int timed_out = 0;
+  size_t i;
+
+  if (php_driver_future_get_timeout(timeout, &timeout_us) == FAILURE) {
+    return FAILURE;
+  }
+
+  if (count_ready(futures, count) >= needed) {
+    return SUCCESS;
+  }
+
+  uv_once(&notify_once, notify_initialize);
+
+  /* Futures that are already being waited on signal the same condition */
+  for (i = 0; i < count; i++) {
+    if (futures[i])
+      php_driver_future_set_callback(futures[i], notify_callback, NULL);
+  }
+
+  if (timeout_us > 0)
+    deadline = uv_hrtime() + timeout_us * 1000;
+
+  uv_mutex_lock(&notify_lock);
+  while (count_ready(futures, count) < needed) {
+    if (timeout_us == 0) {
+      uv_cond_wait(&notify_cond, &notify_lock);
+    } else {
+      uint64_t now = uv_hrtime();
+      if (now >= deadline) {
+        timed_out = 1;
+        break;
+      }
+      uv_cond_timedwait(&notify_cond, &notify_lock, deadline - now);
+    }
+  }
+  uv_mutex_unlock(&notify_lock);
+
+  if (timed_out) {
+    php_driver_future_throw_timeout(timeout_us);
+    return FAILURE;
+  }
+
+  return SUCCESS;
+}
@@ -17,7 +17,54 @@
 #ifndef PHP_DRIVER_UTIL_FUTURE_H
 #define PHP_DRIVER_UTIL_FUTURE_H
 
+/* Converts a timeout in seconds to microseconds, 0 meaning no timeout */
+int  php_driver_future_get_timeout(zval *timeout, cass_duration_t *timeout_us);
+void php_driver_future_throw_timeout(cass_duration_t timeout_us);
 int  php_driver_future_wait_timed(CassFuture *future, zval *timeout);
 int  php_driver_future_is_error(CassFuture *future);
+/* Stores the exception for a failed future without throwing it, and leaves
+ * the zval undefined when the future succeeded */
+void php_driver_future_error(CassFuture *future, zval *exception);
+
+/* Same as cass_future_set_callback() but any number of callbacks can be set.
+ * The same callback and data are only registered once. Fails with
+ * CASS_ERROR_LIB_CALLBACK_ALREADY_SET once the callbacks have been run. */
+CassError php_driver_future_set_callback(CassFuture *future, CassFutureCallback callback,
+                                         void *data);
+
+/* Finds the future of an instance of one of the driver's Future classes,
+ * which is NULL when the instance is already resolved */
+int  php_driver_future_get_handle(zval *future, CassFuture **handle);
+/* Waits until at least the needed number of futures have resolved; NULL
+ * futures count as resolved */
+int  php_driver_future_wait_many(CassFuture **futures, size_t count, size_t needed,
+                                 zval *timeout);
+
+/* Collects futures in the order they resolve. The capacity is a hint for the
+ * number of futures that are added but not taken yet at any time. */
+typedef struct php_driver_future_queue_ php_driver_future_queue;
+
+php_driver_future_queue *php_driver_future_queue_new(size_t capacity);
+/* Futures that haven't resolved yet may outlive the queue */
+void php_driver_future_queue_free(php_driver_future_queue *queue);
+int  php_driver_future_queue_add(php_driver_future_queue *queue, CassFuture *future);
+/* Same as add() but returns the error instead of throwing it */
+CassError php_driver_future_queue_try_add(php_driver_future_queue *queue, CassFuture *future);
+/* Waits for the next resolved future, which is NULL once none are pending */
+int  php_driver_future_queue_next(php_driver_future_queue *queue, zval *timeout,
+                                  CassFuture **future);
+/* Waits until the next future resolves or the uv_hrtime() deadline passes,
+ * where 0 means no deadline. Returns NULL on timeout or if none are pending. */
+CassFuture *php_driver_future_queue_wait_until(php_driver_future_queue *queue,
+                                               uint64_t deadline);
+/* Makes the descriptor readable, for futures that resolved on their own */
+void php_driver_future_queue_wake(php_driver_future_queue *queue);
+/* Takes the next resolved future without waiting, or NULL */
+CassFuture *php_driver_future_queue_poll(php_driver_future_queue *queue);
+/* The number of futures added and not taken yet */
+size_t php_driver_future_queue_size(php_driver_future_queue *queue);
+/* Returns a new descriptor that is readable while resolved futures wait to
+ * be taken, or -1 when pipes are not available */
+int  php_driver_future_queue_fd(php_driver_future_queue *queue);
 
 #endif /* PHP_DRIVER_UTIL_FUTURE_H */
@@ -0,0 +1,138 @@
+/**
+ * Copyright 2015-2017 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "php_driver.h"
+#include "php_driver_types.h"
+#include "util/prepared_cache.h"
+#include "util/ref.h"
+
+/* Upper bound on the number of cached statements; applications that build
+ * their CQL dynamically would otherwise grow the cache without limit */
+#define PHP_DRIVER_PREPARED_CACHE_SIZE 1024
+
+typedef struct {
+  HashTable entries;
+  cass_uint32_t schema_version;
+  char *keyspace;
+} php_driver_prepared_cache;
+
+static void
+free_prepared(void *prepared)
+{
+  cass_prepared_free((const CassPrepared *) prepared);
+}
+
+static void
+free_entry(zval *entry)
+{
+  php_driver_ref *ref = (php_driver_ref *) Z_PTR_P(entry);
+  php_driver_del_peref(&ref, 1);
+}
+
+static void
+free_cache(void *data)
+{
+  php_driver_prepared_cache *cache = (php_driver_prepared_cache *) data;
+
+  zend_hash_destroy(&cache->entries);
+  if (cache->keyspace)
+    pefree(cache->keyspace, 1);
+  pefree(cache, 1);
+}
+
+static size_t
+cache_key(php_driver_prepared_cache *cache, const char *cql, size_t cql_len, char **key)
+{
+  return spprintf(key, 0, "%s:%.*s", SAFE_STR(cache->keyspace), (int) cql_len, cql);
+}
+
+php_driver_ref *
+php_driver_prepared_cache_new(const char *keyspace)
+{
+  php_driver_prepared_cache *cache =
+    (php_driver_prepared_cache *) pecalloc(1, sizeof(php_driver_prepared_cache), 1);
+
+  zend_hash_init(&cache->entries, 0, NULL, free_entry, 1);
+  cache->schema_version = 0;
+  cache->keyspace = keyspace ? pestrdup(keyspace, 1) : NULL;
+
+  return php_driver_new_peref(cache, free_cache, 1);
+}
+
+php_driver_ref *
+php_driver_prepared_cache_find(php_driver_ref *cache_ref, CassSession *session,
+                               const char *cql, size_t cql_len)
+{
+  php_driver_prepared_cache *cache = (php_driver_prepared_cache *) cache_ref->data;
+  const CassSchemaMeta *meta;
+  cass_uint32_t version;
+  zval *entry;
+  char *key;
+  size_t key_len;
+
+  meta = cass_session_get_schema_meta(session);
+  version = cass_schema_meta_snapshot_version(meta);
+  cass_schema_meta_free(meta);
+
+  /* Result and parameter metadata of cached statements may be stale */
+  if (version != cache->schema_version) {
+    zend_hash_clean(&cache->entries);
+    cache->schema_version = version;
+    return NULL;
+  }
+
+  key_len = cache_key(cache, cql, cql_len, &key);
+  entry = zend_hash_str_find(&cache->entries, key, key_len);
+  efree(key);
+
+  return entry ? (php_driver_ref *) Z_PTR_P(entry) : NULL;
+}
+
+php_driver_ref *
+php_driver_prepared_cache_add(php_driver_ref *cache_ref,
+                              const char *cql, size_t cql_len,
+                              const CassPrepared *prepared)
+{
+  php_driver_prepared_cache *cache = (php_driver_prepared_cache *) cache_ref->data;
+  php_driver_ref *ref = php_driver_new_peref((void *) prepared, free_prepared, 1);
+  char *key;
+  size_t key_len;
+
+  if (zend_hash_num_elements(&cache->entries) >= PHP_DRIVER_PREPARED_CACHE_SIZE)
+    zend_hash_clean(&cache->entries);
+
+  key_len = cache_key(cache, cql, cql_len, &key);
+  zend_hash_str_update_ptr(&cache->entries, key, key_len, ref);
+  efree(key);
+
+  return ref;
+}
+
+void
+php_driver_prepared_cache_use(php_driver_ref *cache_ref,
+                              const char *keyspace, size_t keyspace_len)
+{
+  php_driver_prepared_cache *cache = (php_driver_prepared_cache *) cache_ref->data;
+
+  if (cache->keyspace)
+    pefree(cache->keyspace, 1);
+  cache->keyspace = pestrndup(keyspace, keyspace_len, 1);
+
+  /* The statement may still fail, e.g. for a keyspace that doesn't exist,
+   * and leave the session where it was. Entries prepared meanwhile would
+   * be filed under the wrong keyspace, so start over on every switch. */
+  zend_hash_clean(&cache->entries);
+}
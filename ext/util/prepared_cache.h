@@ -0,0 +1,36 @@
+/**
+ * Copyright 2015-2017 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PHP_DRIVER_UTIL_PREPARED_CACHE_H
+#define PHP_DRIVER_UTIL_PREPARED_CACHE_H
+
+/* Creates a persistent cache of prepared statements for a persistent session
+ * connected to the given keyspace (which may be NULL) */
+php_driver_ref *php_driver_prepared_cache_new(const char *keyspace);
+/* Returns the shared prepared handle of the query, or NULL when it hasn't been
+ * prepared yet. Every entry is dropped once the schema version changes, which
+ * is only tracked when schema metadata is enabled. */
+php_driver_ref *php_driver_prepared_cache_find(php_driver_ref *cache, CassSession *session,
+                                               const char *cql, size_t cql_len);
+/* Takes ownership of the prepared handle and returns the shared entry */
+php_driver_ref *php_driver_prepared_cache_add(php_driver_ref *cache,
+                                              const char *cql, size_t cql_len,
+                                              const CassPrepared *prepared);
+/* Switches to the keyspace of a "USE" statement executed on the session */
+void php_driver_prepared_cache_use(php_driver_ref *cache,
+                                   const char *keyspace, size_t keyspace_len);
+
+#endif /* PHP_DRIVER_UTIL_PREPARED_CACHE_H */
@@ -17,8 +17,10 @@
 #include "php_driver.h"
 #include "php_driver_types.h"
 #include "result.h"
+#include "ref.h"
 #include "math.h"
 #include "collections.h"
+#include "inet.h"
 #include "types.h"
 #include "src/Collection.h"
 #include "src/Map.h"
@@ -419,78 +421,902 @@ php_driver_get_column_field(const CassColumnMeta *metadata, const char *field_na
   return php_driver_value(value, cass_value_data_type(value), out);
 }
 
-int
-php_driver_get_result(const CassResult *result, zval *out)
+/* Decoders for the values of a result column, compiled from the column's
+ * type once so that decoding a cell doesn't switch on its type */
+static zend_always_inline int
+decode(const php_driver_decoder *decoder, const CassValue *value, zval *out)
+{
+  if (cass_value_is_null(value)) {
+    ZVAL_NULL(out);
+    return SUCCESS;
+  }
+
+  return decoder->decode(decoder, value, out);
+}
+
+#define DECODE_OBJECT(ce, get) \
+  object_init_ex(out, ce); \
+  ASSERT_SUCCESS_BLOCK(get, \
+    zval_ptr_dtor(out); \
+    return FAILURE; \
+  ) \
+  return SUCCESS;
+
+static int
+decode_null(const php_driver_decoder *decoder, const CassValue *value, zval *out)
+{
+  ZVAL_NULL(out);
+  return SUCCESS;
+}
+
+static int
+decode_text(const php_driver_decoder *decoder, const CassValue *value, zval *out)
+{
+  const char *v_string;
+  size_t v_string_len;
+
+  ASSERT_SUCCESS_BLOCK(cass_value_get_string(value, &v_string, &v_string_len),
+    ZVAL_NULL(out);
+    return FAILURE;
+  )
+
+  ZVAL_STRINGL(out, v_string, v_string_len);
+  return SUCCESS;
+}
+
+static int
+decode_int(const php_driver_decoder *decoder, const CassValue *value, zval *out)
+{
+  cass_int32_t v_int_32;
+
+  ASSERT_SUCCESS_BLOCK(cass_value_get_int32(value, &v_int_32),
+    ZVAL_NULL(out);
+    return FAILURE;
+  )
+
+  ZVAL_LONG(out, v_int_32);
+  return SUCCESS;
+}
+
+static int
+decode_boolean(const php_driver_decoder *decoder, const CassValue *value, zval *out)
+{
+  cass_bool_t v_boolean;
+
+  ASSERT_SUCCESS_BLOCK(cass_value_get_bool(value, &v_boolean),
+    ZVAL_NULL(out);
+    return FAILURE;
+  )
+
+  ZVAL_BOOL(out, v_boolean);
+  return SUCCESS;
+}
+
+static int
+decode_double(const php_driver_decoder *decoder, const CassValue *value, zval *out)
+{
+  cass_double_t v_double;
+
+  ASSERT_SUCCESS_BLOCK(cass_value_get_double(value, &v_double),
+    ZVAL_NULL(out);
+    return FAILURE;
+  )
+
+  ZVAL_DOUBLE(out, v_double);
+  return SUCCESS;
+}
+
+static int
+decode_bigint(const php_driver_decoder *decoder, const CassValue *value, zval *out)
+{
+  DECODE_OBJECT(php_driver_bigint_ce,
+                cass_value_get_int64(value, &PHP_DRIVER_GET_NUMERIC(out)->data.bigint.value))
+}
+
+static int
+decode_smallint(const php_driver_decoder *decoder, const CassValue *value, zval *out)
+{
+  DECODE_OBJECT(php_driver_smallint_ce,
+                cass_value_get_int16(value, &PHP_DRIVER_GET_NUMERIC(out)->data.smallint.value))
+}
+
+static int
+decode_tinyint(const php_driver_decoder *decoder, const CassValue *value, zval *out)
+{
+  DECODE_OBJECT(php_driver_tinyint_ce,
+                cass_value_get_int8(value, &PHP_DRIVER_GET_NUMERIC(out)->data.tinyint.value))
+}
+
+static int
+decode_float(const php_driver_decoder *decoder, const CassValue *value, zval *out)
+{
+  DECODE_OBJECT(php_driver_float_ce,
+                cass_value_get_float(value, &PHP_DRIVER_GET_NUMERIC(out)->data.floating.value))
+}
+
+static int
+decode_timestamp(const php_driver_decoder *decoder, const CassValue *value, zval *out)
+{
+  DECODE_OBJECT(php_driver_timestamp_ce,
+                cass_value_get_int64(value, &PHP_DRIVER_GET_TIMESTAMP(out)->timestamp))
+}
+
+static int
+decode_date(const php_driver_decoder *decoder, const CassValue *value, zval *out)
+{
+  DECODE_OBJECT(php_driver_date_ce,
+                cass_value_get_uint32(value, &PHP_DRIVER_GET_DATE(out)->date))
+}
+
+static int
+decode_time(const php_driver_decoder *decoder, const CassValue *value, zval *out)
+{
+  DECODE_OBJECT(php_driver_time_ce,
+                cass_value_get_int64(value, &PHP_DRIVER_GET_TIME(out)->time))
+}
+
+static int
+decode_uuid(const php_driver_decoder *decoder, const CassValue *value, zval *out)
+{
+  DECODE_OBJECT(php_driver_uuid_ce,
+                cass_value_get_uuid(value, &PHP_DRIVER_GET_UUID(out)->uuid))
+}
+
+static int
+decode_timeuuid(const php_driver_decoder *decoder, const CassValue *value, zval *out)
+{
+  DECODE_OBJECT(php_driver_timeuuid_ce,
+                cass_value_get_uuid(value, &PHP_DRIVER_GET_UUID(out)->uuid))
+}
+
+static int
+decode_inet(const php_driver_decoder *decoder, const CassValue *value, zval *out)
+{
+  DECODE_OBJECT(php_driver_inet_ce,
+                cass_value_get_inet(value, &PHP_DRIVER_GET_INET(out)->inet))
+}
+
+static int
+decode_duration(const php_driver_decoder *decoder, const CassValue *value, zval *out)
+{
+  php_driver_duration *duration;
+
+  object_init_ex(out, php_driver_duration_ce);
+  duration = PHP_DRIVER_GET_DURATION(out);
+  ASSERT_SUCCESS_BLOCK(cass_value_get_duration(value, &duration->months, &duration->days, &duration->nanos),
+    zval_ptr_dtor(out);
+    return FAILURE;
+  )
+
+  return SUCCESS;
+}
+
+static int
+decode_blob(const php_driver_decoder *decoder, const CassValue *value, zval *out)
+{
+  const cass_byte_t *v_bytes;
+  size_t v_bytes_len;
+  php_driver_blob *blob;
+
+  ASSERT_SUCCESS_BLOCK(cass_value_get_bytes(value, &v_bytes, &v_bytes_len),
+    ZVAL_NULL(out);
+    return FAILURE;
+  )
+
+  object_init_ex(out, php_driver_blob_ce);
+  blob = PHP_DRIVER_GET_BLOB(out);
+  blob->data = emalloc(v_bytes_len * sizeof(cass_byte_t));
+  blob->size = v_bytes_len;
+  memcpy(blob->data, v_bytes, v_bytes_len);
+
+  return SUCCESS;
+}
+
+static int
+decode_varint(const php_driver_decoder *decoder, const CassValue *value, zval *out)
+{
+  const cass_byte_t *v_bytes;
+  size_t v_bytes_len;
+
+  ASSERT_SUCCESS_BLOCK(cass_value_get_bytes(value, &v_bytes, &v_bytes_len),
+    ZVAL_NULL(out);
+    return FAILURE;
+  )
+
+  object_init_ex(out, php_driver_varint_ce);
+  import_twos_complement((cass_byte_t*) v_bytes, v_bytes_len,
+                         &PHP_DRIVER_GET_NUMERIC(out)->data.varint.value);
+
+  return SUCCESS;
+}
+
+static int
+decode_decimal(const php_driver_decoder *decoder, const CassValue *value, zval *out)
 {
-  zval     rows;
-  zval     row;
-  const CassRow   *cass_row;
-  const char      *column_name;
-  size_t           column_name_len;
-  const CassDataType* column_type;
-  const CassValue *column_value;
-  CassIterator    *iterator = NULL;
-  size_t           columns = -1;
-  char           **column_names;
-  unsigned         i;
+  const cass_byte_t *v_decimal;
+  size_t v_decimal_len;
+  cass_int32_t v_decimal_scale;
+  php_driver_numeric *numeric;
 
+  ASSERT_SUCCESS_BLOCK(cass_value_get_decimal(value, &v_decimal, &v_decimal_len, &v_decimal_scale),
+    ZVAL_NULL(out);
+    return FAILURE;
+  )
 
-  array_init(&(rows));
+  object_init_ex(out, php_driver_decimal_ce);
+  numeric = PHP_DRIVER_GET_NUMERIC(out);
+  import_twos_complement((cass_byte_t*) v_decimal, v_decimal_len, &numeric->data.decimal.value);
+  numeric->data.decimal.scale = v_decimal_scale;
 
-  iterator = cass_iterator_from_result(result);
-  columns  = cass_result_column_count(result);
+  return SUCCESS;
+}
 
-  column_names = (char**) ecalloc(columns, sizeof(char*));
+static int
+decode_list(const php_driver_decoder *decoder, const CassValue *value, zval *out)
+{
+  php_driver_collection *collection;
+  CassIterator *iterator;
+
+  object_init_ex(out, php_driver_collection_ce);
+  collection = PHP_DRIVER_GET_COLLECTION(out);
+  ZVAL_COPY(&(collection->type), &(decoder->type));
+
+  iterator = cass_iterator_from_collection(value);
 
   while (cass_iterator_next(iterator)) {
+    zval v;
+
+    if (decode(&decoder->children[0], cass_iterator_get_value(iterator), &v) == FAILURE) {
+      cass_iterator_free(iterator);
+      zval_ptr_dtor(out);
+      return FAILURE;
+    }
 
-    array_init(&(row));
-    cass_row = cass_iterator_get_row(iterator);
+    php_driver_collection_add(collection, &v);
+    zval_ptr_dtor(&v);
+  }
 
-    for (i = 0; i < columns; i++) {
-      zval value;
+  cass_iterator_free(iterator);
 
-      if (column_names[i] == NULL) {
-        cass_result_column_name(result, i, &column_name, &column_name_len);
-        column_names[i] = estrndup(column_name, column_name_len);
-      }
+  return SUCCESS;
+}
 
-      column_type  = cass_result_column_data_type(result, i);
-      column_value = cass_row_get_column(cass_row, i);
+static int
+decode_set(const php_driver_decoder *decoder, const CassValue *value, zval *out)
+{
+  php_driver_set *set;
+  CassIterator *iterator;
 
-      if (php_driver_value(column_value, column_type, &value) == FAILURE) {
-        zval_ptr_dtor(&row);
-        zval_ptr_dtor(&rows);
+  object_init_ex(out, php_driver_set_ce);
+  set = PHP_DRIVER_GET_SET(out);
+  ZVAL_COPY(&(set->type), &(decoder->type));
 
-        for (i = 0; i < columns; i++) {
-          if (column_names[i]) {
-            efree(column_names[i]);
-          }
-        }
+  iterator = cass_iterator_from_collection(value);
 
-        efree(column_names);
-        cass_iterator_free(iterator);
+  while (cass_iterator_next(iterator)) {
+    zval v;
+
+    if (decode(&decoder->children[0], cass_iterator_get_value(iterator), &v) == FAILURE) {
+      cass_iterator_free(iterator);
+      zval_ptr_dtor(out);
+      return FAILURE;
+    }
+
+    php_driver_set_add(set, &v);
+    zval_ptr_dtor(&v);
+  }
+
+  cass_iterator_free(iterator);
+
+  return SUCCESS;
+}
+
+static int
+decode_map(const php_driver_decoder *decoder, const CassValue *value, zval *out)
+{
+  php_driver_map *map;
+  CassIterator *iterator;
+
+  object_init_ex(out, php_driver_map_ce);
+  map = PHP_DRIVER_GET_MAP(out);
+  ZVAL_COPY(&(map->type), &(decoder->type));
+
+  iterator = cass_iterator_from_map(value);
+
+  while (cass_iterator_next(iterator)) {
+    zval k;
+    zval v;
+
+    if (decode(&decoder->children[0], cass_iterator_get_map_key(iterator), &k) == FAILURE) {
+      cass_iterator_free(iterator);
+      zval_ptr_dtor(out);
+      return FAILURE;
+    }
+
+    if (decode(&decoder->children[1], cass_iterator_get_map_value(iterator), &v) == FAILURE) {
+      zval_ptr_dtor(&k);
+      cass_iterator_free(iterator);
+      zval_ptr_dtor(out);
+      return FAILURE;
+    }
+
+    php_driver_map_set(map, &k, &v);
+    zval_ptr_dtor(&k);
+    zval_ptr_dtor(&v);
+  }
+
+  cass_iterator_free(iterator);
+
+  return SUCCESS;
+}
+
+static int
+decode_tuple(const php_driver_decoder *decoder, const CassValue *value, zval *out)
+{
+  php_driver_tuple *tuple;
+  CassIterator *iterator;
+  size_t index = 0;
+
+  object_init_ex(out, php_driver_tuple_ce);
+  tuple = PHP_DRIVER_GET_TUPLE(out);
+  ZVAL_COPY(&(tuple->type), &(decoder->type));
+
+  iterator = cass_iterator_from_tuple(value);
+
+  while (cass_iterator_next(iterator) && index < decoder->count) {
+    const CassValue *element = cass_iterator_get_value(iterator);
+
+    if (!cass_value_is_null(element)) {
+      zval v;
 
+      if (decoder->children[index].decode(&decoder->children[index], element, &v) == FAILURE) {
+        cass_iterator_free(iterator);
+        zval_ptr_dtor(out);
         return FAILURE;
       }
 
-      add_assoc_zval_ex(&(row), column_names[i], strlen(column_names[i]), &(value));
+      php_driver_tuple_set(tuple, index, &v);
+      zval_ptr_dtor(&v);
     }
 
-    add_next_index_zval(&(rows),
-                        &(row));
+    index++;
   }
 
-  for (i = 0; i < columns; i++) {
-    if (column_names[i] != NULL) {
-      efree(column_names[i]);
+  cass_iterator_free(iterator);
+
+  return SUCCESS;
+}
+
+static int
+decode_udt(const php_driver_decoder *decoder, const CassValue *value, zval *out)
+{
+  php_driver_user_type_value *user_type_value;
+  CassIterator *iterator;
+  size_t index = 0;
+
+  object_init_ex(out, php_driver_user_type_value_ce);
+  user_type_value = PHP_DRIVER_GET_USER_TYPE_VALUE(out);
+  ZVAL_COPY(&(user_type_value->type), &(decoder->type));
+
+  iterator = cass_iterator_fields_from_user_type(value);
+
+  while (cass_iterator_next(iterator) && index < decoder->count) {
+    const CassValue *field = cass_iterator_get_user_type_field_value(iterator);
+
+    if (!cass_value_is_null(field)) {
+      const char *name;
+      size_t name_length;
+      zval v;
+
+      if (decoder->children[index].decode(&decoder->children[index], field, &v) == FAILURE) {
+        cass_iterator_free(iterator);
+        zval_ptr_dtor(out);
+        return FAILURE;
+      }
+
+      cass_iterator_get_user_type_field_name(iterator, &name, &name_length);
+      php_driver_user_type_value_set(user_type_value, name, name_length, &v);
+      zval_ptr_dtor(&v);
     }
+
+    index++;
   }
 
-  efree(column_names);
   cass_iterator_free(iterator);
 
-  *out = rows;
+  return SUCCESS;
+}
+
+/* Decoders that return PHP scalars instead of the driver's value objects */
+static void
+int64_to_zval(cass_int64_t value, zval *out)
+{
+  char *string;
+
+  if (value >= (cass_int64_t) ZEND_LONG_MIN && value <= (cass_int64_t) ZEND_LONG_MAX) {
+    ZVAL_LONG(out, (zend_long) value);
+    return;
+  }
+
+  spprintf(&string, 0, LL_FORMAT, value);
+  ZVAL_STRING(out, string);
+  efree(string);
+}
+
+static int
+decode_int64_scalar(const php_driver_decoder *decoder, const CassValue *value, zval *out)
+{
+  cass_int64_t v_int_64;
+
+  ASSERT_SUCCESS_BLOCK(cass_value_get_int64(value, &v_int_64),
+    ZVAL_NULL(out);
+    return FAILURE;
+  )
+
+  int64_to_zval(v_int_64, out);
+  return SUCCESS;
+}
+
+static int
+decode_smallint_scalar(const php_driver_decoder *decoder, const CassValue *value, zval *out)
+{
+  cass_int16_t v_int_16;
+
+  ASSERT_SUCCESS_BLOCK(cass_value_get_int16(value, &v_int_16),
+    ZVAL_NULL(out);
+    return FAILURE;
+  )
+
+  ZVAL_LONG(out, v_int_16);
+  return SUCCESS;
+}
+
+static int
+decode_tinyint_scalar(const php_driver_decoder *decoder, const CassValue *value, zval *out)
+{
+  cass_int8_t v_int_8;
+
+  ASSERT_SUCCESS_BLOCK(cass_value_get_int8(value, &v_int_8),
+    ZVAL_NULL(out);
+    return FAILURE;
+  )
+
+  ZVAL_LONG(out, v_int_8);
+  return SUCCESS;
+}
+
+static int
+decode_float_scalar(const php_driver_decoder *decoder, const CassValue *value, zval *out)
+{
+  cass_float_t v_float;
+
+  ASSERT_SUCCESS_BLOCK(cass_value_get_float(value, &v_float),
+    ZVAL_NULL(out);
+    return FAILURE;
+  )
+
+  ZVAL_DOUBLE(out, v_float);
+  return SUCCESS;
+}
+
+static int
+decode_date_scalar(const php_driver_decoder *decoder, const CassValue *value, zval *out)
+{
+  cass_uint32_t v_date;
+
+  ASSERT_SUCCESS_BLOCK(cass_value_get_uint32(value, &v_date),
+    ZVAL_NULL(out);
+    return FAILURE;
+  )
+
+  int64_to_zval(cass_date_time_to_epoch(v_date, 0), out);
+  return SUCCESS;
+}
+
+static int
+decode_uuid_scalar(const php_driver_decoder *decoder, const CassValue *value, zval *out)
+{
+  CassUuid v_uuid;
+  char string[CASS_UUID_STRING_LENGTH];
+
+  ASSERT_SUCCESS_BLOCK(cass_value_get_uuid(value, &v_uuid),
+    ZVAL_NULL(out);
+    return FAILURE;
+  )
+
+  cass_uuid_string(v_uuid, string);
+  ZVAL_STRING(out, string);
+  return SUCCESS;
+}
+
+static int
+decode_inet_scalar(const php_driver_decoder *decoder, const CassValue *value, zval *out)
+{
+  CassInet v_inet;
+  char *string;
+
+  ASSERT_SUCCESS_BLOCK(cass_value_get_inet(value, &v_inet),
+    ZVAL_NULL(out);
+    return FAILURE;
+  )
+
+  php_driver_format_address(v_inet, &string);
+  ZVAL_STRING(out, string);
+  efree(string);
+  return SUCCESS;
+}
+
+/* Only the values of columns are decoded to scalars. Elements of
+ * collections, tuples and user types stay objects, since they are checked
+ * against the types of their containers. */
+static void
+use_scalar_decoder(php_driver_decoder *decoder)
+{
+  switch (cass_data_type_type(decoder->data_type)) {
+  case CASS_VALUE_TYPE_COUNTER:
+  case CASS_VALUE_TYPE_BIGINT:
+  case CASS_VALUE_TYPE_TIMESTAMP:
+  case CASS_VALUE_TYPE_TIME:
+    decoder->decode = decode_int64_scalar;
+    break;
+  case CASS_VALUE_TYPE_SMALL_INT:
+    decoder->decode = decode_smallint_scalar;
+    break;
+  case CASS_VALUE_TYPE_TINY_INT:
+    decoder->decode = decode_tinyint_scalar;
+    break;
+  case CASS_VALUE_TYPE_FLOAT:
+    decoder->decode = decode_float_scalar;
+    break;
+  case CASS_VALUE_TYPE_DATE:
+    decoder->decode = decode_date_scalar;
+    break;
+  case CASS_VALUE_TYPE_UUID:
+  case CASS_VALUE_TYPE_TIMEUUID:
+    decoder->decode = decode_uuid_scalar;
+    break;
+  case CASS_VALUE_TYPE_INET:
+    decoder->decode = decode_inet_scalar;
+    break;
+  default:
+    break;
+  }
+}
+
+static void compile_decoder(php_driver_decoder *decoder, const CassDataType *data_type);
+
+/* Compiles the sub types of a compound type, whose Type object is built
+ * here once for all of its values */
+static void
+compile_children(php_driver_decoder *decoder, size_t count)
+{
+  size_t i;
+
+  decoder->type     = php_driver_type_from_data_type(decoder->data_type);
+  decoder->count    = count;
+  decoder->children = (php_driver_decoder *) ecalloc(count, sizeof(php_driver_decoder));
+
+  for (i = 0; i < count; i++)
+    compile_decoder(&decoder->children[i],
+                    cass_data_type_sub_data_type(decoder->data_type, i));
+}
+
+static void
+compile_decoder(php_driver_decoder *decoder, const CassDataType *data_type)
+{
+  decoder->decode    = decode_null;
+  decoder->data_type = data_type;
+  decoder->count     = 0;
+  decoder->children  = NULL;
+  ZVAL_UNDEF(&(decoder->type));
+
+  if (!data_type)
+    return;
+
+  switch (cass_data_type_type(data_type)) {
+  case CASS_VALUE_TYPE_ASCII:
+  case CASS_VALUE_TYPE_TEXT:
+  case CASS_VALUE_TYPE_VARCHAR:
+    decoder->decode = decode_text;
+    break;
+  case CASS_VALUE_TYPE_INT:
+    decoder->decode = decode_int;
+    break;
+  case CASS_VALUE_TYPE_COUNTER:
+  case CASS_VALUE_TYPE_BIGINT:
+    decoder->decode = decode_bigint;
+    break;
+  case CASS_VALUE_TYPE_SMALL_INT:
+    decoder->decode = decode_smallint;
+    break;
+  case CASS_VALUE_TYPE_TINY_INT:
+    decoder->decode = decode_tinyint;
+    break;
+  case CASS_VALUE_TYPE_TIMESTAMP:
+    decoder->decode = decode_timestamp;
+    break;
+  case CASS_VALUE_TYPE_DATE:
+    decoder->decode = decode_date;
+    break;
+  case CASS_VALUE_TYPE_TIME:
+    decoder->decode = decode_time;
+    break;
+  case CASS_VALUE_TYPE_BLOB:
+    decoder->decode = decode_blob;
+    break;
+  case CASS_VALUE_TYPE_VARINT:
+    decoder->decode = decode_varint;
+    break;
+  case CASS_VALUE_TYPE_UUID:
+    decoder->decode = decode_uuid;
+    break;
+  case CASS_VALUE_TYPE_TIMEUUID:
+    decoder->decode = decode_timeuuid;
+    break;
+  case CASS_VALUE_TYPE_BOOLEAN:
+    decoder->decode = decode_boolean;
+    break;
+  case CASS_VALUE_TYPE_INET:
+    decoder->decode = decode_inet;
+    break;
+  case CASS_VALUE_TYPE_DECIMAL:
+    decoder->decode = decode_decimal;
+    break;
+  case CASS_VALUE_TYPE_DURATION:
+    decoder->decode = decode_duration;
+    break;
+  case CASS_VALUE_TYPE_DOUBLE:
+    decoder->decode = decode_double;
+    break;
+  case CASS_VALUE_TYPE_FLOAT:
+    decoder->decode = decode_float;
+    break;
+  case CASS_VALUE_TYPE_LIST:
+    decoder->decode = decode_list;
+    compile_children(decoder, 1);
+    break;
+  case CASS_VALUE_TYPE_SET:
+    decoder->decode = decode_set;
+    compile_children(decoder, 1);
+    break;
+  case CASS_VALUE_TYPE_MAP:
+    decoder->decode = decode_map;
+    compile_children(decoder, 2);
+    break;
+  case CASS_VALUE_TYPE_TUPLE:
+    decoder->decode = decode_tuple;
+    compile_children(decoder, cass_data_type_sub_type_count(data_type));
+    break;
+  case CASS_VALUE_TYPE_UDT:
+    decoder->decode = decode_udt;
+    compile_children(decoder, cass_data_type_sub_type_count(data_type));
+    break;
+  default:
+    break;
+  }
+}
+
+static void
+free_decoder(php_driver_decoder *decoder)
+{
+  size_t i;
+
+  CASS_ZVAL_MAYBE_DESTROY(decoder->type);
+
+  for (i = 0; i < decoder->count; i++)
+    free_decoder(&decoder->children[i]);
+
+  if (decoder->children)
+    efree(decoder->children);
+}
+
+static void
+free_columns(void *data)
+{
+  php_driver_columns *columns = (php_driver_columns *) data;
+  size_t i;
+
+  for (i = 0; i < columns->count; i++) {
+    free_decoder(&columns->decoders[i]);
+    zend_string_release(columns->names[i]);
+    cass_data_type_free(columns->types[i]);
+  }
+
+  efree(columns->decoders);
+  efree(columns->names);
+  efree(columns->types);
+  efree(columns);
+}
+
+static php_driver_ref *
+new_columns(const CassResult *result, cass_bool_t fetch_scalars)
+{
+  php_driver_columns *columns = (php_driver_columns *) emalloc(sizeof(php_driver_columns));
+  HashTable names;
+  size_t i;
+
+  columns->count  = cass_result_column_count(result);
+  columns->names  = (zend_string **) ecalloc(columns->count, sizeof(zend_string *));
+  columns->types  = (CassDataType **) ecalloc(columns->count, sizeof(CassDataType *));
+  columns->decoders = (php_driver_decoder *) ecalloc(columns->count, sizeof(php_driver_decoder));
+  columns->unique = 1;
+  columns->fetch_scalars = fetch_scalars;
+
+  zend_hash_init(&names, columns->count, NULL, NULL, 0);
+
+  for (i = 0; i < columns->count; i++) {
+    const char *name;
+    size_t name_length;
+    zval position;
+
+    cass_result_column_name(result, i, &name, &name_length);
+    columns->names[i] = zend_string_init(name, name_length, 0);
+    zend_string_hash_val(columns->names[i]);
+    columns->types[i] = cass_data_type_new_from_existing(cass_result_column_data_type(result, i));
+    compile_decoder(&columns->decoders[i], columns->types[i]);
+    if (fetch_scalars)
+      use_scalar_decoder(&columns->decoders[i]);
+
+    ZVAL_LONG(&position, i);
+    if (!zend_hash_add(&names, columns->names[i], &position))
+      columns->unique = 0;
+  }
+
+  zend_hash_destroy(&names);
+
+  return php_driver_new_ref(columns, free_columns);
+}
+
+static int
+names_match(CassError (*get)(const CassDataType *, const char **, size_t *),
+            const CassDataType *a, const CassDataType *b)
+{
+  const char *name_a, *name_b;
+  size_t length_a, length_b;
+
+  get(a, &name_a, &length_a);
+  get(b, &name_b, &length_b);
+
+  return length_a == length_b && memcmp(name_a, name_b, length_a) == 0;
+}
+
+/* Compares the whole type, a change to the type of a collection's elements
+ * or to the fields of a user type or tuple needs new decoders */
+static int
+data_types_match(const CassDataType *a, const CassDataType *b)
+{
+  CassValueType type = cass_data_type_type(a);
+  size_t count, i;
+
+  if (type != cass_data_type_type(b))
+    return 0;
+
+  switch (type) {
+  case CASS_VALUE_TYPE_CUSTOM:
+    return names_match(cass_data_type_class_name, a, b);
+  case CASS_VALUE_TYPE_UDT:
+    if (!names_match(cass_data_type_keyspace, a, b) ||
+        !names_match(cass_data_type_type_name, a, b))
+      return 0;
+    break;
+  case CASS_VALUE_TYPE_LIST:
+  case CASS_VALUE_TYPE_SET:
+  case CASS_VALUE_TYPE_MAP:
+  case CASS_VALUE_TYPE_TUPLE:
+    break;
+  default:
+    return 1;
+  }
+
+  count = cass_data_type_sub_type_count(a);
+  if (count != cass_data_type_sub_type_count(b))
+    return 0;
+
+  for (i = 0; i < count; i++) {
+    if (type == CASS_VALUE_TYPE_UDT) {
+      const char *name_a, *name_b;
+      size_t length_a, length_b;
+
+      cass_data_type_sub_type_name(a, i, &name_a, &length_a);
+      cass_data_type_sub_type_name(b, i, &name_b, &length_b);
+      if (length_a != length_b || memcmp(name_a, name_b, length_a) != 0)
+        return 0;
+    }
+
+    if (!data_types_match(cass_data_type_sub_data_type(a, i),
+                          cass_data_type_sub_data_type(b, i)))
+      return 0;
+  }
+
+  return 1;
+}
+
+/* The columns of a statement's results only change with the schema */
+static int
+columns_match(const php_driver_columns *columns, const CassResult *result,
+              cass_bool_t fetch_scalars)
+{
+  size_t i;
+
+  if (columns->count != cass_result_column_count(result) ||
+      columns->fetch_scalars != fetch_scalars)
+    return 0;
+
+  for (i = 0; i < columns->count; i++) {
+    const char *name;
+    size_t name_length;
+
+    cass_result_column_name(result, i, &name, &name_length);
+    if (ZSTR_LEN(columns->names[i]) != name_length ||
+        memcmp(ZSTR_VAL(columns->names[i]), name, name_length) != 0 ||
+        !data_types_match(columns->types[i], cass_result_column_data_type(result, i)))
+      return 0;
+  }
+
+  return 1;
+}
+
+static void
+free_columns_cache(void *data)
+{
+  php_driver_columns_cache *cache = (php_driver_columns_cache *) data;
+
+  php_driver_del_ref(&cache->columns);
+  efree(cache);
+}
+
+php_driver_ref *
+php_driver_columns_cache_new()
+{
+  php_driver_columns_cache *cache =
+    (php_driver_columns_cache *) emalloc(sizeof(php_driver_columns_cache));
+
+  cache->columns = NULL;
+
+  return php_driver_new_ref(cache, free_columns_cache);
+}
+
+php_driver_ref *
+php_driver_columns_get(php_driver_ref *cache_ref, const CassResult *result,
+                       cass_bool_t fetch_scalars)
+{
+  php_driver_columns_cache *cache = (php_driver_columns_cache *) cache_ref->data;
+
+  if (!cache->columns ||
+      !columns_match((const php_driver_columns *) cache->columns->data, result,
+                     fetch_scalars)) {
+    php_driver_del_ref(&cache->columns);
+    cache->columns = new_columns(result, fetch_scalars);
+  }
+
+  return php_driver_add_ref(cache->columns);
+}
+
+int
+php_driver_get_row(const php_driver_columns *columns, const CassRow *row, zval *out)
+{
+  HashTable *cells;
+  size_t i;
+
+  array_init_size(out, columns->count);
+  cells = Z_ARRVAL_P(out);
+  zend_hash_real_init(cells, 0);
+
+  for (i = 0; i < columns->count; i++) {
+    zval value;
+
+    if (decode(&columns->decoders[i], cass_row_get_column(row, i), &value) == FAILURE) {
+      zval_ptr_dtor(out);
+      ZVAL_UNDEF(out);
+      return FAILURE;
+    }
+
+    /* Names that are known to be distinct are appended without a lookup */
+    if (columns->unique)
+      _zend_hash_append(cells, columns->names[i], &value);
+    else
+      zend_hash_update(cells, columns->names[i], &value);
+  }
 
   return SUCCESS;
 }
@@ -23,7 +23,52 @@ int php_driver_get_keyspace_field(const CassKeyspaceMeta *metadata, const char *
 int php_driver_get_table_field(const CassTableMeta *metadata, const char *field_name, zval *out);
 int php_driver_get_column_field(const CassColumnMeta *metadata, const char *field_name, zval *out);
 
-int php_driver_get_result(const CassResult *result, zval *out);
+typedef struct php_driver_decoder_ php_driver_decoder;
+
+/* Decodes a value that isn't null */
+typedef int (*php_driver_decode_function)(const php_driver_decoder *decoder,
+                                          const CassValue *value, zval *out);
+
+/* How the values of a type are decoded, with one child for the elements of
+ * lists and sets, the keys and values of maps and each field of tuples and
+ * user types */
+struct php_driver_decoder_ {
+  php_driver_decode_function decode;
+  const CassDataType *data_type;
+  size_t count;
+  php_driver_decoder *children;
+  /* The type of collections, tuples and user types, which is shared by
+   * every value that is decoded */
+  zval type;
+};
+
+/* The names, types and decoders of the columns of a result. Names are
+ * hashed once and the types are copies, so the columns outlive the result
+ * and are shared by the pages of a statement and by executions of a
+ * prepared statement. */
+typedef struct {
+  size_t count;
+  zend_string **names;
+  CassDataType **types;
+  php_driver_decoder *decoders;
+  int unique;
+  /* Whether the columns are decoded to PHP scalars where possible */
+  cass_bool_t fetch_scalars;
+} php_driver_columns;
+
+/* Holds the columns of the last result of a statement */
+typedef struct {
+  php_driver_ref *columns;
+} php_driver_columns_cache;
+
+php_driver_ref *php_driver_columns_cache_new();
+/* Returns the cached columns if they match the result and caches the
+ * columns of the result otherwise */
+php_driver_ref *php_driver_columns_get(php_driver_ref *cache, const CassResult *result,
+                                       cass_bool_t fetch_scalars);
+
+/* Decodes a single row of the result into an array keyed by column name */
+int php_driver_get_row(const php_driver_columns *columns, const CassRow *row, zval *out);
 
 
 #endif /* PHP_DRIVER_RESULT_H */
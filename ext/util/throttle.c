@@ -0,0 +1,156 @@
+/**
+ * Copyright 2015-2017 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "php_driver.h"
+#include "php_driver_types.h"
+#include "util/future.h"
+#include "util/throttle.h"
+
+#include <uv.h>
+
+struct php_driver_throttle_ {
+  uv_mutex_t lock;
+  uv_cond_t cond;
+  /* Held by the sessions and by every request in flight */
+  unsigned int refs;
+  size_t in_flight;
+  size_t limit;
+  php_driver_throttle_policy policy;
+  cass_duration_t timeout_us;
+};
+
+static void
+throttle_unref(php_driver_throttle *throttle)
+{
+  int last;
+
+  uv_mutex_lock(&throttle->lock);
+  last = --throttle->refs == 0;
+  uv_mutex_unlock(&throttle->lock);
+
+  if (last) {
+    uv_cond_destroy(&throttle->cond);
+    uv_mutex_destroy(&throttle->lock);
+    free(throttle);
+  }
+}
+
+/* Runs on the driver's I/O threads */
+static void
+throttle_callback(CassFuture *future, void *data)
+{
+  php_driver_throttle_release((php_driver_throttle *) data);
+}
+
+php_driver_throttle *
+php_driver_throttle_new(size_t limit, php_driver_throttle_policy policy,
+                        cass_duration_t timeout_us)
+{
+  php_driver_throttle *throttle =
+      (php_driver_throttle *) calloc(1, sizeof(php_driver_throttle));
+
+  uv_mutex_init(&throttle->lock);
+  uv_cond_init(&throttle->cond);
+  throttle->refs       = 1;
+  throttle->limit      = limit;
+  throttle->policy     = policy;
+  throttle->timeout_us = timeout_us;
+
+  return throttle;
+}
+
+php_driver_throttle *
+php_driver_throttle_add_ref(php_driver_throttle *throttle)
+{
+  uv_mutex_lock(&throttle->lock);
+  throttle->refs++;
+  uv_mutex_unlock(&throttle->lock);
+
+  return throttle;
+}
+
+void
+php_driver_throttle_free(php_driver_throttle *throttle)
+{
+  if (throttle)
+    throttle_unref(throttle);
+}
+
+int
+php_driver_throttle_acquire(php_driver_throttle *throttle)
+{
+  uint64_t deadline = 0;
+  int full = 0;
+
+  if (throttle->policy == PHP_DRIVER_THROTTLE_WAIT)
+    deadline = uv_hrtime() + throttle->timeout_us * 1000;
+
+  uv_mutex_lock(&throttle->lock);
+  while (throttle->in_flight >= throttle->limit) {
+    if (throttle->policy == PHP_DRIVER_THROTTLE_FAIL_FAST) {
+      full = 1;
+      break;
+    } else if (throttle->policy == PHP_DRIVER_THROTTLE_BLOCK) {
+      uv_cond_wait(&throttle->cond, &throttle->lock);
+    } else {
+      uint64_t now = uv_hrtime();
+      if (now >= deadline) {
+        full = 1;
+        break;
+      }
+      uv_cond_timedwait(&throttle->cond, &throttle->lock, deadline - now);
+    }
+  }
+  if (!full) {
+    throttle->in_flight++;
+    throttle->refs++;
+  }
+  uv_mutex_unlock(&throttle->lock);
+
+  if (full) {
+    if (throttle->policy == PHP_DRIVER_THROTTLE_WAIT) {
+      zend_throw_exception_ex(php_driver_timeout_exception_ce, 0,
+                              "No request completed within %f seconds while %lu requests were in flight",
+                              throttle->timeout_us / 1000000.0, (unsigned long) throttle->limit);
+    } else {
+      zend_throw_exception_ex(exception_class(CASS_ERROR_LIB_REQUEST_QUEUE_FULL),
+                              CASS_ERROR_LIB_REQUEST_QUEUE_FULL,
+                              "Too many requests in flight, the limit is %lu",
+                              (unsigned long) throttle->limit);
+    }
+    return FAILURE;
+  }
+
+  return SUCCESS;
+}
+
+void
+php_driver_throttle_release(php_driver_throttle *throttle)
+{
+  uv_mutex_lock(&throttle->lock);
+  throttle->in_flight--;
+  uv_cond_signal(&throttle->cond);
+  uv_mutex_unlock(&throttle->lock);
+
+  throttle_unref(throttle);
+}
+
+void
+php_driver_throttle_track(php_driver_throttle *throttle, CassFuture *future)
+{
+  if (php_driver_future_set_callback(future, throttle_callback, throttle) != CASS_OK)
+    php_driver_throttle_release(throttle);
+}
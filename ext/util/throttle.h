@@ -0,0 +1,44 @@
+/**
+ * Copyright 2015-2017 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PHP_DRIVER_UTIL_THROTTLE_H
+#define PHP_DRIVER_UTIL_THROTTLE_H
+
+/* What a request does when the limit of requests in flight is reached */
+typedef enum {
+  PHP_DRIVER_THROTTLE_BLOCK,
+  PHP_DRIVER_THROTTLE_FAIL_FAST,
+  PHP_DRIVER_THROTTLE_WAIT
+} php_driver_throttle_policy;
+
+/* Limits the number of requests of a session that are in flight at once */
+typedef struct php_driver_throttle_ php_driver_throttle;
+
+/* The timeout only applies to PHP_DRIVER_THROTTLE_WAIT */
+php_driver_throttle *php_driver_throttle_new(size_t limit,
+                                             php_driver_throttle_policy policy,
+                                             cass_duration_t timeout_us);
+php_driver_throttle *php_driver_throttle_add_ref(php_driver_throttle *throttle);
+/* Requests still in flight may outlive the throttle */
+void php_driver_throttle_free(php_driver_throttle *throttle);
+/* Takes a slot for the next request according to the policy, or throws */
+int  php_driver_throttle_acquire(php_driver_throttle *throttle);
+/* Gives back a slot that wasn't used */
+void php_driver_throttle_release(php_driver_throttle *throttle);
+/* Gives back the slot once the future of its request resolves */
+void php_driver_throttle_track(php_driver_throttle *throttle, CassFuture *future);
+
+#endif /* PHP_DRIVER_UTIL_THROTTLE_H */
@@ -0,0 +1,282 @@
+<?php
+
+/**
+ * Copyright 2015-2017 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+namespace Cassandra;
+/**
+ * Bound statement integration tests.
+ */
+class BoundStatementIntegrationTest extends BasicIntegrationTest {
+    /**
+     * Bound statements can be executed repeatedly with updated arguments.
+     *
+     * This test will ensure that a bound statement keeps its arguments
+     * across executions and that setting a single argument by name or by
+     * index only changes that argument.
+     *
+     * @test
+     */
+    public function testReuseWithUpdatedArguments() {
+        $this->session->execute(
+            "CREATE TABLE {$this->tableNamePrefix} " .
+            "(key int PRIMARY KEY, value_text text)"
+        );
+
+        $insert = $this->session->prepare(
+            "INSERT INTO {$this->tableNamePrefix} (key, value_text) VALUES (?, ?)"
+        );
+        $bound = $insert->bind(array("key" => 1, "value_text" => "shared"));
+        $this->assertInstanceOf('Cassandra\BoundStatement', $bound);
+
+        foreach (range(1, 3) as $key) {
+            $this->session->execute($bound->set("key", $key));
+        }
+        $this->session->execute($bound->set(0, 4)->set("value_text", "last"));
+
+        $select = $this->session->prepare(
+            "SELECT value_text FROM {$this->tableNamePrefix} WHERE key = ?"
+        )->bind();
+        foreach (range(1, 4) as $key) {
+            $rows = $this->session->execute($select->set(0, $key));
+            $this->assertCount(1, $rows);
+            $this->assertEquals($key == 4 ? "last" : "shared", $rows->first()["value_text"]);
+        }
+    }
+
+    /**
+     * Binding an unsupported argument fails.
+     *
+     * This test will ensure that binding an argument that can't be bound to
+     * the parameter throws instead of returning a partially bound statement.
+     *
+     * @test
+     */
+    public function testBindUnsupportedArgument() {
+        $this->session->execute(
+            "CREATE TABLE {$this->tableNamePrefix} " .
+            "(key int PRIMARY KEY, value_text text)"
+        );
+
+        $insert = $this->session->prepare(
+            "INSERT INTO {$this->tableNamePrefix} (key, value_text) VALUES (?, ?)"
+        );
+
+        $this->expectException(\Cassandra\Exception\InvalidArgumentException::class);
+        $insert->bind(array(1, new \stdClass()));
+    }
+
+    /**
+     * Bound statements can be executed asynchronously and added to batches.
+     *
+     * This test will ensure that a bound statement can be changed while a
+     * previous asynchronous execution of it is pending, and that batches
+     * use the arguments the statement had when it was added.
+     *
+     * @test
+     */
+    public function testAsyncAndBatch() {
+        $this->session->execute(
+            "CREATE TABLE {$this->tableNamePrefix} " .
+            "(key int PRIMARY KEY, value_int int)"
+        );
+
+        $bound = $this->session->prepare(
+            "INSERT INTO {$this->tableNamePrefix} (key, value_int) VALUES (?, ?)"
+        )->bind(array(1, 1));
+
+        $futures = array();
+        foreach (range(1, 3) as $key) {
+            $futures[] = $this->session->executeAsync($bound->set(0, $key)->set(1, $key));
+        }
+        foreach ($futures as $future) {
+            $future->get();
+        }
+
+        $batch = new BatchStatement(\Cassandra::BATCH_UNLOGGED);
+        $batch->add($bound->set(0, 4)->set(1, 4));
+        $batch->add($bound->set(0, 5)->set(1, 5));
+        $this->session->execute($batch);
+
+        $rows = $this->session->execute("SELECT * FROM {$this->tableNamePrefix}");
+        $this->assertCount(5, $rows);
+        foreach ($rows as $row) {
+            $this->assertEquals($row["key"], $row["value_int"]);
+        }
+    }
+
+    /**
+     * Unlogged batches can be split by partition and by size.
+     *
+     * This test will ensure that every entry of a batch that is grouped by
+     * partition and split into small parts is written, whether it was
+     * added with positional, named or bound arguments.
+     *
+     * @test
+     */
+    public function testBatchGroupedByPartition() {
+        $this->session->execute(
+            "CREATE TABLE {$this->tableNamePrefix} " .
+            "(key int, position int, value_text text, PRIMARY KEY (key, position))"
+        );
+
+        $insert = $this->session->prepare(
+            "INSERT INTO {$this->tableNamePrefix} (key, position, value_text) VALUES (?, ?, ?)"
+        );
+        $batch = new BatchStatement(\Cassandra::BATCH_UNLOGGED, array(
+            'group_by_partition' => true,
+            'max_bytes'          => 256
+        ));
+        foreach (range(1, 4) as $key) {
+            foreach (range(1, 10) as $position) {
+                switch ($position % 3) {
+                    case 0:
+                        $batch->add($insert, array($key, $position, "positional"));
+                        break;
+                    case 1:
+                        $batch->add($insert, array(
+                            "key" => $key, "position" => $position, "value_text" => "named"
+                        ));
+                        break;
+                    default:
+                        $batch->add($insert->bind(array($key, $position, "bound")));
+                        break;
+                }
+            }
+        }
+        $batch->add("INSERT INTO {$this->tableNamePrefix} (key, position, value_text) " .
+                    "VALUES (5, 1, 'simple')");
+        $this->session->execute($batch);
+
+        $rows = $this->session->execute("SELECT * FROM {$this->tableNamePrefix}");
+        $this->assertCount(41, $rows);
+    }
+
+    /**
+     * Batches of bound statements can be grouped by partition.
+     *
+     * This test will ensure that every entry of a batch made only of bound
+     * statements, with their partition key set by position or by a name
+     * spelled in a different case, is written when the batch is grouped by
+     * partition.
+     *
+     * @test
+     */
+    public function testBatchOfBoundStatementsGroupedByPartition() {
+        $this->session->execute(
+            "CREATE TABLE {$this->tableNamePrefix} " .
+            "(key int, position int, value_text text, PRIMARY KEY (key, position))"
+        );
+
+        $insert = $this->session->prepare(
+            "INSERT INTO {$this->tableNamePrefix} (key, position, value_text) VALUES (?, ?, ?)"
+        );
+        $batch = new BatchStatement(\Cassandra::BATCH_UNLOGGED, array('group_by_partition' => true));
+        foreach (range(1, 4) as $key) {
+            foreach (range(1, 10) as $position) {
+                $bound = $insert->bind();
+                if ($position % 2) {
+                    $bound->set("Key", $key)->set("position", $position)->set(2, "named");
+                } else {
+                    $bound->set(0, $key)->set(1, $position)->set(2, "positional");
+                }
+                $batch->add($bound);
+            }
+        }
+        $this->session->execute($batch);
+
+        $rows = $this->session->execute("SELECT * FROM {$this->tableNamePrefix}");
+        $this->assertCount(40, $rows);
+        foreach ($rows as $row) {
+            $this->assertEquals($row["position"] % 2 ? "named" : "positional", $row["value_text"]);
+        }
+    }
+
+    /**
+     * Split batches are sent in parts by executeDetached() and defer().
+     *
+     * This test will ensure that every entry of a batch split by partition
+     * is written when the batch is executed detached or deferred.
+     *
+     * @test
+     */
+    public function testSplitBatchDetachedAndDeferred() {
+        $this->session->execute(
+            "CREATE TABLE {$this->tableNamePrefix} " .
+            "(key int, position int, value_text text, PRIMARY KEY (key, position))"
+        );
+
+        $insert = $this->session->prepare(
+            "INSERT INTO {$this->tableNamePrefix} (key, position, value_text) VALUES (?, ?, ?)"
+        );
+        $batches = array();
+        foreach (array("detached", "deferred") as $index => $value) {
+            $batch = new BatchStatement(\Cassandra::BATCH_UNLOGGED, array(
+                'group_by_partition' => true,
+                'max_bytes'          => 256
+            ));
+            foreach (range(1, 4) as $key) {
+                foreach (range(1, 10) as $position) {
+                    $batch->add($insert, array($key, $index * 10 + $position, $value));
+                }
+            }
+            $batches[$value] = $batch;
+        }
+
+        $this->session->executeDetached($batches["detached"]);
+        $this->session->defer($batches["deferred"]);
+        $this->session->flushDeferred();
+
+        $count = 0;
+        for ($attempt = 0; $attempt < 100 && $count < 80; $attempt++) {
+            $count = count($this->session->execute(
+                "SELECT * FROM {$this->tableNamePrefix}",
+                array("page_size" => 1000)
+            ));
+            if ($count < 80) {
+                usleep(100000);
+            }
+        }
+        $this->assertEquals(80, $count);
+        $this->assertEquals(array("count" => 0, "errors" => array()), $this->session->detachedErrors());
+    }
+
+    /**
+     * Split batches can't be executed asynchronously.
+     *
+     * This test will ensure that executeAsync() rejects a batch that would
+     * be sent in several parts instead of sending it unsplit.
+     *
+     * @test
+     */
+    public function testSplitBatchAsync() {
+        $batch = new BatchStatement(\Cassandra::BATCH_UNLOGGED, array('group_by_partition' => true));
+        $batch->add("INSERT INTO {$this->tableNamePrefix} (key) VALUES (1)");
+
+        $this->expectException(\Cassandra\Exception\InvalidArgumentException::class);
+        $this->session->executeAsync($batch);
+    }
+
+    /**
+     * Only unlogged batches can be split.
+     *
+     * @test
+     */
+    public function testSplittingLoggedBatch() {
+        $this->expectException(\Cassandra\Exception\InvalidArgumentException::class);
+        new BatchStatement(\Cassandra::BATCH_LOGGED, array('group_by_partition' => true));
+    }
+}
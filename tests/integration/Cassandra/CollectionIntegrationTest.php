@@ -119,6 +119,35 @@ class CollectionIntegrationTest extends CollectionsIntegrationTest
         }, $this->nestedCassandraTypes());
     }
 
+    /**
+     * List read again after its element type changed
+     *
+     * This test ensures that the columns kept for a prepared statement's
+     * results are described again when the list's element type changes while
+     * the column keeps its name and list type.
+     *
+     * @test
+     */
+    public function testElementTypeChange() {
+        $intList = Type::collection(Type::int());
+        $textList = Type::collection(Type::text());
+        $insert = "INSERT INTO {$this->tableNamePrefix} (key, value) VALUES (?, ?)";
+
+        $this->session->execute("CREATE TABLE {$this->tableNamePrefix} (key text PRIMARY KEY, value frozen<list<int>>)");
+        $select = $this->session->prepare("SELECT value FROM {$this->tableNamePrefix} WHERE key = ?");
+        $this->session->execute($insert, array("arguments" => array("key", $intList->create(1, 2, 3))));
+        $list = $this->session->execute($select, array("arguments" => array("key")))->first()["value"];
+        $this->assertEquals($intList, $list->type());
+        $this->assertSame(array(1, 2, 3), $list->values());
+
+        $this->session->execute("DROP TABLE {$this->tableNamePrefix}");
+        $this->session->execute("CREATE TABLE {$this->tableNamePrefix} (key text PRIMARY KEY, value frozen<list<text>>)");
+        $this->session->execute($insert, array("arguments" => array("key", $textList->create("a", "b", "c"))));
+        $list = $this->session->execute($select, array("arguments" => array("key")))->first()["value"];
+        $this->assertEquals($textList, $list->type());
+        $this->assertSame(array("a", "b", "c"), $list->values());
+    }
+
     /**
      * Bind statement with an empty list
      *
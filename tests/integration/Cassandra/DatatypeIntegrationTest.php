@@ -103,4 +103,147 @@ class DatatypeIntegrationTest extends DatatypeIntegrationTests {
             $this->assertEquals($values[2], $row["value_varint"]);
         }
     }
+
+    /**
+     * Bind native PHP scalars to prepared statement parameters
+     *
+     * This test will ensure that plain PHP integers, floats and strings are
+     * converted to the declared type of a prepared statement's parameters
+     * instead of requiring the matching value objects.
+     *
+     * @test
+     */
+    public function testNativeScalarsBoundToPreparedStatement() {
+        $this->session->execute(
+            "CREATE TABLE {$this->tableNamePrefix} " .
+            "(key uuid PRIMARY KEY, value_bigint bigint, value_timestamp timestamp, " .
+            "value_smallint smallint, value_tinyint tinyint, value_float float, " .
+            "value_inet inet, value_varint varint)"
+        );
+
+        $key = "7f0a7b2e-8d4c-4f1a-9c1e-3b5d6a7e8f90";
+        $insert = $this->session->prepare(
+            "INSERT INTO {$this->tableNamePrefix} (key, value_bigint, value_timestamp, " .
+            "value_smallint, value_tinyint, value_float, value_inet, value_varint) " .
+            "VALUES (?, ?, ?, ?, ?, ?, ?, ?)"
+        );
+        $this->session->execute($insert, array("arguments" => array(
+            $key, 1 << 40, 1500000000000, 32767, -128, 1.5, "127.0.0.1",
+            "123456789012345678901234567890"
+        )));
+
+        $rows = $this->session->execute(
+            "SELECT * FROM {$this->tableNamePrefix} WHERE key=?",
+            array("arguments" => array(new Uuid($key)))
+        );
+        $this->assertCount(1, $rows);
+        $row = $rows->first();
+        $this->assertEquals(new Bigint(1 << 40), $row["value_bigint"]);
+        $this->assertEquals(new Timestamp(1500000000, 0), $row["value_timestamp"]);
+        $this->assertEquals(new Smallint(32767), $row["value_smallint"]);
+        $this->assertEquals(new Tinyint(-128), $row["value_tinyint"]);
+        $this->assertEquals(new Float(1.5), $row["value_float"]);
+        $this->assertEquals(new Inet("127.0.0.1"), $row["value_inet"]);
+        $this->assertEquals(new Varint("123456789012345678901234567890"), $row["value_varint"]);
+    }
+
+    /**
+     * Bind native PHP arrays to prepared statement parameters
+     *
+     * This test will ensure that plain PHP arrays are encoded as the list,
+     * set, map and tuple declared by a prepared statement's parameters.
+     *
+     * @test
+     */
+    public function testNativeArraysBoundToPreparedStatement() {
+        $this->session->execute(
+            "CREATE TABLE {$this->tableNamePrefix} " .
+            "(key int PRIMARY KEY, value_list list<text>, value_set set<int>, " .
+            "value_map map<text, bigint>, value_tuple frozen<tuple<text, int>>)"
+        );
+
+        $insert = $this->session->prepare(
+            "INSERT INTO {$this->tableNamePrefix} (key, value_list, value_set, value_map, value_tuple) " .
+            "VALUES (?, ?, ?, ?, ?)"
+        );
+        $this->session->execute($insert, array("arguments" => array(
+            1, array("a", "b"), array(1, 2), array("a" => 1, "2" => 2), array("a", 1)
+        )));
+
+        $rows = $this->session->execute("SELECT * FROM {$this->tableNamePrefix} WHERE key=1");
+        $this->assertCount(1, $rows);
+        $row = $rows->first();
+        $this->assertEquals(Type::collection(Type::text())->create("a", "b"), $row["value_list"]);
+        $this->assertEquals(Type::set(Type::int())->create(1, 2), $row["value_set"]);
+        $this->assertEquals(
+            Type::map(Type::text(), Type::bigint())->create("2", new Bigint(2), "a", new Bigint(1)),
+            $row["value_map"]
+        );
+        $this->assertEquals(Type::tuple(Type::text(), Type::int())->create("a", 1), $row["value_tuple"]);
+    }
+
+    /**
+     * Fetch columns as PHP scalars
+     *
+     * This test will ensure that the fetch_scalars option decodes each of the
+     * supported column types to the documented PHP scalar, that 64-bit values
+     * which don't fit a PHP integer are strings and that the other columns and
+     * elements of collections stay objects.
+     *
+     * @test
+     */
+    public function testFetchScalars() {
+        $this->session->execute(
+            "CREATE TABLE {$this->tableNamePrefix} " .
+            "(key int PRIMARY KEY, value_bigint bigint, value_bigint_max bigint, " .
+            "value_bigint_min bigint, value_timestamp timestamp, value_date date, " .
+            "value_time time, value_smallint smallint, value_tinyint tinyint, " .
+            "value_float float, value_uuid uuid, value_timeuuid timeuuid, value_inet inet, " .
+            "value_inet6 inet, value_varint varint, value_list list<bigint>)"
+        );
+        $this->session->execute(
+            "INSERT INTO {$this->tableNamePrefix} (key, value_bigint, value_bigint_max, " .
+            "value_bigint_min, value_timestamp, value_date, value_time, value_smallint, " .
+            "value_tinyint, value_float, value_uuid, value_timeuuid, value_inet, value_inet6, " .
+            "value_varint, value_list) VALUES (1, 42, 9223372036854775807, " .
+            "-9223372036854775808, 1500000000000, '2017-07-14', '02:40:00.000000001', " .
+            "-32768, 127, 1.5, 03398c99-c635-4fad-b30a-3b2c49f785c2, " .
+            "d2177dd0-eaa2-11de-a572-001b779c76e3, '127.0.0.1', '::1', 12345, [1, 2])"
+        );
+        $this->session->execute("CREATE TABLE {$this->tableNamePrefix}_counter (key int PRIMARY KEY, value counter)");
+        $this->session->execute("UPDATE {$this->tableNamePrefix}_counter SET value = value + 5 WHERE key = 1");
+
+        $options = array("fetch_scalars" => true);
+        $row = $this->session->execute("SELECT * FROM {$this->tableNamePrefix}", $options)->first();
+        $is64Bit = PHP_INT_SIZE == 8;
+
+        $this->assertSame(42, $row["value_bigint"]);
+        $this->assertSame($is64Bit ? PHP_INT_MAX : "9223372036854775807", $row["value_bigint_max"]);
+        $this->assertSame($is64Bit ? PHP_INT_MIN : "-9223372036854775808", $row["value_bigint_min"]);
+        // Milliseconds since the epoch
+        $this->assertSame($is64Bit ? 1500000000000 : "1500000000000", $row["value_timestamp"]);
+        // Seconds since the epoch
+        $this->assertSame(1499990400, $row["value_date"]);
+        // Nanoseconds since midnight
+        $this->assertSame($is64Bit ? 9600000000001 : "9600000000001", $row["value_time"]);
+        $this->assertSame(-32768, $row["value_smallint"]);
+        $this->assertSame(127, $row["value_tinyint"]);
+        $this->assertSame(1.5, $row["value_float"]);
+        $this->assertSame("03398c99-c635-4fad-b30a-3b2c49f785c2", $row["value_uuid"]);
+        $this->assertSame("d2177dd0-eaa2-11de-a572-001b779c76e3", $row["value_timeuuid"]);
+        $this->assertSame("127.0.0.1", $row["value_inet"]);
+        $this->assertSame("0:0:0:0:0:0:0:1", $row["value_inet6"]);
+        $this->assertEquals(new Varint(12345), $row["value_varint"]);
+        $this->assertEquals(Type::collection(Type::bigint())->create(new Bigint(1), new Bigint(2)), $row["value_list"]);
+        $this->assertSame(1, $row["key"]);
+
+        $row = $this->session->execute("SELECT * FROM {$this->tableNamePrefix}_counter", $options)->first();
+        $this->assertSame(5, $row["value"]);
+
+        // The same columns are objects without the option
+        $row = $this->session->execute("SELECT * FROM {$this->tableNamePrefix}")->first();
+        $this->assertEquals(new Bigint("9223372036854775807"), $row["value_bigint_max"]);
+        $this->assertEquals(new Timestamp(1500000000, 0), $row["value_timestamp"]);
+        $this->assertEquals(new Uuid("03398c99-c635-4fad-b30a-3b2c49f785c2"), $row["value_uuid"]);
+    }
 }
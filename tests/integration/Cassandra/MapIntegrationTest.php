@@ -184,4 +184,56 @@ class MapIntegrationTest extends CollectionsIntegrationTest
         $this->createTableInsertAndVerifyValueByIndex($mapType, null);
         $this->createTableInsertAndVerifyValueByName($mapType, null);
     }
+
+    /**
+     * Types of decoded maps and of the values nested in them
+     *
+     * This test ensures that the maps, lists and tuples decoded from a column
+     * share one type across rows, nested values and executions of the same
+     * prepared statement.
+     *
+     * @test
+     */
+    public function testSharedTypes() {
+        $listType = Type::collection(Type::int());
+        $mapType = Type::map(Type::varchar(), $listType);
+        $tupleType = Type::tuple(Type::int(), Type::varchar());
+
+        $this->session->execute(
+            "CREATE TABLE {$this->tableNamePrefix} " .
+            "(key int PRIMARY KEY, value map<varchar, frozen<list<int>>>, pair frozen<tuple<int, varchar>>)"
+        );
+        for ($i = 0; $i < 3; $i++) {
+            $this->session->execute(
+                "INSERT INTO {$this->tableNamePrefix} (key, value, pair) VALUES (?, ?, ?)",
+                array("arguments" => array(
+                    $i,
+                    $mapType->create("a", $listType->create($i), "b", $listType->create($i, $i)),
+                    $tupleType->create($i, "pair$i")
+                ))
+            );
+        }
+
+        $select = $this->session->prepare("SELECT value, pair FROM {$this->tableNamePrefix}");
+        $first = null;
+        foreach (array(1, 2) as $execution) {
+            $rows = $this->session->execute($select);
+            $this->assertCount(3, $rows);
+
+            foreach ($rows as $row) {
+                $this->assertEquals($mapType, $row["value"]->type());
+                $this->assertEquals($tupleType, $row["pair"]->type());
+                $this->assertEquals($listType, $row["value"]->get("a")->type());
+                $this->assertSame($row["value"]->get("a")->type(), $row["value"]->get("b")->type());
+
+                if ($first) {
+                    $this->assertSame($first["value"]->type(), $row["value"]->type());
+                    $this->assertSame($first["pair"]->type(), $row["pair"]->type());
+                    $this->assertSame($first["value"]->get("a")->type(), $row["value"]->get("a")->type());
+                } else {
+                    $first = $row;
+                }
+            }
+        }
+    }
 }
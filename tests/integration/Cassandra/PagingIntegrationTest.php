@@ -261,6 +261,100 @@ class PagingIntegrationTest extends BasicIntegrationTest {
         $this->assertNotEquals($nextValuesAsync, $lastValuesAsync);
     }
 
+    /**
+     * Page through a prepared statement's results
+     *
+     * This test ensures that every page of a prepared statement's results is
+     * decoded with the same columns, including the type of compound values.
+     *
+     * @test
+     */
+    public function testNextPageColumns() {
+        $this->session->execute("DROP TABLE {$this->tableNamePrefix}");
+        $this->session->execute(
+            "CREATE TABLE {$this->tableNamePrefix} (key int PRIMARY KEY, value int, tags frozen<set<text>>)"
+        );
+
+        $setType = Type::set(Type::text());
+        for ($i = 0; $i < 10; $i++) {
+            $this->session->execute(
+                "INSERT INTO {$this->tableNamePrefix} (key, value, tags) VALUES (?, ?, ?)",
+                array("arguments" => array($i, $i * 10, $setType->create("tag$i", "all")))
+            );
+        }
+
+        $statement = $this->session->prepare("SELECT key, value, tags FROM {$this->tableNamePrefix}");
+        $rows = $this->session->execute($statement, array("page_size" => 3));
+
+        $keys = array();
+        $type = null;
+        $pages = 0;
+        while ($rows) {
+            foreach ($rows as $row) {
+                $this->assertEquals(array("key", "value", "tags"), array_keys($row));
+                $this->assertEquals($row["key"] * 10, $row["value"]);
+                $this->assertEquals($setType->create("tag{$row["key"]}", "all"), $row["tags"]);
+                if ($type) {
+                    $this->assertSame($type, $row["tags"]->type());
+                }
+                $type = $row["tags"]->type();
+                $keys[] = $row["key"];
+            }
+            $rows = $rows->nextPage();
+            $pages++;
+        }
+
+        sort($keys);
+        $this->assertEquals(range(0, 9), $keys);
+        $this->assertGreaterThanOrEqual(4, $pages);
+    }
+
+    /**
+     * Read rows out of order
+     *
+     * This test ensures that rows read backwards or at random positions in a
+     * page are the same rows that are returned when iterating over it and that
+     * the row count is available before any row is read.
+     *
+     * @test
+     */
+    public function testRowsRandomAccess() {
+        $rows = $this->session->execute("SELECT * FROM {$this->tableNamePrefix}");
+
+        // Count and position before any row is read
+        $this->assertEquals(10, $rows->count());
+        $this->assertEquals(10, count($rows));
+        $this->assertTrue($rows->valid());
+        $this->assertEquals(0, $rows->key());
+        $this->assertTrue(isset($rows[9]));
+        $this->assertFalse(isset($rows[10]));
+
+        // Read the rows backwards
+        $backward = array();
+        for ($i = 9; $i >= 0; $i--) {
+            $backward[$i] = $rows[$i]["value"];
+        }
+        ksort($backward);
+
+        // Read the rows at random positions
+        $positions = range(0, 9);
+        shuffle($positions);
+        foreach ($positions as $i) {
+            $this->assertEquals($backward[$i], $rows->offsetGet($i)["value"]);
+        }
+
+        // Iterating over the rows returns the same rows in the same order
+        $this->assertEquals(array_values($backward), self::convertRowsToArray($rows, "value"));
+        $this->assertNull($rows[10]);
+
+        // A new result read from the last row first
+        $rows = $this->session->execute("SELECT * FROM {$this->tableNamePrefix}");
+        $last = $rows[9];
+        $this->assertEquals($backward[9], $last["value"]);
+        $this->assertEquals($backward[0], $rows->first()["value"]);
+        $this->assertEquals(array_values($backward), self::convertRowsToArray($rows, "value"));
+    }
+
     /**
      * Paging advancement does not create memory leak
      *
@@ -51,4 +51,646 @@ class SessionIntegrationTest extends BasicIntegrationTest {
         $this->ccm->start();
 
     }
+
+    /**
+     * Persistent sessions reuse prepared statements across connections
+     *
+     * This test will ensure that preparing the same query on a persistent
+     * session yields a working statement without preparing it again, and
+     * that the cached statement is replaced once the schema changes.
+     *
+     * @test_category prepared_statements:cache
+     * @expected_result Prepared statements reflect the current schema
+     */
+    public function testPersistentSessionPreparedStatementCache() {
+        $cluster = \Cassandra::cluster()
+            ->withContactPoints(Integration::IP_ADDRESS)
+            ->withPersistentSessions(true)
+            ->build();
+        $session = $cluster->connect($this->keyspaceName);
+        $session->execute(
+            "CREATE TABLE {$this->tableNamePrefix} (key int PRIMARY KEY, value int)"
+        );
+        $query = "SELECT * FROM {$this->tableNamePrefix} WHERE key = ?";
+
+        $session->execute(
+            "INSERT INTO {$this->tableNamePrefix} (key, value) VALUES (1, 1)"
+        );
+        $first = $session->prepare($query);
+        $second = $cluster->connect($this->keyspaceName)->prepareAsync($query)->get();
+        foreach (array($first, $second) as $statement) {
+            $row = $session->execute($statement, array("arguments" => array(1)))->first();
+            $this->assertEquals(array("key" => 1, "value" => 1), $row);
+        }
+
+        $session->execute("ALTER TABLE {$this->tableNamePrefix} ADD extra text");
+        $session->execute(
+            "UPDATE {$this->tableNamePrefix} SET extra = 'added' WHERE key = 1"
+        );
+        $row = $session->execute($session->prepare($query), array("arguments" => array(1)))->first();
+        $this->assertEquals("added", $row["extra"]);
+    }
+
+    /**
+     * Persistent sessions key prepared statements by the current keyspace
+     *
+     * This test will ensure that an unqualified query prepared again after
+     * switching keyspaces with a USE statement is prepared for the new
+     * keyspace instead of reusing the statement of the previous one.
+     *
+     * @test_category prepared_statements:cache
+     * @expected_result Prepared statements use the table of the current keyspace
+     */
+    public function testPersistentSessionPreparedStatementCacheFollowsKeyspace() {
+        $cluster = \Cassandra::cluster()
+            ->withContactPoints(Integration::IP_ADDRESS)
+            ->withPersistentSessions(true)
+            ->build();
+        $session = $cluster->connect($this->keyspaceName);
+        $other = substr(uniqid("other"), 0, 48);
+        $session->execute(
+            "CREATE KEYSPACE {$other} " .
+            "WITH REPLICATION = { 'class' : 'SimpleStrategy', 'replication_factor' : 1 }"
+        );
+        foreach (array($this->keyspaceName => "first", $other => "second") as $keyspace => $value) {
+            $session->execute(
+                "CREATE TABLE {$keyspace}.{$this->tableNamePrefix} (key int PRIMARY KEY, value text)"
+            );
+            $session->execute(
+                "INSERT INTO {$keyspace}.{$this->tableNamePrefix} (key, value) VALUES (1, '{$value}')"
+            );
+        }
+        $query = "SELECT value FROM {$this->tableNamePrefix} WHERE key = 1";
+
+        $this->assertEquals("first", $session->execute($session->prepare($query))->first()["value"]);
+        $session->execute("USE {$other}");
+        $this->assertEquals("second", $session->execute($session->prepare($query))->first()["value"]);
+
+        $session->execute("USE {$this->keyspaceName}");
+        $session->execute("DROP KEYSPACE {$other}");
+    }
+
+    /**
+     * Execute many statements with a bounded number in flight
+     *
+     * This test will ensure that statements given as an array or as a
+     * generator of arguments are all executed and that results, including
+     * errors, are returned in the order of the statements.
+     *
+     * @test_category queries:concurrent
+     * @expected_result Every statement has its result at its position
+     */
+    public function testExecuteConcurrent() {
+        $this->session->execute(
+            "CREATE TABLE {$this->tableNamePrefix} (key int PRIMARY KEY, value int)"
+        );
+        $insert = $this->session->prepare(
+            "INSERT INTO {$this->tableNamePrefix} (key, value) VALUES (?, ?)"
+        );
+        $arguments = function () {
+            foreach (range(0, 19) as $key) {
+                yield array($key, $key * 10);
+            }
+        };
+
+        $results = $this->session->executeConcurrent($arguments(), 4, $insert);
+        $this->assertCount(20, $results);
+        foreach ($results as $result) {
+            $this->assertInstanceOf('Cassandra\Rows', $result);
+        }
+
+        $statements = array();
+        foreach (range(19, 0) as $key) {
+            $statements[] = "SELECT value FROM {$this->tableNamePrefix} WHERE key = {$key}";
+        }
+        $statements[] = "SELECT value FROM {$this->tableNamePrefix} WHERE unknown = 1";
+
+        $results = $this->session->executeConcurrent($statements, 3);
+        $this->assertCount(21, $results);
+        foreach (range(19, 0) as $index => $key) {
+            $this->assertEquals($key * 10, $results[$index]->first()["value"]);
+        }
+        $this->assertInstanceOf('Cassandra\Exception', $results[20]);
+    }
+
+    /**
+     * Execute a prepared statement for every row of column arrays
+     *
+     * This test will ensure that every row is written and that a row whose
+     * values can't be bound is reported by its position without affecting
+     * the other rows.
+     *
+     * @test_category queries:concurrent
+     * @expected_result All valid rows are written
+     */
+    public function testExecuteColumns() {
+        $this->session->execute(
+            "CREATE TABLE {$this->tableNamePrefix} (key int PRIMARY KEY, value text, extra int)"
+        );
+        $insert = $this->session->prepare(
+            "INSERT INTO {$this->tableNamePrefix} (key, value, extra) VALUES (?, ?, ?)"
+        );
+
+        $keys = range(0, 49);
+        $values = array_map(function ($key) { return "value{$key}"; }, $keys);
+        $values[7] = new \stdClass();
+
+        $errors = $this->session->executeColumns(
+            $insert,
+            array("key" => $keys, "value" => $values),
+            8,
+            array("arguments" => array("extra" => 1))
+        );
+        $this->assertEquals(array(7), array_keys($errors));
+        $this->assertInstanceOf('Cassandra\Exception\InvalidArgumentException', $errors[7]);
+
+        $rows = $this->session->execute("SELECT key, value, extra FROM {$this->tableNamePrefix}");
+        $this->assertCount(49, $rows);
+        foreach ($rows as $row) {
+            $this->assertEquals("value{$row["key"]}", $row["value"]);
+            $this->assertEquals(1, $row["extra"]);
+        }
+    }
+
+    /**
+     * Reject shared arguments that can't be bound
+     *
+     * This test will ensure that executing column arrays with an arguments
+     * option that can't be bound throws instead of sending nothing forever.
+     *
+     * @test_category queries:bulk
+     * @expected_result An InvalidArgumentException is thrown
+     */
+    public function testExecuteColumnsUnbindableArguments() {
+        $this->session->execute(
+            "CREATE TABLE {$this->tableNamePrefix} (key int PRIMARY KEY, value text, extra int)"
+        );
+        $insert = $this->session->prepare(
+            "INSERT INTO {$this->tableNamePrefix} (key, value, extra) VALUES (?, ?, ?)"
+        );
+
+        $this->expectException(\Cassandra\Exception\InvalidArgumentException::class);
+        $this->session->executeColumns(
+            $insert,
+            array("key" => range(0, 9), "value" => array_fill(0, 10, "value")),
+            4,
+            array("arguments" => array("extra" => new \stdClass()))
+        );
+    }
+
+    /**
+     * Limit the requests in flight of column arrays
+     *
+     * This test will ensure that rows executed from column arrays count
+     * towards the requests in flight of the session, and that rows which
+     * can't get a slot are reported like rows which can't be bound.
+     *
+     * @test_category queries:bulk
+     * @expected_result Every row is either written or reported
+     */
+    public function testExecuteColumnsMaxInFlightRequests() {
+        $cluster = \Cassandra::cluster()
+            ->withContactPoints(Integration::IP_ADDRESS)
+            ->withMaxInFlightRequests(1, \Cassandra::THROTTLE_FAIL_FAST)
+            ->build();
+        $session = $cluster->connect($this->keyspaceName);
+        $session->execute(
+            "CREATE TABLE {$this->tableNamePrefix} (key int PRIMARY KEY, value text)"
+        );
+        $insert = $session->prepare(
+            "INSERT INTO {$this->tableNamePrefix} (key, value) VALUES (?, ?)"
+        );
+
+        $keys = range(0, 19);
+        $errors = $session->executeColumns(
+            $insert,
+            array("key" => $keys, "value" => array_fill(0, 20, "value")),
+            4
+        );
+        $this->assertNotEmpty($errors);
+        $this->assertArrayNotHasKey(0, $errors);
+        foreach ($errors as $error) {
+            $this->assertInstanceOf('Cassandra\Exception', $error);
+        }
+
+        $rows = $session->execute("SELECT key FROM {$this->tableNamePrefix}");
+        $this->assertCount(20 - count($errors), $rows);
+    }
+
+    /**
+     * Wait on several futures at once
+     *
+     * This test will ensure that waiting for any future returns the key of
+     * a resolved one and that waiting for all of them leaves every future
+     * resolved.
+     *
+     * @test_category queries:async
+     * @expected_result Futures resolve without waiting on each in turn
+     */
+    public function testFuturesWaitAnyAndAll() {
+        $futures = array(
+            "value" => new FutureValue(),
+            "rows" => $this->session->executeAsync("SELECT * FROM system.local"),
+            "prepared" => $this->session->prepareAsync("SELECT * FROM system.local")
+        );
+
+        $this->assertEquals("value", Futures::waitAny($futures));
+        unset($futures["value"]);
+
+        $key = Futures::waitAny($futures, 10);
+        $this->assertArrayHasKey($key, $futures);
+
+        Futures::waitAll($futures, 10);
+        $this->assertInstanceOf('Cassandra\Rows', $futures["rows"]->get(0.001));
+        $this->assertInstanceOf('Cassandra\PreparedStatement', $futures["prepared"]->get(0.001));
+    }
+
+    /**
+     * Drain futures from a completion queue
+     *
+     * This test will ensure that the completion stream becomes readable once
+     * futures resolve and that draining returns each future exactly once.
+     *
+     * @test_category queries:async
+     * @expected_result Resolved futures are drained in the order they resolve
+     */
+    public function testCompletionQueue() {
+        $queue = new CompletionQueue();
+        $value = new FutureValue();
+        $rows = $this->session->executeAsync("SELECT * FROM system.local");
+        $queue->add($value);
+        $queue->add($rows);
+        $queue->add($rows);
+        $this->assertCount(2, $queue);
+
+        $stream = $queue->stream();
+        $drained = array();
+        while (count($queue) > 0) {
+            $read = array($stream);
+            $write = $except = null;
+            $this->assertGreaterThan(0, stream_select($read, $write, $except, 10));
+            $drained = array_merge($drained, $queue->drain());
+        }
+
+        $this->assertCount(2, $drained);
+        $this->assertSame($value, $drained[0]);
+        $this->assertSame($rows, $drained[1]);
+        $this->assertInstanceOf('Cassandra\Rows', $rows->get(0.001));
+        $this->assertEquals(array(), $queue->drain());
+    }
+
+    /**
+     * Run synchronous style tasks in fibers
+     *
+     * This test will ensure that tasks waiting on results are suspended
+     * rather than blocking the others and that the return value of each task
+     * is kept under its key.
+     *
+     * @test_category queries:async
+     * @expected_result Every task returns its result
+     */
+    public function testFibersRun() {
+        if (PHP_VERSION_ID < 80100) {
+            $this->markTestSkipped("Fibers require PHP 8.1 or later");
+        }
+
+        $session = $this->session;
+        $tasks = array();
+        for ($i = 0; $i < 10; $i++) {
+            $tasks["task{$i}"] = function () use ($session, $i) {
+                $rows = $session->execute("SELECT release_version FROM system.local");
+                return array($i, $rows->count());
+            };
+        }
+
+        $results = Fibers::run($tasks);
+        $this->assertEquals(array_keys($tasks), array_keys($results));
+        for ($i = 0; $i < 10; $i++) {
+            $this->assertEquals(array($i, 1), $results["task{$i}"]);
+        }
+    }
+
+    /**
+     * Run callbacks of resolved futures
+     *
+     * This test will ensure that callbacks registered with then() run from
+     * Session::runCallbacks(), including callbacks registered by other
+     * callbacks, and that errors go to the error callback.
+     *
+     * @test_category queries:async
+     * @expected_result Every callback runs once with the result or error
+     */
+    public function testThenAndRunCallbacks() {
+        $session = $this->session;
+        $results = array();
+        $errors = array();
+
+        $session->executeAsync("SELECT * FROM system.local")->then(
+            function ($rows) use ($session, &$results) {
+                $results[] = $rows->count();
+                $session->prepareAsync("SELECT * FROM system.local")->then(
+                    function ($prepared) use (&$results) {
+                        $results[] = get_class($prepared);
+                    }
+                );
+            }
+        );
+        $session->executeAsync("SELECT * FROM invalid_table")->then(
+            function ($rows) use (&$results) {
+                $results[] = "unexpected";
+            },
+            function ($exception) use (&$errors) {
+                $errors[] = $exception;
+            }
+        );
+
+        $this->assertEquals(3, $session->runCallbacks());
+        $this->assertEquals(array(1, 'Cassandra\PreparedStatement'), $results);
+        $this->assertCount(1, $errors);
+        $this->assertInstanceOf('Cassandra\Exception', $errors[0]);
+        $this->assertEquals(0, $session->runCallbacks(false));
+    }
+
+    /**
+     * Execute queries without keeping their results
+     *
+     * This test will ensure that detached queries are applied and that the
+     * errors of failed ones are reported once by detachedErrors().
+     *
+     * @test_category queries:async
+     * @expected_result Writes land and failures are counted
+     */
+    public function testExecuteDetached() {
+        $this->session->execute(
+            "CREATE TABLE {$this->tableNamePrefix} (key int PRIMARY KEY, value text)"
+        );
+        $insert = $this->session->prepare(
+            "INSERT INTO {$this->tableNamePrefix} (key, value) VALUES (?, ?)"
+        );
+
+        for ($i = 0; $i < 20; $i++) {
+            $this->session->executeDetached($insert, array("arguments" => array($i, "value{$i}")));
+        }
+        $this->session->executeDetached("SELECT * FROM invalid_table");
+
+        $count = 0;
+        for ($attempt = 0; $attempt < 100 && $count < 20; $attempt++) {
+            usleep(100000);
+            $count = $this->session
+                ->execute("SELECT COUNT(*) AS count FROM {$this->tableNamePrefix}")
+                ->first()["count"];
+            $count = $count instanceof Bigint ? $count->toInt() : $count;
+        }
+        $this->assertEquals(20, $count);
+
+        $errors = $this->session->detachedErrors();
+        $this->assertEquals(1, $errors["count"]);
+        $this->assertInstanceOf('Cassandra\Exception', $errors["errors"][0]);
+        $this->assertEquals(array("count" => 0, "errors" => array()), $this->session->detachedErrors());
+    }
+
+    /**
+     * Buffer writes and flush them
+     *
+     * This test will ensure that deferred writes are not sent until they
+     * are flushed and that all of them are applied by the flush.
+     *
+     * @test_category queries:async
+     * @expected_result Deferred writes land once flushed
+     */
+    public function testDeferAndFlush() {
+        $this->session->execute(
+            "CREATE TABLE {$this->tableNamePrefix} (key int PRIMARY KEY, value text)"
+        );
+        $insert = $this->session->prepare(
+            "INSERT INTO {$this->tableNamePrefix} (key, value) VALUES (?, ?)"
+        );
+
+        for ($i = 0; $i < 100; $i++) {
+            $this->session->defer($insert, array("arguments" => array($i, "value{$i}")));
+        }
+        $this->assertCount(0, $this->session->execute("SELECT * FROM {$this->tableNamePrefix}"));
+
+        $this->session->flushDeferred();
+        $rows = $this->session->execute(
+            "SELECT * FROM {$this->tableNamePrefix}",
+            array("page_size" => 1000)
+        );
+        $this->assertCount(100, $rows);
+    }
+
+    /**
+     * Buffer writes to a few partitions and flush them as batches
+     *
+     * This test will ensure that deferred writes to the same partitions,
+     * given as prepared and bound statements, as simple statements and with
+     * differing options, are all applied by the flush.
+     *
+     * @test_category queries:async
+     * @expected_result Deferred writes land once flushed
+     */
+    public function testDeferGroupsWritesByPartition() {
+        $this->session->execute(
+            "CREATE TABLE {$this->tableNamePrefix} " .
+            "(key int, position int, value text, PRIMARY KEY (key, position))"
+        );
+        $insert = $this->session->prepare(
+            "INSERT INTO {$this->tableNamePrefix} (key, position, value) VALUES (?, ?, ?)"
+        );
+
+        for ($i = 0; $i < 200; $i++) {
+            $key = $i % 5;
+            switch ($i % 4) {
+                case 0:
+                    $this->session->defer($insert->bind(array($key, $i, "bound")));
+                    break;
+                case 1:
+                    $this->session->defer($insert, array(
+                        "arguments" => array("key" => $key, "position" => $i, "value" => "named"),
+                        "consistency" => \Cassandra::CONSISTENCY_ONE
+                    ));
+                    break;
+                case 2:
+                    $this->session->defer(
+                        "INSERT INTO {$this->tableNamePrefix} (key, position, value) " .
+                        "VALUES ({$key}, {$i}, 'simple')"
+                    );
+                    break;
+                default:
+                    $this->session->defer($insert, array("arguments" => array($key, $i, "positional")));
+                    break;
+            }
+        }
+        $this->assertCount(0, $this->session->execute("SELECT * FROM {$this->tableNamePrefix}"));
+
+        $this->session->flushDeferred();
+        $rows = $this->session->execute(
+            "SELECT * FROM {$this->tableNamePrefix}",
+            array("page_size" => 1000)
+        );
+        $this->assertCount(200, $rows);
+    }
+
+    /**
+     * Limit the requests in flight
+     *
+     * This test will ensure that a session limited to a few requests in flight
+     * still applies every request sent by executeAsync() and that their
+     * futures resolve as usual.
+     *
+     * @test_category queries:async
+     * @expected_result Every write lands
+     */
+    public function testMaxInFlightRequests() {
+        $cluster = \Cassandra::cluster()
+            ->withContactPoints(Integration::IP_ADDRESS)
+            ->withMaxInFlightRequests(4, \Cassandra::THROTTLE_BLOCK)
+            ->build();
+        $session = $cluster->connect($this->keyspaceName);
+        $session->execute(
+            "CREATE TABLE {$this->tableNamePrefix} (key int PRIMARY KEY, value text)"
+        );
+        $insert = $session->prepare(
+            "INSERT INTO {$this->tableNamePrefix} (key, value) VALUES (?, ?)"
+        );
+
+        $futures = array();
+        for ($i = 0; $i < 50; $i++) {
+            $futures[] = $session->executeAsync($insert, array("arguments" => array($i, "value{$i}")));
+        }
+        foreach ($futures as $future) {
+            $future->get();
+        }
+
+        $rows = $session->execute(
+            "SELECT * FROM {$this->tableNamePrefix}",
+            array("page_size" => 1000)
+        );
+        $this->assertCount(50, $rows);
+    }
+
+    /**
+     * Execute with a timeout
+     *
+     * This test will ensure that requests given up on after their timeout
+     * don't keep the session from executing the following requests.
+     *
+     * @test_category queries:basic
+     * @expected_result Requests after timed out ones succeed
+     */
+    public function testExecuteTimeout() {
+        $this->session->execute(
+            "CREATE TABLE {$this->tableNamePrefix} (key int PRIMARY KEY, value text)"
+        );
+        $this->session->execute(
+            "INSERT INTO {$this->tableNamePrefix} (key, value) VALUES (?, ?)",
+            array("arguments" => array(1, "value"), "timeout" => 10)
+        );
+
+        for ($i = 0; $i < 20; $i++) {
+            try {
+                $this->session->execute(
+                    "SELECT * FROM {$this->tableNamePrefix}",
+                    array("timeout" => 0.000001)
+                );
+                $this->fail("The request didn't time out");
+            } catch (Exception\TimeoutException $e) {
+                // Expected
+            }
+        }
+
+        $rows = $this->session->execute(
+            "SELECT * FROM {$this->tableNamePrefix}",
+            array("timeout" => 10)
+        );
+        $this->assertCount(1, $rows);
+        $this->assertEquals("value", $rows->first()["value"]);
+    }
+
+    /**
+     * Execute with the cluster's default timeout
+     *
+     * This test will ensure that the timeout given to the cluster builder is
+     * the timeout of the session's requests unless a request sets its own.
+     *
+     * @test_category queries:basic
+     * @expected_result Requests time out after the default timeout
+     */
+    public function testDefaultTimeout() {
+        $this->session->execute(
+            "CREATE TABLE {$this->tableNamePrefix} (key int PRIMARY KEY, value text)"
+        );
+        $cluster = \Cassandra::cluster()
+            ->withContactPoints(Integration::IP_ADDRESS)
+            ->withDefaultTimeout(0.000001)
+            ->build();
+        $session = $cluster->connect($this->keyspaceName);
+
+        try {
+            $session->execute("SELECT * FROM {$this->tableNamePrefix}");
+            $this->fail("The request didn't time out");
+        } catch (Exception\TimeoutException $e) {
+            // Expected
+        }
+
+        $session->execute(
+            "INSERT INTO {$this->tableNamePrefix} (key, value) VALUES (?, ?)",
+            array("arguments" => array(1, "value"), "timeout" => 10)
+        );
+        $rows = $session->execute(
+            "SELECT * FROM {$this->tableNamePrefix}",
+            array("timeout" => 10)
+        );
+        $this->assertCount(1, $rows);
+    }
+
+    /**
+     * Execute with an execution profile
+     *
+     * This test will ensure that requests naming an execution profile use
+     * its settings, that options given along with the profile override them
+     * and that unknown profiles are rejected.
+     *
+     * @test_category queries:basic
+     * @expected_result The profile's page size applies unless overridden
+     */
+    public function testExecutionProfile() {
+        $cluster = \Cassandra::cluster()
+            ->withContactPoints(Integration::IP_ADDRESS)
+            ->withExecutionProfile("small_pages", array("page_size" => 2, "timeout" => 10))
+            ->build();
+        $session = $cluster->connect($this->keyspaceName);
+        $session->execute(
+            "CREATE TABLE {$this->tableNamePrefix} (key int PRIMARY KEY, value text)"
+        );
+        for ($i = 0; $i < 10; $i++) {
+            $session->execute(
+                "INSERT INTO {$this->tableNamePrefix} (key, value) VALUES (?, ?)",
+                array("arguments" => array($i, "value{$i}"))
+            );
+        }
+
+        $rows = $session->execute(
+            "SELECT * FROM {$this->tableNamePrefix}",
+            array("execution_profile" => "small_pages")
+        );
+        $this->assertCount(2, $rows);
+        $this->assertFalse($rows->isLastPage());
+
+        $rows = $session->execute(
+            "SELECT * FROM {$this->tableNamePrefix}",
+            array("execution_profile" => "small_pages", "page_size" => 5)
+        );
+        $this->assertCount(5, $rows);
+
+        try {
+            $session->execute(
+                "SELECT * FROM {$this->tableNamePrefix}",
+                array("execution_profile" => "unknown")
+            );
+            $this->fail("An unknown execution profile was accepted");
+        } catch (Exception\InvalidArgumentException $e) {
+            $this->assertEquals("Unknown execution profile 'unknown'", $e->getMessage());
+        }
+    }
 }
@@ -286,4 +286,57 @@ class TupleIntegrationTest extends CollectionsIntegrationTest {
         // Verify the value can be read from the table
         UserTypeIntegrationTest::assertAddressValue($tuple->get(0));
     }
+
+    /**
+     * Tuples nested in collections and holding user types.
+     *
+     * This test will ensure that every value of tuples nested in a map of
+     * lists and of the user types and sets nested in them is decoded,
+     * including null values at each level.
+     *
+     * @test
+     */
+    public function testNestedValues() {
+        $this->session->execute("CREATE TYPE item (name text, tags set<text>)");
+        $this->session->execute(
+            "CREATE TABLE {$this->tableNamePrefix} " .
+            "(key int PRIMARY KEY, value map<text, frozen<list<frozen<tuple<int, text, frozen<item>>>>>>)"
+        );
+        $this->session->execute(
+            "INSERT INTO {$this->tableNamePrefix} (key, value) VALUES (1, {" .
+            "'a': [(1, 'one', {name: 'x', tags: {'t1', 't2'}}), (2, null, null)], " .
+            "'b': [(3, 'three', {name: 'y', tags: null})]})"
+        );
+
+        $map = $this->session->execute("SELECT value FROM {$this->tableNamePrefix}")->first()["value"];
+        $this->assertInstanceOf('Cassandra\Map', $map);
+        $this->assertSame(array("a", "b"), $map->keys());
+
+        $list = $map->get("a");
+        $this->assertInstanceOf('Cassandra\Collection', $list);
+        $this->assertCount(2, $list);
+
+        $tuple = $list->get(0);
+        $this->assertInstanceOf('Cassandra\Tuple', $tuple);
+        $this->assertCount(3, $tuple);
+        $this->assertSame(1, $tuple->get(0));
+        $this->assertSame("one", $tuple->get(1));
+        $item = $tuple->get(2);
+        $this->assertInstanceOf('Cassandra\UserTypeValue', $item);
+        $this->assertSame("x", $item->get("name"));
+        $this->assertInstanceOf('Cassandra\Set', $item->get("tags"));
+        $this->assertSame(array("t1", "t2"), $item->get("tags")->values());
+
+        $tuple = $list->get(1);
+        $this->assertSame(2, $tuple->get(0));
+        $this->assertNull($tuple->get(1));
+        $this->assertNull($tuple->get(2));
+
+        $list = $map->get("b");
+        $this->assertCount(1, $list);
+        $tuple = $list->get(0);
+        $this->assertSame(3, $tuple->get(0));
+        $this->assertSame("three", $tuple->get(1));
+        $this->assertSame(array("name" => "y", "tags" => null), $tuple->get(2)->values());
+    }
 }
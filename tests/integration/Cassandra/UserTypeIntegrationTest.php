@@ -448,6 +448,31 @@ class UserTypeIntegrationTest extends CollectionsIntegrationTest {
         $this->assertAddressValue($this->selectAddress($key), $address);
     }
 
+    /**
+     * User type with a field added after it was read.
+     *
+     * This test will ensure that the columns kept for a prepared statement's
+     * results are described again when a field is added to the user type it
+     * reads, so the new field is decoded instead of dropped.
+     *
+     * @test
+     */
+    public function testFieldAddedToUserType() {
+        $this->session->execute("CREATE TYPE IF NOT EXISTS point (x int, y int)");
+        $this->session->execute("CREATE TABLE {$this->tableNamePrefix}_points (key int PRIMARY KEY, value frozen<point>)");
+        $select = $this->session->prepare("SELECT value FROM {$this->tableNamePrefix}_points WHERE key = ?");
+
+        $this->session->execute("INSERT INTO {$this->tableNamePrefix}_points (key, value) VALUES (1, {x: 1, y: 2})");
+        $point = $this->session->execute($select, array("arguments" => array(1)))->first()["value"];
+        $this->assertEquals(array("x" => 1, "y" => 2), $point->values());
+
+        $this->session->execute("ALTER TYPE point ADD z int");
+        $this->session->execute("INSERT INTO {$this->tableNamePrefix}_points (key, value) VALUES (2, {x: 3, y: 4, z: 5})");
+        $point = $this->session->execute($select, array("arguments" => array(2)))->first()["value"];
+        $this->assertEquals(array("x" => 3, "y" => 4, "z" => 5), $point->values());
+        $this->assertEquals(array("x", "y", "z"), array_keys($point->type()->types()));
+    }
+
     /**
      * Frozen decoration required for user type.
      *
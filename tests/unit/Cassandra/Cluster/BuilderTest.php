@@ -0,0 +1,148 @@
+<?php
+
+/**
+ * Copyright 2015-2017 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+namespace Cassandra\Cluster;
+
+use Cassandra\ExecutionOptions;
+
+/**
+ * @requires extension cassandra
+ */
+class BuilderTest extends \PHPUnit\Framework\TestCase
+{
+    public function testAcceptsExecutionProfiles()
+    {
+        $builder = \Cassandra::cluster();
+
+        $this->assertSame($builder, $builder->withExecutionProfile('analytics', array(
+            'consistency' => \Cassandra::CONSISTENCY_ALL,
+            'page_size'   => 100,
+            'timeout'     => 30
+        )));
+        $this->assertSame($builder, $builder->withExecutionProfile('oltp', new ExecutionOptions(array(
+            'consistency' => \Cassandra::CONSISTENCY_LOCAL_QUORUM,
+            'timeout'     => 0.5
+        ))));
+        $this->assertSame($builder, $builder->withExecutionProfile('empty', array()));
+    }
+
+    public function testRejectsExecutionProfileWithoutName()
+    {
+        $this->expectException(\InvalidArgumentException::class);
+        $this->expectExceptionMessage("The name of an execution profile can't be empty");
+        \Cassandra::cluster()->withExecutionProfile('', array());
+    }
+
+    public function testRejectsInvalidExecutionProfileOptions()
+    {
+        $this->expectException(\InvalidArgumentException::class);
+        $this->expectExceptionMessage('options must be an instance of Cassandra\ExecutionOptions or an array, 1 given');
+        \Cassandra::cluster()->withExecutionProfile('analytics', 1);
+    }
+
+    public function testRejectsNestedExecutionProfile()
+    {
+        $this->expectException(\InvalidArgumentException::class);
+        $this->expectExceptionMessage("An execution profile can't refer to another one");
+        \Cassandra::cluster()->withExecutionProfile('analytics', array('execution_profile' => 'oltp'));
+    }
+
+    public function testRejectsExecutionProfileWithArguments()
+    {
+        $this->expectException(\InvalidArgumentException::class);
+        $this->expectExceptionMessage("An execution profile can't set arguments");
+        \Cassandra::cluster()->withExecutionProfile('analytics', array('arguments' => array(1)));
+    }
+
+    public function testRejectsExecutionProfileWithPagingStateToken()
+    {
+        $this->expectException(\InvalidArgumentException::class);
+        $this->expectExceptionMessage("An execution profile can't set paging_state_token");
+        \Cassandra::cluster()->withExecutionProfile('analytics', new ExecutionOptions(array(
+            'paging_state_token' => 'token'
+        )));
+    }
+
+    public function testLatencyAwareRoutingSettingsDefaults()
+    {
+        $builder = \Cassandra::cluster()->withLatencyAwareRoutingSettings(array());
+        $properties = (array) $builder;
+
+        $this->assertTrue($properties['latencyAwareRouting']);
+        $this->assertEquals(array(
+            'exclusion_threshold' => 2.0,
+            'scale'               => 0.1,
+            'retry_period'        => 10.0,
+            'update_rate'         => 0.1,
+            'min_measured'        => 50
+        ), $properties['latencyAwareRoutingSettings']);
+    }
+
+    public function testLatencyAwareRoutingSettingsInSeconds()
+    {
+        $builder = \Cassandra::cluster()->withLatencyAwareRoutingSettings(array(
+            'exclusion_threshold' => 3,
+            'scale'               => 0.25,
+            'retry_period'        => 5,
+            'update_rate'         => 0.0015,
+            'min_measured'        => 0
+        ));
+        $properties = (array) $builder;
+
+        // Fractions of milliseconds are rounded up
+        $this->assertEquals(array(
+            'exclusion_threshold' => 3.0,
+            'scale'               => 0.25,
+            'retry_period'        => 5.0,
+            'update_rate'         => 0.002,
+            'min_measured'        => 0
+        ), $properties['latencyAwareRoutingSettings']);
+
+        $builder->withLatencyAwareRoutingSettings(array('exclusion_threshold' => 1.5, 'scale' => 0));
+        $properties = (array) $builder;
+        $this->assertEquals(1.5, $properties['latencyAwareRoutingSettings']['exclusion_threshold']);
+        $this->assertEquals(0.0, $properties['latencyAwareRoutingSettings']['scale']);
+        $this->assertEquals(10.0, $properties['latencyAwareRoutingSettings']['retry_period']);
+    }
+
+    /**
+     * @dataProvider invalidLatencyAwareRoutingSettings
+     */
+    public function testRejectsInvalidLatencyAwareRoutingSettings($settings, $message)
+    {
+        $this->expectException(\InvalidArgumentException::class);
+        $this->expectExceptionMessage($message);
+        \Cassandra::cluster()->withLatencyAwareRoutingSettings($settings);
+    }
+
+    public function invalidLatencyAwareRoutingSettings()
+    {
+        return array(
+            array(array('threshold' => 2), 'Unknown latency-aware routing setting: threshold'),
+            array(array(2), 'Unknown latency-aware routing setting: (index)'),
+            array(array('exclusion_threshold' => 0), 'exclusion_threshold must be a number greater than or equal to 1, 0 given'),
+            array(array('exclusion_threshold' => 0.5), 'exclusion_threshold must be a number greater than or equal to 1'),
+            array(array('exclusion_threshold' => '2'), "exclusion_threshold must be a number greater than or equal to 1, '2' given"),
+            array(array('scale' => -1), 'scale must be a number of seconds greater than or equal to zero'),
+            array(array('retry_period' => -0.5), 'retry_period must be a number of seconds greater than or equal to zero'),
+            array(array('update_rate' => 'fast'), 'update_rate must be a number of seconds greater than or equal to zero'),
+            array(array('min_measured' => -1), 'min_measured must be an integer greater than or equal to zero, -1 given'),
+            array(array('min_measured' => 1.5), 'min_measured must be an integer greater than or equal to zero')
+        );
+    }
+}
@@ -40,7 +40,10 @@ class ExecutionOptionsTest extends \PHPUnit\Framework\TestCase
             'serial_consistency' => \Cassandra::CONSISTENCY_LOCAL_SERIAL,
             'page_size'          => 15000,
             'timeout'            => 15,
-            'arguments'          => array('a', 1, 'b', 2, 'c', 3)
+            'arguments'          => array('a', 1, 'b', 2, 'c', 3),
+            'is_idempotent'      => true,
+            'fetch_scalars'      => true,
+            'execution_profile'  => 'analytics'
         ));
 
         $this->assertEquals(\Cassandra::CONSISTENCY_ANY, $options->consistency);
@@ -48,6 +51,9 @@ class ExecutionOptionsTest extends \PHPUnit\Framework\TestCase
         $this->assertEquals(15000, $options->pageSize);
         $this->assertEquals(15, $options->timeout);
         $this->assertEquals(array('a', 1, 'b', 2, 'c', 3), $options->arguments);
+        $this->assertTrue($options->isIdempotent);
+        $this->assertTrue($options->fetchScalars);
+        $this->assertEquals('analytics', $options->executionProfile);
     }
 
     public function testReturnsNullValuesWhenRetrievingUndefinedSettingsByName()
@@ -59,5 +65,29 @@ class ExecutionOptionsTest extends \PHPUnit\Framework\TestCase
         $this->assertNull($options->pageSize);
         $this->assertNull($options->timeout);
         $this->assertNull($options->arguments);
+        $this->assertNull($options->isIdempotent);
+        $this->assertNull($options->fetchScalars);
+        $this->assertNull($options->executionProfile);
+    }
+
+    public function testRejectsNonBooleanIdempotence()
+    {
+        $this->expectException(\InvalidArgumentException::class);
+        $this->expectExceptionMessage('is_idempotent must be a boolean, 1 given');
+        new ExecutionOptions(array('is_idempotent' => 1));
+    }
+
+    public function testRejectsNonBooleanFetchScalars()
+    {
+        $this->expectException(\InvalidArgumentException::class);
+        $this->expectExceptionMessage('fetch_scalars must be a boolean, 1 given');
+        new ExecutionOptions(array('fetch_scalars' => 1));
+    }
+
+    public function testRejectsNonStringExecutionProfile()
+    {
+        $this->expectException(\InvalidArgumentException::class);
+        $this->expectExceptionMessage('execution_profile must be a string, 1 given');
+        new ExecutionOptions(array('execution_profile' => 1));
     }
 }